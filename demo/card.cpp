@@ -1,4 +1,5 @@
 #include "card.h"
+#include <iterator>
 #include <stdexcept>
 
 Card::Card(CardColor c, CardValue v) : color(c), value(v) {}
@@ -114,4 +115,29 @@ bool Card::isFlashCard() const {
 
 bool Card::operator==(const Card& other) const {
     return color == other.color && value == other.value;
+}
+namespace {
+using UNO::Common::CodeFace;
+
+// CardValue orders PACKAGE before the wild cards, the code orders it after them
+constexpr CodeFace VALUE_TO_FACE[] = {
+    CodeFace::NUMBER_0, CodeFace::NUMBER_1, CodeFace::NUMBER_2, CodeFace::NUMBER_3, CodeFace::NUMBER_4,
+    CodeFace::NUMBER_5, CodeFace::NUMBER_6, CodeFace::NUMBER_7, CodeFace::NUMBER_8, CodeFace::NUMBER_9,
+    CodeFace::SKIP, CodeFace::REVERSE, CodeFace::DRAW_TWO, CodeFace::PACKAGE,
+    CodeFace::WILD, CodeFace::DRAW_FOUR, CodeFace::FLASH
+};
+}
+
+UNO::Common::CardCode Card::toCode() const {
+    return UNO::Common::CardCode(static_cast<UNO::Common::CodeColor>(color),
+                                 VALUE_TO_FACE[static_cast<int>(value)]);
+}
+
+Card Card::fromCode(UNO::Common::CardCode code) {
+    for (int v = 0; v < static_cast<int>(std::size(VALUE_TO_FACE)); v++) {
+        if (VALUE_TO_FACE[v] == code.GetFace()) {
+            return Card(static_cast<CardColor>(code.GetColor()), static_cast<CardValue>(v));
+        }
+    }
+    throw std::invalid_argument("card code has no face in the demo");
 }
\ No newline at end of file
@@ -3,6 +3,8 @@
 
 #include <string>
 
+#include "../scr/CoreFunction/common/card_code.h"
+
 enum class CardColor { RED, YELLOW, GREEN, BLUE, WILD };
 enum class CardValue { 
     ZERO, ONE, TWO, THREE, FOUR, FIVE, SIX, SEVEN, EIGHT, NINE,
@@ -25,6 +27,10 @@ struct Card {
     bool isPackageCard() const;
     bool isFlashCard() const;
     bool operator==(const Card& other) const;
+
+    // conversions to and from the one-byte code shared with the server
+    UNO::Common::CardCode toCode() const;
+    static Card fromCode(UNO::Common::CardCode code);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,71 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace UNO {
+
+/**
+ * 二进制存档的读写辅助，所有整数按小端序读写，不依赖本机字节序和对齐
+ */
+class BinaryWriter {
+public:
+    explicit BinaryWriter(std::vector<uint8_t>& out) : out(out) {}
+
+    template <typename T>
+    void write(T value) {
+        static_assert(std::is_integral_v<T> && !std::is_same_v<T, bool>, "write bools as uint8_t");
+        auto bits = static_cast<std::make_unsigned_t<T>>(value);
+        for (size_t i = 0; i < sizeof(T); i++) {
+            out.push_back(static_cast<uint8_t>(bits >> (8 * i)));
+        }
+    }
+
+    void writeBytes(std::span<const uint8_t> bytes) { out.insert(out.end(), bytes.begin(), bytes.end()); }
+
+private:
+    std::vector<uint8_t>& out;
+};
+
+class BinaryReader {
+public:
+    explicit BinaryReader(std::span<const uint8_t> in) : in(in) {}
+
+    /**
+     * @return 剩余字节不够时返回 false，value 不变
+     */
+    template <typename T>
+    bool read(T& value) {
+        if (in.size() - offset < sizeof(T)) {
+            return false;
+        }
+        std::make_unsigned_t<T> bits = 0;
+        for (size_t i = 0; i < sizeof(T); i++) {
+            bits |= static_cast<std::make_unsigned_t<T>>(in[offset++]) << (8 * i);
+        }
+        value = static_cast<T>(bits);
+        return true;
+    }
+
+    /**
+     * 读取 count 个字节，返回的视图指向原数据
+     * @return 剩余字节不够时返回 false
+     */
+    bool readBytes(size_t count, std::span<const uint8_t>& bytes) {
+        if (in.size() - offset < count) {
+            return false;
+        }
+        bytes = in.subspan(offset, count);
+        offset += count;
+        return true;
+    }
+
+    size_t getOffset() const { return offset; }
+
+private:
+    std::span<const uint8_t> in;
+    size_t offset = 0;
+};
+
+} // namespace UNO
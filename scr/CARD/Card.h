@@ -3,6 +3,8 @@
 #include <nlohmann/json.hpp>
 #include <memory>
 
+#include "../CoreFunction/common/card_code.h"
+
 namespace UNO {
 
 // 卡牌颜色枚举
@@ -66,6 +68,24 @@ struct CardData {
         return card;
     }
 
+    // 转换为单字节编码（牌堆、手牌和网络消息都使用编码）
+    Common::CardCode toCode() const {
+        // 功能牌的编码依次排在十个数字之后，和 CardType 的顺序一致
+        int face = type == CardType::NUMBER ? number : 9 + static_cast<int>(type);
+        return Common::CardCode(static_cast<Common::CodeColor>(color), static_cast<Common::CodeFace>(face));
+    }
+
+    // 从单字节编码还原，名称取自编码的常量表（不含颜色，和各卡牌类一致）
+    static CardData fromCode(Common::CardCode code, int cardId = -1) {
+        int face = static_cast<int>(code.GetFace());
+        CardType cardType = CardType::NUMBER;
+        if (code.GetFace() >= Common::CodeFace::SKIP && code.GetFace() <= Common::CodeFace::FLASH) {
+            cardType = static_cast<CardType>(face - 9);
+        }
+        return CardData(cardId, static_cast<CardColor>(code.GetColor()), cardType,
+                        code.GetNumber(), std::string(code.GetFaceName()));
+    }
+
     // 转换为字符串表示（用于调试和显示）
     std::string toString() const {
         std::string colorStr;
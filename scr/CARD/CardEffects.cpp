@@ -0,0 +1,165 @@
+#include "CardEffects.h"
+#include "GameState.h"
+#include <stdexcept>
+
+namespace UNO {
+
+namespace {
+
+bool isChosenColor(CardColor color) {
+    return color != CardColor::WILD && static_cast<int>(color) >= 0 && static_cast<int>(color) <= 3;
+}
+
+void numberEffect(GameState&, int, const EffectParams&) {
+    // 数字卡没有效果
+}
+
+void skipEffect(GameState& gameState, int playerId, const EffectParams&) {
+    int nextPlayer = gameState.getNextPlayerId();
+    gameState.skipPlayerTurn(nextPlayer);
+    
+    // 发送事件通知
+    gameState.publishCardEvent({CardEventKind::SKIP, static_cast<int8_t>(playerId), static_cast<int8_t>(nextPlayer)});
+}
+
+void reverseEffect(GameState& gameState, int playerId, const EffectParams&) {
+    gameState.reversePlayDirection();
+    
+    // 发送事件通知
+    gameState.publishCardEvent({CardEventKind::REVERSE, static_cast<int8_t>(playerId)});
+}
+
+void drawTwoEffect(GameState& gameState, int playerId, const EffectParams&) {
+    int nextPlayer = gameState.getNextPlayerId();
+    gameState.makePlayerDrawCards(nextPlayer, 2);
+    gameState.skipPlayerTurn(nextPlayer);
+    
+    // 发送事件通知
+    gameState.publishCardEvent({CardEventKind::DRAW_TWO, static_cast<int8_t>(playerId),
+        static_cast<int8_t>(nextPlayer), CardColor::WILD, 2});
+}
+
+void wildEffect(GameState& gameState, int playerId, const EffectParams& params) {
+    gameState.setCurrentColor(params.color);
+    
+    // 发送事件通知
+    gameState.publishCardEvent({CardEventKind::WILD, static_cast<int8_t>(playerId), -1, params.color});
+}
+
+void wildDrawFourEffect(GameState& gameState, int playerId, const EffectParams& params) {
+    // 只有玩家手中没有匹配当前颜色的牌时才能出 Wild Draw Four
+    if (!gameState.validateWildDrawFour(playerId)) {
+        throw std::runtime_error("Cannot play Wild Draw Four: player has matching color cards");
+    }
+    
+    // 改变颜色
+    gameState.setCurrentColor(params.color);
+    
+    // 让下个玩家抽4张牌并跳过回合
+    int nextPlayer = gameState.getNextPlayerId();
+    gameState.makePlayerDrawCards(nextPlayer, 4);
+    gameState.skipPlayerTurn(nextPlayer);
+    
+    // 发送事件通知
+    gameState.publishCardEvent({CardEventKind::WILD_DRAW_FOUR, static_cast<int8_t>(playerId),
+        static_cast<int8_t>(nextPlayer), params.color, 4});
+}
+
+void packageEffect(GameState& gameState, int playerId, const EffectParams& params) {
+    // 只丢弃指定颜色的数字卡（排除功能卡）
+    int discardedCount = gameState.discardPlayerCards(playerId, params.color, CardType::NUMBER);
+    
+    // 发送事件通知
+    gameState.publishCardEvent({CardEventKind::PACKAGE, static_cast<int8_t>(playerId), -1,
+        params.color, static_cast<int16_t>(discardedCount)});
+}
+
+bool canPlayerRespondToFlash(const GameState& gameState, int playerId, CardColor flashColor) {
+    // 指定颜色的牌和万能牌都可以响应
+    return gameState.hasCardOfColorOrWild(playerId, flashColor);
+}
+
+void flashEffect(GameState& gameState, int playerId, const EffectParams& params) {
+    // 设置闪光效果状态
+    gameState.setFlashEffect(params.color, playerId);
+    
+    // 从下个玩家开始，最多遍历所有玩家一轮
+    int currentPlayer = gameState.getNextPlayerId();
+    int cardsPlayed = 0;
+    int playersSkipped = 0;
+    int consecutiveFails = 0;
+    for (int i = 0; i < gameState.getPlayerCount(); i++) {
+        if (canPlayerRespondToFlash(gameState, currentPlayer, params.color)) {
+            // 玩家可以响应，重置连续失败计数
+            // 在实际实现中，这里会等待玩家出牌或AI自动出牌
+            consecutiveFails = 0;
+            cardsPlayed++;
+        } else {
+            // 玩家无法响应，抽牌数量等于已出的该颜色牌数量
+            consecutiveFails++;
+            playersSkipped++;
+            if (cardsPlayed > 0) {
+                gameState.makePlayerDrawCards(currentPlayer, cardsPlayed);
+            }
+            
+            // 如果连续所有玩家都无法响应，结束闪光效果
+            if (consecutiveFails >= gameState.getPlayerCount() - 1) {
+                break;
+            }
+        }
+        int playerCount = gameState.getPlayerCount();
+        currentPlayer = (currentPlayer + (gameState.isClockwise() ? 1 : playerCount - 1)) % playerCount;
+    }
+    
+    // 清除闪光效果状态
+    gameState.clearFlashEffect();
+    
+    // 发送事件通知
+    gameState.publishCardEvent({CardEventKind::FLASH, static_cast<int8_t>(playerId), -1,
+        params.color, static_cast<int16_t>(cardsPlayed), static_cast<int16_t>(playersSkipped)});
+}
+}
+
+// 顺序与 CardType 一致
+const std::array<CardEffects::Entry, 8> CardEffects::entries = {{
+    {&numberEffect, false},        // NUMBER
+    {&skipEffect, false},          // SKIP
+    {&reverseEffect, false},       // REVERSE
+    {&drawTwoEffect, false},       // DRAW_TWO
+    {&wildEffect, true},           // WILD
+    {&wildDrawFourEffect, true},   // WILD_DRAW_FOUR
+    {&packageEffect, true},        // PACKAGE
+    {&flashEffect, true},          // FLASH
+}};
+
+bool CardEffects::decode(CardType type, const nlohmann::json& json, EffectParams& params) {
+    params = EffectParams{};
+    if (json.is_object()) {
+        // 字段可以省略，但给出时必须是整数，否则 get<int>() 会抛 type_error
+        for (const char* key : {"color", "targetPlayer", "cardType"}) {
+            if (json.contains(key) && !json[key].is_number_integer()) {
+                return false;
+            }
+        }
+        if (json.contains("color")) {
+            params.color = static_cast<CardColor>(json["color"].get<int>());
+        }
+        if (json.contains("targetPlayer")) {
+            params.targetPlayer = json["targetPlayer"].get<int>();
+        }
+        if (json.contains("cardType")) {
+            params.cardType = static_cast<CardType>(json["cardType"].get<int>());
+        }
+    }
+    return validate(type, params);
+}
+
+bool CardEffects::validate(CardType type, const EffectParams& params) {
+    if (static_cast<size_t>(type) >= entries.size()) {
+        return false;
+    }
+    // 0-3 对应四种颜色
+    return !requiresColor(type) || isChosenColor(params.color);
+}
+
+} // namespace UNO
@@ -0,0 +1,62 @@
+#pragma once
+#include <array>
+#include <nlohmann/json.hpp>
+#include "Card.h"
+
+namespace UNO {
+
+/**
+ * 卡牌效果的参数
+ * 出牌时解码并校验一次，之后的效果执行只读这个结构，不再解析 JSON
+ */
+struct EffectParams {
+    CardColor color = CardColor::WILD;   // 选择的颜色（Wild、Wild Draw Four、Package、Flash）
+    int targetPlayer = -1;               // 目标玩家，-1 表示不需要
+    CardType cardType = CardType::NUMBER; // 指定的卡牌类型
+};
+
+/**
+ * 卡牌效果分派表
+ * 每种 CardType 对应一个效果函数，出牌时按类型直接查表调用，
+ * 没有虚函数调用、JSON 解析和堆分配
+ */
+class CardEffects {
+public:
+    using EffectFn = void (*)(GameState& gameState, int playerId, const EffectParams& params);
+
+    /**
+     * 执行 type 类型卡牌的效果，params 必须已经通过 decode 校验
+     */
+    static void apply(CardType type, GameState& gameState, int playerId, const EffectParams& params) {
+        entries[static_cast<size_t>(type)].effect(gameState, playerId, params);
+    }
+
+    /**
+     * 这种卡牌是否需要选择颜色
+     */
+    static bool requiresColor(CardType type) {
+        return entries[static_cast<size_t>(type)].requiresColor;
+    }
+
+    /**
+     * 把 JSON 参数解码为 EffectParams 并校验
+     * @return 缺少参数或参数无效时返回 false
+     */
+    static bool decode(CardType type, const nlohmann::json& json, EffectParams& params);
+
+    /**
+     * 校验已经是结构体形式的参数，例如从网络消息或 AI 直接得到的参数
+     */
+    static bool validate(CardType type, const EffectParams& params);
+
+private:
+    struct Entry {
+        EffectFn effect;
+        bool requiresColor;
+    };
+
+    // 按 CardType 索引，在 CardEffects.cpp 中常量初始化
+    static const std::array<Entry, 8> entries;
+};
+
+} // namespace UNO
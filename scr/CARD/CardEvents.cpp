@@ -0,0 +1,71 @@
+#include "CardEvents.h"
+
+namespace UNO {
+
+const char* getCardEventName(CardEventKind kind) {
+    switch (kind) {
+        case CardEventKind::SKIP: return "skip";
+        case CardEventKind::REVERSE: return "reverse";
+        case CardEventKind::DRAW_TWO: return "draw_two";
+        case CardEventKind::WILD: return "wild";
+        case CardEventKind::WILD_DRAW_FOUR: return "wild_draw_four";
+        case CardEventKind::PACKAGE: return "package";
+        case CardEventKind::FLASH: return "flash";
+    }
+    return "unknown";
+}
+
+nlohmann::json cardEventToJson(const CardEvent& event) {
+    nlohmann::json json = {
+        {"effect", getCardEventName(event.kind)},
+        {"sourcePlayer", event.sourcePlayer}
+    };
+    switch (event.kind) {
+        case CardEventKind::SKIP:
+            json["targetPlayer"] = event.targetPlayer;
+            break;
+        case CardEventKind::DRAW_TWO:
+        case CardEventKind::WILD_DRAW_FOUR:
+            json["targetPlayer"] = event.targetPlayer;
+            json["drawCount"] = event.count;
+            if (event.kind == CardEventKind::WILD_DRAW_FOUR) {
+                json["newColor"] = static_cast<int>(event.color);
+            }
+            break;
+        case CardEventKind::WILD:
+            json["newColor"] = static_cast<int>(event.color);
+            break;
+        case CardEventKind::PACKAGE:
+            json["targetColor"] = static_cast<int>(event.color);
+            json["discardedCount"] = event.count;
+            break;
+        case CardEventKind::FLASH:
+            json["flashColor"] = static_cast<int>(event.color);
+            json["cardsPlayed"] = event.count;
+            json["playersSkipped"] = event.skipped;
+            break;
+        case CardEventKind::REVERSE:
+            break;
+    }
+    return json;
+}
+
+bool CardEventBus::subscribe(Handler handler, void* context) {
+    if (subscriberCount == MAX_SUBSCRIBERS) {
+        return false;
+    }
+    subscribers[subscriberCount++] = {handler, context};
+    return true;
+}
+
+void CardEventBus::flush() {
+    // 订阅者可能在处理时发布新的事件，它们排在后面，同样在这次分发
+    while (head != tail) {
+        const CardEvent event = ring[head++ & (CAPACITY - 1)];
+        for (size_t i = 0; i < subscriberCount; i++) {
+            subscribers[i].handler(subscribers[i].context, event);
+        }
+    }
+}
+
+} // namespace UNO
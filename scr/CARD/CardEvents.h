@@ -0,0 +1,104 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <nlohmann/json.hpp>
+#include "Card.h"
+
+namespace UNO {
+
+enum class CardEventKind : uint8_t {
+    SKIP,
+    REVERSE,
+    DRAW_TWO,
+    WILD,
+    WILD_DRAW_FOUR,
+    PACKAGE,
+    FLASH
+};
+
+/**
+ * 卡牌效果事件，定长的纯数据结构，发布时不分配内存
+ * 各字段的含义随事件种类而定，不用的字段保持默认值
+ */
+struct CardEvent {
+    CardEventKind kind;
+    int8_t sourcePlayer = -1;   // 出牌的玩家
+    int8_t targetPlayer = -1;   // 受影响的玩家（Skip、Draw Two、Wild Draw Four）
+    CardColor color = CardColor::WILD;  // 新颜色、Package 的目标颜色或 Flash 的颜色
+    int16_t count = 0;          // 抽牌数、Package 丢弃的张数或 Flash 中出的张数
+    int16_t skipped = 0;        // Flash 中被跳过的玩家数
+};
+static_assert(std::is_trivially_copyable_v<CardEvent>, "card events must be plain data");
+
+/**
+ * 事件种类的名称，如 "skip"、"wild_draw_four"
+ */
+const char* getCardEventName(CardEventKind kind);
+
+/**
+ * 转换为 JSON，只供调试日志和网络适配器使用
+ */
+nlohmann::json cardEventToJson(const CardEvent& event);
+
+/**
+ * 每张牌桌一个的卡牌事件总线
+ * 订阅者（界面、日志、统计、网络适配器）在牌局开始前注册，之后订阅表不再变化；
+ * 事件先写入定长环形缓冲，flush 时按发布顺序交给所有订阅者。
+ * 订阅者是函数指针加上下文指针，发布和分发都不分配内存。
+ */
+class CardEventBus {
+public:
+    using Handler = void (*)(void* context, const CardEvent& event);
+
+    constexpr static size_t CAPACITY = 64;  // 必须是 2 的幂
+    constexpr static size_t MAX_SUBSCRIBERS = 8;
+
+    /**
+     * 注册订阅者
+     * @return 订阅者已满时返回 false
+     */
+    bool subscribe(Handler handler, void* context = nullptr);
+
+    /**
+     * 以成员函数订阅，例如 bus.subscribe<&Logger::onCardEvent>(&logger)
+     */
+    template <auto Method, typename T>
+    bool subscribe(T* object) {
+        return subscribe([](void* context, const CardEvent& event) {
+            (static_cast<T*>(context)->*Method)(event);
+        }, object);
+    }
+
+    /**
+     * 缓冲一个事件，缓冲已满时先分发已有的事件
+     */
+    void publish(const CardEvent& event) {
+        if (tail - head == CAPACITY) {
+            flush();
+        }
+        ring[tail++ & (CAPACITY - 1)] = event;
+    }
+
+    /**
+     * 把缓冲的事件按顺序交给所有订阅者
+     */
+    void flush();
+
+    size_t getPendingCount() const { return tail - head; }
+
+private:
+    struct Subscriber {
+        Handler handler;
+        void* context;
+    };
+
+    std::array<CardEvent, CAPACITY> ring{};
+    size_t head = 0;
+    size_t tail = 0;
+    std::array<Subscriber, MAX_SUBSCRIBERS> subscribers{};
+    size_t subscriberCount = 0;
+};
+
+} // namespace UNO
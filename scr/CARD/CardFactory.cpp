@@ -0,0 +1,54 @@
+#include "CardFactory.h"
+#include "CardPrototypes.h"
+
+namespace UNO {
+
+std::array<CardFactory::Creator, 8>& CardFactory::creators() {
+    static std::array<Creator, 8> table = [] {
+        std::array<Creator, 8> defaults;
+        defaults.fill(&CardPrototypes::share);
+        return defaults;
+    }();
+    return table;
+}
+
+void CardFactory::registerType(CardType type, Creator creator) {
+    creators()[static_cast<size_t>(type)] = creator;
+}
+
+std::shared_ptr<Card> CardFactory::create(Common::CardCode code) {
+    if (!code.IsValid() || code.GetFace() == Common::CodeFace::EMPTY) {
+        return nullptr;
+    }
+    // 编码的牌面在十个数字之后依次对应 CardType
+    int face = static_cast<int>(code.GetFace());
+    size_t type = code.GetNumber() >= 0 ? 0 : face - 9;
+    return creators()[type](code);
+}
+
+std::shared_ptr<Card> CardFactory::createFromJson(const nlohmann::json& json) {
+    return create(CardData::fromJson(json).toCode());
+}
+
+void CardFactory::encodeCards(std::span<const std::shared_ptr<Card>> cards, std::vector<uint8_t>& out) {
+    out.reserve(out.size() + cards.size());
+    for (const auto& card : cards) {
+        out.push_back(card->getCardData().toCode().ToByte());
+    }
+}
+
+bool CardFactory::decodeCards(std::span<const uint8_t> codes, std::vector<std::shared_ptr<Card>>& cards) {
+    size_t oldSize = cards.size();
+    cards.reserve(oldSize + codes.size());
+    for (uint8_t byte : codes) {
+        auto card = create(Common::CardCode::FromByte(byte));
+        if (!card) {
+            cards.resize(oldSize);
+            return false;
+        }
+        cards.push_back(std::move(card));
+    }
+    return true;
+}
+
+} // namespace UNO
@@ -0,0 +1,51 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "Card.h"
+
+namespace UNO {
+
+/**
+ * 卡牌工厂
+ * 按卡牌类型登记创建函数，从单字节编码重建卡牌对象。默认每种类型都返回共用的
+ * 卡牌原型，自定义卡牌可以登记自己的创建函数。
+ * 存档有两种格式：二进制格式每张牌一个字节，用于快照和恢复牌局；JSON 格式
+ * 每张牌一个对象，只用于调试和导出。两者都经过这个工厂重建卡牌。
+ */
+class CardFactory {
+public:
+    using Creator = std::shared_ptr<Card> (*)(Common::CardCode code);
+
+    /**
+     * 登记某种卡牌类型的创建函数，替换之前登记的
+     */
+    static void registerType(CardType type, Creator creator);
+
+    /**
+     * 从编码创建卡牌
+     * @return 无效编码返回 nullptr
+     */
+    static std::shared_ptr<Card> create(Common::CardCode code);
+
+    /**
+     * 从 CardData::toJson 的输出创建卡牌
+     */
+    static std::shared_ptr<Card> createFromJson(const nlohmann::json& json);
+
+    // 二进制格式：按顺序每张牌写一个编码字节，追加到 out 末尾
+    static void encodeCards(std::span<const std::shared_ptr<Card>> cards, std::vector<uint8_t>& out);
+    /**
+     * 把编码字节还原成卡牌追加到 cards 末尾
+     * @return 有无效编码时返回 false，此时 cards 不变
+     */
+    static bool decodeCards(std::span<const uint8_t> codes, std::vector<std::shared_ptr<Card>>& cards);
+
+private:
+    static std::array<Creator, 8>& creators();
+};
+
+} // namespace UNO
@@ -0,0 +1,72 @@
+#include "CardPrototypes.h"
+#include "FunctionCard.h"
+#include <array>
+
+namespace UNO {
+
+namespace {
+
+/**
+ * 数字卡没有效果
+ */
+class NumberCard : public Card {
+public:
+    explicit NumberCard(const CardData& data) : Card(data) {}
+    void applyEffect(GameState&, int, const nlohmann::json&) override {}
+};
+
+std::unique_ptr<Card> createPrototype(Common::CardCode code) {
+    CardData data = CardData::fromCode(code, code.ToByte());
+    switch (data.type) {
+        case CardType::NUMBER:
+            data.name = std::to_string(data.number);
+            return std::make_unique<NumberCard>(data);
+        case CardType::SKIP:
+            return std::make_unique<SkipCard>(data.id, data.color);
+        case CardType::REVERSE:
+            return std::make_unique<ReverseCard>(data.id, data.color);
+        case CardType::DRAW_TWO:
+            return std::make_unique<DrawTwoCard>(data.id, data.color);
+        case CardType::WILD:
+            return std::make_unique<WildCard>(data.id);
+        case CardType::WILD_DRAW_FOUR:
+            return std::make_unique<WildDrawFourCard>(data.id);
+        case CardType::PACKAGE:
+            return std::make_unique<PackageCard>(data.id, data.color);
+        case CardType::FLASH:
+            return std::make_unique<FlashCard>(data.id);
+    }
+    return nullptr;
+}
+
+/**
+ * 所有原型按编码索引，整个进程只构造一次（局部静态变量的初始化是线程安全的）
+ */
+const std::array<std::unique_ptr<Card>, 256>& prototypes() {
+    static const std::array<std::unique_ptr<Card>, 256> table = [] {
+        std::array<std::unique_ptr<Card>, 256> cards;
+        for (int byte = 0; byte < 256; byte++) {
+            auto code = Common::CardCode::FromByte(byte);
+            if (code.IsValid() && code.GetFace() != Common::CodeFace::EMPTY) {
+                cards[byte] = createPrototype(code);
+            }
+        }
+        return cards;
+    }();
+    return table;
+}
+}
+
+const Card* CardPrototypes::get(Common::CardCode code) {
+    if (code.IsWild()) {
+        code = code.WithColor(Common::CodeColor::WILD);
+    }
+    return prototypes()[code.ToByte()].get();
+}
+
+std::shared_ptr<Card> CardPrototypes::share(Common::CardCode code) {
+    // 别名构造：空的所有者加上原型的地址，没有控制块
+    return std::shared_ptr<Card>(std::shared_ptr<Card>(), const_cast<Card*>(get(code)));
+}
+
+} // namespace UNO
@@ -0,0 +1,28 @@
+#pragma once
+#include <memory>
+#include "Card.h"
+
+namespace UNO {
+
+/**
+ * 卡牌原型（享元）
+ * 每种 (颜色, 类型, 数字) 只有一个不可变的卡牌对象，在第一次使用时创建一次，
+ * 之后所有牌堆、手牌和牌局共用。一张实体牌的身份只用它的单字节编码表示，
+ * 原型的 ID 也就是编码，所以同样的两张牌可以互换。
+ */
+class CardPrototypes {
+public:
+    /**
+     * 获取编码对应的原型。选过颜色的万能牌对应未选颜色的原型
+     * @return 无效编码返回 nullptr
+     */
+    static const Card* get(Common::CardCode code);
+
+    /**
+     * 以 shared_ptr 形式获取原型，便于放进手牌等现有接口。
+     * 返回的指针不持有所有权，也没有引用计数，复制和销毁都不会触及原子操作
+     */
+    static std::shared_ptr<Card> share(Common::CardCode code);
+};
+
+} // namespace UNO
@@ -1,32 +1,23 @@
 #pragma once
 #include "Card.h"
+#include "CardEffects.h"
 
 namespace UNO {
 
 /**
  * 功能卡牌基类
- * 所有特殊功能卡牌的基类
+ * 所有特殊功能卡牌的基类。效果本身在 CardEffects 的分派表中按卡牌类型查表执行，
+ * 这里只负责把 JSON 参数解码、校验为 EffectParams
  */
 class FunctionCard : public Card {
 public:
     FunctionCard(const CardData& data);
     virtual ~FunctionCard() = default;
 
-    // 功能卡总是需要应用效果
-    void applyEffect(GameState& gameState, int playerId, const nlohmann::json& params = {}) override = 0;
-
-protected:
-    // 辅助方法：让指定玩家抽牌
-    void makePlayerDrawCards(GameState& gameState, int playerId, int count);
-    
-    // 辅助方法：跳过指定玩家的回合
-    void skipPlayerTurn(GameState& gameState, int playerId);
-    
-    // 辅助方法：反转游戏方向
-    void reversePlayDirection(GameState& gameState);
-    
-    // 辅助方法：改变当前颜色
-    void changeCurrentColor(GameState& gameState, CardColor newColor);
+    // 解码并校验参数后执行效果，参数无效时抛出 std::invalid_argument
+    void applyEffect(GameState& gameState, int playerId, const nlohmann::json& params = {}) override;
+    bool requiresParameters() const override { return CardEffects::requiresColor(getType()); }
+    bool validateParameters(const nlohmann::json& params) const override;
 };
 
 /**
@@ -36,7 +27,6 @@ protected:
 class SkipCard : public FunctionCard {
 public:
     SkipCard(int id, CardColor color);
-    void applyEffect(GameState& gameState, int playerId, const nlohmann::json& params = {}) override;
 };
 
 /**
@@ -46,7 +36,6 @@ public:
 class ReverseCard : public FunctionCard {
 public:
     ReverseCard(int id, CardColor color);
-    void applyEffect(GameState& gameState, int playerId, const nlohmann::json& params = {}) override;
 };
 
 /**
@@ -56,7 +45,6 @@ public:
 class DrawTwoCard : public FunctionCard {
 public:
     DrawTwoCard(int id, CardColor color);
-    void applyEffect(GameState& gameState, int playerId, const nlohmann::json& params = {}) override;
 };
 
 /**
@@ -66,10 +54,7 @@ public:
 class WildCard : public FunctionCard {
 public:
     WildCard(int id);
-    void applyEffect(GameState& gameState, int playerId, const nlohmann::json& params = {}) override;
-    bool requiresParameters() const override { return true; }
     nlohmann::json getParameterHint() const override;
-    bool validateParameters(const nlohmann::json& params) const override;
 };
 
 /**
@@ -81,13 +66,7 @@ class WildDrawFourCard : public FunctionCard {
 public:
     WildDrawFourCard(int id);
     bool canPlayOn(const Card* topCard) const override;
-    void applyEffect(GameState& gameState, int playerId, const nlohmann::json& params = {}) override;
-    bool requiresParameters() const override { return true; }
     nlohmann::json getParameterHint() const override;
-    bool validateParameters(const nlohmann::json& params) const override;
-    
-private:
-    bool validatePlayCondition(const GameState& gameState, int playerId) const;
 };
 
 /**
@@ -97,13 +76,7 @@ private:
 class PackageCard : public FunctionCard {
 public:
     PackageCard(int id, CardColor color);
-    void applyEffect(GameState& gameState, int playerId, const nlohmann::json& params = {}) override;
-    bool requiresParameters() const override { return true; }
     nlohmann::json getParameterHint() const override;
-    bool validateParameters(const nlohmann::json& params) const override;
-    
-private:
-    std::vector<CardData> getDiscardableCards(const GameState& gameState, int playerId, CardColor targetColor) const;
 };
 
 /**
@@ -114,20 +87,7 @@ private:
 class FlashCard : public FunctionCard {
 public:
     FlashCard(int id);
-    void applyEffect(GameState& gameState, int playerId, const nlohmann::json& params = {}) override;
-    bool requiresParameters() const override { return true; }
     nlohmann::json getParameterHint() const override;
-    bool validateParameters(const nlohmann::json& params) const override;
-    
-private:
-    struct FlashRoundResult {
-        int cardsPlayed;    // 该回合出的牌数
-        int playersSkipped; // 跳过的玩家数
-        bool completed;     // 是否完成整个流程
-    };
-    
-    FlashRoundResult processFlashRound(GameState& gameState, int startPlayerId, CardColor flashColor);
-    bool canPlayerRespondToFlash(const GameState& gameState, int playerId, CardColor flashColor) const;
 };
 
 } // namespace UNO
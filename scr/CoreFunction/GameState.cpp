@@ -2,12 +2,59 @@
 #include "game_board.h"
 #include "stat.h"
 #include "cards.h"
+#include "card_view.h"
+#include "CardPrototypes.h"
 #include <algorithm>
 
 namespace UNO {
 
+int GameState::discardPlayerCards(int playerId, CardColor color, CardType type) {
+    if (Player* player = getPlayer(playerId)) {
+        std::vector<std::shared_ptr<Card>> discarded;
+        return static_cast<int>(player->takeCards(color, type, discarded));
+    }
+    
+    int discardedCount = 0;
+    for (const auto& card : getPlayerHand(playerId)) {
+        if (card.color == color && card.type == type) {
+            discardPlayerCard(playerId, card.id);
+            discardedCount++;
+        }
+    }
+    return discardedCount;
+}
+
+bool GameState::hasCardOfColorOrWild(int playerId, CardColor color) const {
+    if (const Player* player = getPlayer(playerId)) {
+        return player->countCards(color) + player->countCards(CardColor::WILD) > 0;
+    }
+    
+    for (const auto& card : getPlayerHand(playerId)) {
+        if (card.color == color || card.color == CardColor::WILD) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::shared_ptr<Card> GameState::stealPlayerCard(int thiefId, int targetId, CardType type, std::mt19937& rng) {
+    Player* thief = getPlayer(thiefId);
+    Player* target = getPlayer(targetId);
+    if (!thief || !target) {
+        return nullptr;
+    }
+    
+    auto card = target->takeRandomCard(type, rng);
+    if (card) {
+        thief->addCardToHand(card);
+    }
+    return card;
+}
+
 GameBoardAdapter::GameBoardAdapter(Game::GameBoard* gameBoard) 
-    : m_gameBoard(gameBoard) {}
+    : m_gameBoard(gameBoard) {
+    eventBus.subscribe<&GameBoardAdapter::logCardEvent>(this);
+}
 
 std::shared_ptr<Card> GameBoardAdapter::getTopCard() const {
     if (!m_gameBoard) return nullptr;
@@ -153,6 +200,55 @@ std::vector<CardData> GameBoardAdapter::getPlayerHand(int playerId) const {
     return hand;
 }
 
+int GameBoardAdapter::getPlayerHandSize(int playerId) const {
+    if (!m_gameBoard || playerId < 0 || playerId >= getPlayerCount()) {
+        return 0;
+    }
+    
+    return m_gameBoard->GetPlayerStats()[playerId].GetRemainingHandCardsNum();
+}
+
+bool GameBoardAdapter::hasCardOfColorOrWild(int playerId, CardColor color) const {
+    // GameBoard 只记录手牌张数，看不到具体的牌，和 getPlayerHand 一样当作没有
+    return false;
+}
+
+int GameBoardAdapter::getCardsNumToDraw() const {
+    if (!m_gameBoard) return 1;
+    
+    auto gameStat = m_gameBoard->GetGameStat();
+    if (!gameStat) return 1;
+    
+    return gameStat->GetCardsNumToDraw();
+}
+
+std::vector<CardData> GameBoardAdapter::getCollectableCards() const {
+    std::vector<CardData> cards;
+    if (!m_gameBoard || !m_gameBoard->GetDiscardPile()) {
+        return cards;
+    }
+    
+    for (const auto& card : m_gameBoard->GetDiscardPile()->Candidates()) {
+        cards.push_back(CardData::fromCode(Game::ToCode(card)));
+    }
+    return cards;
+}
+
+std::vector<CardData> GameBoardAdapter::peekDrawPile(int count) const {
+    std::vector<CardData> cards;
+    if (!m_gameBoard) {
+        return cards;
+    }
+    
+    // 只能看到幸运星发动后供选的那几张：发动之前没有，选完就收回
+    const auto& offer = m_gameBoard->GetLuckyStarOffer();
+    int viewNum = std::min<int>(count, offer.size());
+    for (int i = 0; i < viewNum; i++) {
+        cards.push_back(CardData::fromCode(Game::ToCode(offer[i])));
+    }
+    return cards;
+}
+
 void GameBoardAdapter::discardPlayerCard(int playerId, int cardId) {
     if (!m_gameBoard) return;
     
@@ -160,11 +256,12 @@ void GameBoardAdapter::discardPlayerCard(int playerId, int cardId) {
     std::cout << "Player " << playerId << " discards card " << cardId << std::endl;
 }
 
-void GameBoardAdapter::notifyCardEffect(const std::string& effect, const nlohmann::json& data) {
+void GameBoardAdapter::logCardEvent(const CardEvent& event) {
     if (!m_gameBoard) return;
     
-    // 在实际实现中，这里应该通知所有玩家卡牌效果
-    std::cout << "Card effect: " << effect << " with data: " << data.dump() << std::endl;
+    // 在实际实现中，网络适配器会订阅总线通知所有玩家卡牌效果
+    std::cout << "Card effect: " << getCardEventName(event.kind)
+              << " with data: " << cardEventToJson(event).dump() << std::endl;
 }
 
 bool GameBoardAdapter::validateWildDrawFour(int playerId) const {
@@ -196,25 +293,12 @@ bool GameBoardAdapter::isCardPlayPhase() const {
 
 // 辅助方法实现
 CardColor GameBoardAdapter::convertToCardColor(Game::CardColor color) const {
-    switch (color) {
-        case Game::CardColor::RED: return CardColor::RED;
-        case Game::CardColor::YELLOW: return CardColor::YELLOW;
-        case Game::CardColor::GREEN: return CardColor::GREEN;
-        case Game::CardColor::BLUE: return CardColor::BLUE;
-        case Game::CardColor::BLACK: return CardColor::WILD;
-        default: return CardColor::WILD;
-    }
+    // 两套颜色都和单字节编码的颜色顺序一致
+    return static_cast<CardColor>(Game::ToCodeColor(color));
 }
 
 Game::CardColor GameBoardAdapter::convertFromCardColor(CardColor color) const {
-    switch (color) {
-        case CardColor::RED: return Game::CardColor::RED;
-        case CardColor::YELLOW: return Game::CardColor::YELLOW;
-        case CardColor::GREEN: return Game::CardColor::GREEN;
-        case CardColor::BLUE: return Game::CardColor::BLUE;
-        case CardColor::WILD: return Game::CardColor::BLACK;
-        default: return Game::CardColor::BLACK;
-    }
+    return Game::FromCodeColor(static_cast<Common::CodeColor>(color));
 }
 
 CardType GameBoardAdapter::convertToCardType(Game::CardText text) const {
@@ -254,39 +338,8 @@ CardType GameBoardAdapter::convertToCardType(Game::CardText text) const {
 }
 
 std::shared_ptr<Card> GameBoardAdapter::createCardFromGameCard(const Game::Card& gameCard) const {
-    // 提取数字（如果是数字卡）
-    int number = -1;
-    if (gameCard.mText >= Game::CardText::NUMBER_0 && gameCard.mText <= Game::CardText::NUMBER_9) {
-        number = static_cast<int>(gameCard.mText) - static_cast<int>(Game::CardText::NUMBER_0);
-    }
-    
-    // 创建 CardData
-    CardData data(
-        -1, // 需要从游戏卡牌获取真实ID
-        convertToCardColor(gameCard.mColor),
-        convertToCardType(gameCard.mText),
-        number
-    );
-    
-    // 根据类型创建具体卡牌对象
-    switch (data.type) {
-        case CardType::SKIP:
-            return std::make_shared<SkipCard>(data.id, data.color);
-        case CardType::REVERSE:
-            return std::make_shared<ReverseCard>(data.id, data.color);
-        case CardType::DRAW_TWO:
-            return std::make_shared<DrawTwoCard>(data.id, data.color);
-        case CardType::WILD:
-            return std::make_shared<WildCard>(data.id);
-        case CardType::WILD_DRAW_FOUR:
-            return std::make_shared<WildDrawFourCard>(data.id);
-        case CardType::PACKAGE:
-            return std::make_shared<PackageCard>(data.id, data.color);
-        case CardType::FLASH:
-            return std::make_shared<FlashCard>(data.id);
-        default:
-            return std::make_shared<Card>(data);
-    }
+    // 返回共用的卡牌原型，颜色、类型、数字和名称都来自单字节编码
+    return CardPrototypes::share(Game::ToCode(gameCard));
 }
 
 } // namespace UNO
@@ -2,15 +2,19 @@
 
 #include <vector>
 #include <memory>
+#include <random>
 #include <nlohmann/json.hpp>
 #include "Card.h"
 #include "FunctionCard.h"
 #include "Player.h"
+#include "CardEvents.h"
 
 namespace UNO {
 
 // 前向声明
+namespace Game {
 class GameBoard;
+}
 
 /**
  * 游戏状态接口类
@@ -44,8 +48,55 @@ public:
     virtual std::vector<CardData> getPlayerHand(int playerId) const = 0;
     virtual void discardPlayerCard(int playerId, int cardId) = 0;
     
-    // 事件通知
-    virtual void notifyCardEffect(const std::string& effect, const nlohmann::json& data) = 0;
+    /**
+     * 玩家的手牌张数，对手的手牌看不到时也能知道。默认实现取整手牌的大小
+     */
+    virtual int getPlayerHandSize(int playerId) const { return static_cast<int>(getPlayerHand(playerId).size()); }
+    
+    /**
+     * 持有 Player 对象的实现返回该玩家，下面几个按颜色和类型访问手牌的默认实现就走
+     * 手牌索引，只访问符合条件的牌；返回空指针时退回复制整手牌逐张比较
+     */
+    virtual Player* getPlayer(int /*playerId*/) const { return nullptr; }
+    
+    /**
+     * 丢弃玩家手中所有指定颜色和类型的牌（包装卡）
+     * @return 丢弃的张数
+     */
+    virtual int discardPlayerCards(int playerId, CardColor color, CardType type);
+    
+    /**
+     * 玩家能否响应闪光卡：手中有指定颜色的牌或万能牌
+     */
+    virtual bool hasCardOfColorOrWild(int playerId, CardColor color) const;
+    
+    /**
+     * 小偷：从目标玩家手中随机拿走一张指定类型的牌，加入小偷的手牌。默认实现
+     * 需要 getPlayer，看不到手牌时什么也不做
+     * @return 拿走的牌，目标没有该类型的牌时返回空指针
+     */
+    virtual std::shared_ptr<Card> stealPlayerCard(int thiefId, int targetId, CardType type, std::mt19937& rng);
+    
+    /**
+     * 本回合要抽的张数，叠加 +2、+4 后大于 1。默认没有叠加
+     */
+    virtual int getCardsNumToDraw() const { return 1; }
+    
+    /**
+     * 收藏家可以拿的牌：弃牌堆中顶牌以下的牌，最下面的在前。默认看不到
+     */
+    virtual std::vector<CardData> getCollectableCards() const { return {}; }
+    
+    /**
+     * 幸运星发动后供选的抽牌堆顶部的牌，最多 count 张，最上面的在前。只在发动之后
+     * （次数已经扣掉）、选定之前能看到；默认看不到
+     */
+    virtual std::vector<CardData> peekDrawPile(int /*count*/) const { return {}; }
+    
+    // 事件通知：效果事件写入本牌桌的事件总线，由执行效果的一方在效果结束后调用 flush 分发
+    // （FunctionCard::applyEffect 在效果执行完立即分发）；缓冲写满时也会自动分发
+    void publishCardEvent(const CardEvent& event) { eventBus.publish(event); }
+    CardEventBus& getEventBus() { return eventBus; }
     
     // 验证方法
     virtual bool validateWildDrawFour(int playerId) const = 0;
@@ -53,6 +104,9 @@ public:
     // 回合阶段管理
     virtual bool isSkillPhase() const = 0;
     virtual bool isCardPlayPhase() const = 0;
+
+protected:
+    CardEventBus eventBus;
 };
 
 /**
@@ -63,6 +117,10 @@ class GameBoardAdapter : public GameState {
 public:
     explicit GameBoardAdapter(Game::GameBoard* gameBoard);
     
+    // 构造时以 this 订阅了事件总线，复制或移动后订阅会指向原对象，所以禁止
+    GameBoardAdapter(const GameBoardAdapter&) = delete;
+    GameBoardAdapter& operator=(const GameBoardAdapter&) = delete;
+    
     // GameState 接口实现
     std::shared_ptr<Card> getTopCard() const override;
     CardColor getCurrentColor() const override;
@@ -83,8 +141,12 @@ public:
     
     std::vector<CardData> getPlayerHand(int playerId) const override;
     void discardPlayerCard(int playerId, int cardId) override;
+    int getPlayerHandSize(int playerId) const override;
+    bool hasCardOfColorOrWild(int playerId, CardColor color) const override;
     
-    void notifyCardEffect(const std::string& effect, const nlohmann::json& data) override;
+    int getCardsNumToDraw() const override;
+    std::vector<CardData> getCollectableCards() const override;
+    std::vector<CardData> peekDrawPile(int count) const override;
     
     bool validateWildDrawFour(int playerId) const override;
     
@@ -99,6 +161,9 @@ private:
     Game::CardColor convertFromCardColor(CardColor color) const;
     CardType convertToCardType(Game::CardText text) const;
     std::shared_ptr<Card> createCardFromGameCard(const Game::Card& gameCard) const;
+    
+    // 事件总线的日志订阅者
+    void logCardEvent(const CardEvent& event);
 };
 
 } // namespace UNO
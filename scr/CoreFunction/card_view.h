@@ -0,0 +1,109 @@
+#pragma once
+
+#include "cards.h"
+#include "../common/card_code.h"
+
+namespace UNO { namespace Game {
+
+/**
+ * Conversions between \c Card and the canonical one-byte code. They are switches
+ * over enums, which the compiler turns into table lookups, so a \c Card is just
+ * an unpacked view of its code.
+ */
+constexpr Common::CodeColor ToCodeColor(CardColor color)
+{
+    switch (color) {
+        case CardColor::RED:    return Common::CodeColor::RED;
+        case CardColor::YELLOW: return Common::CodeColor::YELLOW;
+        case CardColor::GREEN:  return Common::CodeColor::GREEN;
+        case CardColor::BLUE:   return Common::CodeColor::BLUE;
+        default:                return Common::CodeColor::WILD;
+    }
+}
+
+constexpr CardColor FromCodeColor(Common::CodeColor color)
+{
+    switch (color) {
+        case Common::CodeColor::RED:    return CardColor::RED;
+        case Common::CodeColor::YELLOW: return CardColor::YELLOW;
+        case Common::CodeColor::GREEN:  return CardColor::GREEN;
+        case Common::CodeColor::BLUE:   return CardColor::BLUE;
+        default:                        return CardColor::BLACK;
+    }
+}
+
+constexpr Common::CodeFace ToCodeFace(CardText text)
+{
+    switch (text) {
+        case CardText::NUMBER_0:  return Common::CodeFace::NUMBER_0;
+        case CardText::NUMBER_1:  return Common::CodeFace::NUMBER_1;
+        case CardText::NUMBER_2:  return Common::CodeFace::NUMBER_2;
+        case CardText::NUMBER_3:  return Common::CodeFace::NUMBER_3;
+        case CardText::NUMBER_4:  return Common::CodeFace::NUMBER_4;
+        case CardText::NUMBER_5:  return Common::CodeFace::NUMBER_5;
+        case CardText::NUMBER_6:  return Common::CodeFace::NUMBER_6;
+        case CardText::NUMBER_7:  return Common::CodeFace::NUMBER_7;
+        case CardText::NUMBER_8:  return Common::CodeFace::NUMBER_8;
+        case CardText::NUMBER_9:  return Common::CodeFace::NUMBER_9;
+        case CardText::SKIP:      return Common::CodeFace::SKIP;
+        case CardText::REVERSE:   return Common::CodeFace::REVERSE;
+        case CardText::DRAW_TWO:  return Common::CodeFace::DRAW_TWO;
+        case CardText::WILD:      return Common::CodeFace::WILD;
+        case CardText::DRAW_FOUR: return Common::CodeFace::DRAW_FOUR;
+        case CardText::PACKAGE:   return Common::CodeFace::PACKAGE;
+        case CardText::FLASH:     return Common::CodeFace::FLASH;
+        default:                  return Common::CodeFace::EMPTY;
+    }
+}
+
+constexpr CardText FromCodeFace(Common::CodeFace face)
+{
+    switch (face) {
+        case Common::CodeFace::NUMBER_0:  return CardText::NUMBER_0;
+        case Common::CodeFace::NUMBER_1:  return CardText::NUMBER_1;
+        case Common::CodeFace::NUMBER_2:  return CardText::NUMBER_2;
+        case Common::CodeFace::NUMBER_3:  return CardText::NUMBER_3;
+        case Common::CodeFace::NUMBER_4:  return CardText::NUMBER_4;
+        case Common::CodeFace::NUMBER_5:  return CardText::NUMBER_5;
+        case Common::CodeFace::NUMBER_6:  return CardText::NUMBER_6;
+        case Common::CodeFace::NUMBER_7:  return CardText::NUMBER_7;
+        case Common::CodeFace::NUMBER_8:  return CardText::NUMBER_8;
+        case Common::CodeFace::NUMBER_9:  return CardText::NUMBER_9;
+        case Common::CodeFace::SKIP:      return CardText::SKIP;
+        case Common::CodeFace::REVERSE:   return CardText::REVERSE;
+        case Common::CodeFace::DRAW_TWO:  return CardText::DRAW_TWO;
+        case Common::CodeFace::WILD:      return CardText::WILD;
+        case Common::CodeFace::DRAW_FOUR: return CardText::DRAW_FOUR;
+        case Common::CodeFace::PACKAGE:   return CardText::PACKAGE;
+        case Common::CodeFace::FLASH:     return CardText::FLASH;
+        default:                          return CardText::EMPTY;
+    }
+}
+
+inline Common::CardCode ToCode(Card card)
+{
+    return Common::CardCode(ToCodeColor(card.mColor), ToCodeFace(card.mText));
+}
+
+inline Card FromCode(Common::CardCode code)
+{
+    return Card{FromCodeColor(code.GetColor()), FromCodeFace(code.GetFace())};
+}
+
+/**
+ * Convert \p num cards between the two representations, e.g. for a message.
+ */
+inline void ToCodes(const Card *cards, int num, Common::CardCode *codes)
+{
+    for (int i = 0; i < num; i++) {
+        codes[i] = ToCode(cards[i]);
+    }
+}
+
+inline void FromCodes(const Common::CardCode *codes, int num, Card *cards)
+{
+    for (int i = 0; i < num; i++) {
+        cards[i] = FromCode(codes[i]);
+    }
+}
+}}
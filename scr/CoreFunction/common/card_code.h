@@ -0,0 +1,199 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <string_view>
+
+namespace UNO { namespace Common {
+
+/**
+ * Colors and faces of the canonical card encoding. The orders are those of
+ * UNO::CardColor and UNO::CardType (after the ten numbers), so converting
+ * from the card system's types is an addition.
+ */
+enum class CodeColor : uint8_t {
+    RED,
+    YELLOW,
+    GREEN,
+    BLUE,
+    WILD
+};
+
+enum class CodeFace : uint8_t {
+    NUMBER_0, NUMBER_1, NUMBER_2, NUMBER_3, NUMBER_4,
+    NUMBER_5, NUMBER_6, NUMBER_7, NUMBER_8, NUMBER_9,
+    SKIP,
+    REVERSE,
+    DRAW_TWO,
+    WILD,
+    DRAW_FOUR,
+    PACKAGE,
+    FLASH,
+    EMPTY  // no face, e.g. the last played card after a flipped draw card
+};
+
+enum class CardCategory : uint8_t {
+    NUMBER,
+    ACTION,
+    WILD,
+    CUSTOM,
+    NONE
+};
+
+/**
+ * Properties of all 256 codes, built at compile time.
+ */
+namespace CardCodeTable {
+constexpr int FACE_BITS = 5;
+constexpr uint8_t FACE_MASK = (1 << FACE_BITS) - 1;
+
+struct CodeInfo {
+    char mName[24];
+    uint8_t mNameLen;
+    uint8_t mScore;
+    CardCategory mCategory;
+    bool mIsWild;
+    bool mIsValid;
+};
+
+inline constexpr std::string_view COLOR_NAMES[] = {"Red", "Yellow", "Green", "Blue", "Wild"};
+inline constexpr std::string_view FACE_NAMES[] = {
+    "0", "1", "2", "3", "4", "5", "6", "7", "8", "9",
+    "Skip", "Reverse", "Draw Two", "Wild", "Wild Draw Four", "Package", "Flash", ""
+};
+
+constexpr std::array<CodeInfo, 256> BuildTable() {
+    constexpr int colorNum = std::size(COLOR_NAMES);
+    constexpr int faceNum = std::size(FACE_NAMES);
+
+    std::array<CodeInfo, 256> table{};
+    for (int byte = 0; byte < 256; byte++) {
+        CodeInfo &info = table[byte];
+        int color = byte >> FACE_BITS;
+        int face = byte & FACE_MASK;
+        info.mCategory = CardCategory::NONE;
+        if (color >= colorNum || face >= faceNum) {
+            continue;
+        }
+        info.mIsValid = true;
+
+        auto faceValue = static_cast<CodeFace>(face);
+        info.mIsWild = (faceValue == CodeFace::WILD || faceValue == CodeFace::DRAW_FOUR
+            || faceValue == CodeFace::FLASH);
+        if (faceValue <= CodeFace::NUMBER_9) {
+            info.mCategory = CardCategory::NUMBER;
+            info.mScore = face;
+        }
+        else if (faceValue <= CodeFace::DRAW_TWO) {
+            info.mCategory = CardCategory::ACTION;
+            info.mScore = 20;
+        }
+        else if (faceValue <= CodeFace::DRAW_FOUR) {
+            info.mCategory = CardCategory::WILD;
+            info.mScore = 50;
+        }
+        else if (faceValue <= CodeFace::FLASH) {
+            info.mCategory = CardCategory::CUSTOM;
+            info.mScore = info.mIsWild ? 50 : 20;
+        }
+
+        // a wild face already says it is wild, so its color is only named once chosen
+        std::string_view parts[2] = {COLOR_NAMES[color], FACE_NAMES[face]};
+        if (color == static_cast<int>(CodeColor::WILD) && (info.mIsWild || faceValue == CodeFace::EMPTY)) {
+            parts[0] = faceValue == CodeFace::EMPTY ? COLOR_NAMES[color] : "";
+            parts[1] = faceValue == CodeFace::EMPTY ? "" : FACE_NAMES[face];
+        }
+        for (auto part : parts) {
+            if (part.empty()) {
+                continue;
+            }
+            if (info.mNameLen > 0) {
+                info.mName[info.mNameLen++] = ' ';
+            }
+            for (char ch : part) {
+                info.mName[info.mNameLen++] = ch;
+            }
+        }
+    }
+    return table;
+}
+
+inline constexpr std::array<CodeInfo, 256> TABLE = BuildTable();
+}
+
+/**
+ * A card in one byte: the color in the high 3 bits and the face in the low 5.
+ * Every property of a card is a lookup in a table built at compile time, and
+ * hands, decks, journals and messages all store cards as this code.
+ */
+class CardCode {
+public:
+    constexpr static int FACE_BITS = CardCodeTable::FACE_BITS;
+    constexpr static uint8_t FACE_MASK = CardCodeTable::FACE_MASK;
+    constexpr static uint8_t INVALID = 0xff;
+
+    constexpr CardCode() = default;
+
+    constexpr CardCode(CodeColor color, CodeFace face)
+        : mCode(static_cast<uint8_t>(static_cast<uint8_t>(color) << FACE_BITS | static_cast<uint8_t>(face))) {}
+
+    constexpr static CardCode FromByte(uint8_t byte) {
+        CardCode code;
+        code.mCode = byte;
+        return code;
+    }
+
+    constexpr uint8_t ToByte() const { return mCode; }
+
+    constexpr CodeColor GetColor() const { return static_cast<CodeColor>(mCode >> FACE_BITS); }
+
+    constexpr CodeFace GetFace() const { return static_cast<CodeFace>(mCode & FACE_MASK); }
+
+    /**
+     * The same face in another color, e.g. a wild card once its color has been chosen.
+     */
+    constexpr CardCode WithColor(CodeColor color) const { return CardCode(color, GetFace()); }
+
+    constexpr bool IsValid() const { return Info().mIsValid; }
+
+    /**
+     * \return the number of a number card, -1 for others
+     */
+    constexpr int GetNumber() const { return GetCategory() == CardCategory::NUMBER ? static_cast<int>(GetFace()) : -1; }
+
+    constexpr bool IsWild() const { return Info().mIsWild; }
+
+    constexpr CardCategory GetCategory() const { return Info().mCategory; }
+
+    /**
+     * Points the card is worth in the hand of a loser, by the standard scoring.
+     */
+    constexpr int GetScore() const { return Info().mScore; }
+
+    /**
+     * e.g. "Red 7", "Blue Draw Two", "Wild Draw Four", empty for an invalid code.
+     */
+    constexpr std::string_view GetName() const { return std::string_view(Info().mName, Info().mNameLen); }
+
+    /**
+     * The name without the color, e.g. "7", "Draw Two", empty for an invalid code.
+     */
+    constexpr std::string_view GetFaceName() const {
+        return IsValid() ? CardCodeTable::FACE_NAMES[mCode & FACE_MASK] : std::string_view();
+    }
+
+    constexpr bool operator==(const CardCode &code) const = default;
+
+private:
+    constexpr const CardCodeTable::CodeInfo &Info() const { return CardCodeTable::TABLE[mCode]; }
+
+private:
+    uint8_t mCode{INVALID};
+};
+static_assert(sizeof(CardCode) == 1, "a card code must fit in one byte");
+static_assert(CardCode(CodeColor::RED, CodeFace::NUMBER_7).GetName() == "Red 7");
+static_assert(CardCode(CodeColor::WILD, CodeFace::DRAW_FOUR).GetName() == "Wild Draw Four");
+static_assert(CardCode(CodeColor::BLUE, CodeFace::DRAW_FOUR).GetName() == "Blue Wild Draw Four");
+static_assert(!CardCode().IsValid());
+}}
@@ -10,6 +10,13 @@ public:
     static int mPlayerNum;
     static int mTimeoutPerTurn;
     static int mHandCardsNumPerRow;
+    // size of the shoe in standard decks and of the initial hands, set by the server
+    static int mDeckNum;
+    static int mInitHandCardsNum;
+    // every message has to fit the buffers of a session
+    constexpr static int MAX_MSG_SIZE = 1024;
+    // usernames of the whole table travel in one GameStartMsg
+    constexpr static int MAX_USERNAME_LEN = 15;
     
     // 新增：角色系统相关配置
     static bool mEnableCharacterSystem;
@@ -1,4 +1,5 @@
 #include "config.h"
+#include "../game/info.h"
 
 namespace UNO { namespace Common {
 
@@ -19,6 +20,10 @@ const std::string Config::CMD_OPT_SHORT_CFGFILE = "f";
 const std::string Config::CMD_OPT_LONG_CFGFILE = "file";
 const std::string Config::CMD_OPT_BOTH_CFGFILE = CMD_OPT_SHORT_CFGFILE + ", " + CMD_OPT_LONG_CFGFILE;
 const std::string Config::CMD_OPT_LONG_LOGFILE = "log";
+const std::string Config::CMD_OPT_LONG_JOURNAL = "journal";
+const std::string Config::CMD_OPT_LONG_METRICS = "metrics";
+const std::string Config::CMD_OPT_LONG_DECKS = "decks";
+const std::string Config::CMD_OPT_LONG_HAND = "hand";
 const std::string Config::CMD_OPT_SHORT_VERSION = "v";
 const std::string Config::CMD_OPT_LONG_VERSION = "version";
 const std::string Config::CMD_OPT_BOTH_VERSION = CMD_OPT_SHORT_VERSION + ", " + CMD_OPT_LONG_VERSION;
@@ -48,11 +53,15 @@ const std::string Config::FILE_OPT_WILD = "wild";
 const std::string Config::FILE_OPT_GAME_MODE = "gameMode";
 const std::string Config::FILE_OPT_ENABLE_CHARACTERS = "enableCharacters";
 const std::string Config::FILE_OPT_MAX_SKILL_USES = "maxSkillUses";
+const std::string Config::FILE_OPT_DECKS = "deckNum";
+const std::string Config::FILE_OPT_HAND = "initHandCardsNum";
 
 // define static common variables here
 int Common::mPlayerNum;
 int Common::mTimeoutPerTurn;
 int Common::mHandCardsNumPerRow;
+int Common::mDeckNum;
+int Common::mInitHandCardsNum;
 bool Common::mEnableCharacterSystem;
 int Common::mMaxSkillUsesPerGame;
 std::string Common::mRedEscape;
@@ -87,6 +96,10 @@ Config::Config(int argc, const char **argv)
         (CMD_OPT_BOTH_PLAYERS, "the number of players", cxxopts::value<int>())
         (CMD_OPT_BOTH_CFGFILE, "the path of config file", cxxopts::value<std::string>())
         (CMD_OPT_LONG_LOGFILE, "the path of log file", cxxopts::value<std::string>())
+        (CMD_OPT_LONG_JOURNAL, "the path of table journal, the table is recovered from it if it exists", cxxopts::value<std::string>())
+        (CMD_OPT_LONG_METRICS, "the path that metrics are dumped to every few seconds", cxxopts::value<std::string>())
+        (CMD_OPT_LONG_DECKS, "the number of standard decks shuffled together, one per 8 players by default", cxxopts::value<int>())
+        (CMD_OPT_LONG_HAND, "the number of cards each player is dealt, 7 by default", cxxopts::value<int>())
         (CMD_OPT_BOTH_MODE, "game mode: classic, characters, custom", cxxopts::value<std::string>())
         (CMD_OPT_LONG_NO_CHARACTERS, "disable character system", cxxopts::value<bool>())
         (CMD_OPT_BOTH_VERSION, "show version of application", cxxopts::value<bool>())
@@ -128,7 +141,13 @@ std::unique_ptr<GameConfigInfo> Config::Parse()
     }
 
     // handle common config here
-    SetUpCommonConfig();
+    try {
+        SetUpCommonConfig();
+    }
+    catch (std::exception &e) {
+        std::cout << e.what() << std::endl;
+        std::exit(-1);
+    }
 
     // the main function will handle game config
     return std::move(mGameConfigInfo);
@@ -153,6 +172,12 @@ void Config::ParseFileOpts()
         if ((*mServerNode)[FILE_OPT_PLAYERS].IsDefined()) {
             mCommonConfigInfo->mPlayerNum = (*mServerNode)[FILE_OPT_PLAYERS].as<int>();
         }
+        if ((*mServerNode)[FILE_OPT_DECKS].IsDefined()) {
+            mCommonConfigInfo->mDeckNum = (*mServerNode)[FILE_OPT_DECKS].as<int>();
+        }
+        if ((*mServerNode)[FILE_OPT_HAND].IsDefined()) {
+            mCommonConfigInfo->mInitHandCardsNum = (*mServerNode)[FILE_OPT_HAND].as<int>();
+        }
         if ((*mServerNode)[FILE_OPT_GAME_MODE].IsDefined()) {
             mCommonConfigInfo->mGameMode = (*mServerNode)[FILE_OPT_GAME_MODE].as<std::string>();
         }
@@ -206,6 +231,10 @@ void Config::ParseCmdlineOpts()
     if (mCmdlineOpts->count(CMD_OPT_LONG_CONNECT) && mCmdlineOpts->count(CMD_OPT_LONG_PLAYERS)) {
         throw std::runtime_error("only server side can specify -n option");
     }
+    if (mCmdlineOpts->count(CMD_OPT_LONG_CONNECT)
+        && (mCmdlineOpts->count(CMD_OPT_LONG_DECKS) || mCmdlineOpts->count(CMD_OPT_LONG_HAND))) {
+        throw std::runtime_error("only server side can specify --decks and --hand options");
+    }
 
     // -l
     if (mCmdlineOpts->count(CMD_OPT_LONG_LISTEN)) {
@@ -232,11 +261,34 @@ void Config::ParseCmdlineOpts()
         mCommonConfigInfo->mPlayerNum = (*mCmdlineOpts)[CMD_OPT_LONG_PLAYERS].as<int>();
     }
 
+    // --decks
+    if (mCmdlineOpts->count(CMD_OPT_LONG_DECKS)) {
+        mCommonConfigInfo->mDeckNum = (*mCmdlineOpts)[CMD_OPT_LONG_DECKS].as<int>();
+    }
+
+    // --hand
+    if (mCmdlineOpts->count(CMD_OPT_LONG_HAND)) {
+        mCommonConfigInfo->mInitHandCardsNum = (*mCmdlineOpts)[CMD_OPT_LONG_HAND].as<int>();
+    }
+
     // --log
     if (mCmdlineOpts->count(CMD_OPT_LONG_LOGFILE)) {
         mGameConfigInfo->mLogPath = (*mCmdlineOpts)[CMD_OPT_LONG_LOGFILE].as<std::string>();
     }
 
+    // --journal
+    if (mCmdlineOpts->count(CMD_OPT_LONG_JOURNAL)) {
+        if (!mGameConfigInfo->mIsServer) {
+            throw std::runtime_error("only server side can specify --journal option");
+        }
+        mGameConfigInfo->mJournalPath = (*mCmdlineOpts)[CMD_OPT_LONG_JOURNAL].as<std::string>();
+    }
+
+    // --metrics
+    if (mCmdlineOpts->count(CMD_OPT_LONG_METRICS)) {
+        mGameConfigInfo->mMetricsPath = (*mCmdlineOpts)[CMD_OPT_LONG_METRICS].as<std::string>();
+    }
+
     // -m / --mode
     if (mCmdlineOpts->count(CMD_OPT_LONG_MODE)) {
         mCommonConfigInfo->mGameMode = (*mCmdlineOpts)[CMD_OPT_LONG_MODE].as<std::string>();
@@ -250,7 +302,27 @@ void Config::ParseCmdlineOpts()
 
 void Config::SetUpCommonConfig()
 {
-    Common::mPlayerNum = mCommonConfigInfo->mPlayerNum.value_or(3);
+    Common::mPlayerNum = mCommonConfigInfo->mPlayerNum.value_or(DEFAULT_PLAYER_NUM);
+    Common::mDeckNum = mCommonConfigInfo->mDeckNum.value_or(DefaultDeckNum(Common::mPlayerNum));
+    Common::mInitHandCardsNum = mCommonConfigInfo->mInitHandCardsNum.value_or(DEFAULT_INIT_HAND_CARDS_NUM);
+    // checked on the merged values, since each of them may come from either the file or the command line;
+    // the shoe must have enough cards to deal and to flip the first card
+    if (Common::mDeckNum < 1 || Common::mInitHandCardsNum < 1) {
+        throw std::runtime_error("the number of decks and the initial hand size must be positive");
+    }
+    if (Common::mPlayerNum * Common::mInitHandCardsNum >= Common::mDeckNum * CARDS_NUM_PER_DECK) {
+        throw std::runtime_error("not enough cards in " + std::to_string(Common::mDeckNum) + " decks to deal "
+            + std::to_string(Common::mInitHandCardsNum) + " cards to " + std::to_string(Common::mPlayerNum) + " players");
+    }
+    // the initial hand and the usernames of the table are sent in one message
+    if (Game::GameStartInfo::MaxSize(Common::mPlayerNum, Common::mInitHandCardsNum) > Common::MAX_MSG_SIZE) {
+        throw std::runtime_error("the initial hands of " + std::to_string(Common::mInitHandCardsNum) + " cards for "
+            + std::to_string(Common::mPlayerNum) + " players do not fit in one message");
+    }
+    if (mGameConfigInfo->mUsername.size() > Common::MAX_USERNAME_LEN) {
+        throw std::runtime_error("the username must not be longer than "
+            + std::to_string(Common::MAX_USERNAME_LEN) + " characters");
+    }
     Common::mTimeoutPerTurn = 15;
     Common::mHandCardsNumPerRow = 8;
     
@@ -274,6 +346,9 @@ void Config::SetUpCommonConfig()
         Common::mGameMode = Common::mEnableCharacterSystem ? 
             Common::GameMode::WITH_CHARACTERS : Common::GameMode::CLASSIC;
     }
+    // the server builds its table from the game config, so it must see the merged mode as well
+    mGameConfigInfo->mGameMode = Common::mGameMode;
+    mGameConfigInfo->mEnableCharacters = Common::mEnableCharacterSystem;
     
     // 设置颜色转义序列
     auto redIter = Common::mEscapeMap.find(mCommonConfigInfo->mRedEscape.value_or("red"));
@@ -18,6 +18,10 @@ struct GameConfigInfo {
     std::string mPort;
     std::string mUsername;
     std::string mLogPath{"logs/uno.log"};
+    // empty if the table is not journaled
+    std::string mJournalPath;
+    // empty if metrics are not dumped
+    std::string mMetricsPath;
     
     // 新增：角色系统配置
     bool mEnableCharacters{true};
@@ -30,6 +34,8 @@ struct GameConfigInfo {
  */
 struct CommonConfigInfo {
     std::optional<int> mPlayerNum;
+    std::optional<int> mDeckNum;
+    std::optional<int> mInitHandCardsNum;
     std::optional<std::string> mRedEscape;
     std::optional<std::string> mYellowEscape;
     std::optional<std::string> mGreenEscape;
@@ -70,10 +76,21 @@ private:
     /**
      * Initialize variables in \c Common::Common with config info just parsed
      * and those variables are what will be actually used in the game. 
+     * Throws if the shoe cannot deal the initial hands.
      */
     void SetUpCommonConfig();
 
+    /**
+     * One standard deck for every 8 players, so that big tables do not keep reshuffling.
+     */
+    static int DefaultDeckNum(int playerNum) { return (playerNum + 7) / 8; }
+
 private:
+    constexpr static int DEFAULT_PLAYER_NUM = 3;
+    constexpr static int DEFAULT_INIT_HAND_CARDS_NUM = 7;
+    // cards of the classic game in a deck, the custom cards come on top of them
+    constexpr static int CARDS_NUM_PER_DECK = 108;
+
     std::unique_ptr<cxxopts::Options> mOptions;
     std::unique_ptr<cxxopts::ParseResult> mCmdlineOpts;
     std::unique_ptr<YAML::Node> mServerNode;
@@ -99,6 +116,10 @@ private:
     const static std::string CMD_OPT_LONG_CFGFILE;
     const static std::string CMD_OPT_BOTH_CFGFILE;
     const static std::string CMD_OPT_LONG_LOGFILE;
+    const static std::string CMD_OPT_LONG_JOURNAL;
+    const static std::string CMD_OPT_LONG_METRICS;
+    const static std::string CMD_OPT_LONG_DECKS;
+    const static std::string CMD_OPT_LONG_HAND;
     const static std::string CMD_OPT_SHORT_VERSION;
     const static std::string CMD_OPT_LONG_VERSION;
     const static std::string CMD_OPT_BOTH_VERSION;
@@ -128,5 +149,7 @@ private:
     const static std::string FILE_OPT_GAME_MODE;
     const static std::string FILE_OPT_ENABLE_CHARACTERS;
     const static std::string FILE_OPT_MAX_SKILL_USES;
+    const static std::string FILE_OPT_DECKS;
+    const static std::string FILE_OPT_HAND;
 };
 }}
@@ -0,0 +1,182 @@
+#include <chrono>
+#include <ctime>
+
+#include "logger.h"
+
+namespace UNO { namespace Common {
+
+namespace {
+
+const char *LevelName(LogLevel level)
+{
+    switch (level) {
+        case LogLevel::TRACE: return "trace";
+        case LogLevel::DEBUG: return "debug";
+        case LogLevel::INFO:  return "info";
+        case LogLevel::WARN:  return "warn";
+        case LogLevel::ERROR: return "error";
+    }
+    return "";
+}
+
+void AppendArg(const LogArg &arg, std::string &out)
+{
+    switch (arg.mType) {
+        case LogArg::Type::INT:    out += std::to_string(arg.mInt); break;
+        case LogArg::Type::UINT:   out += std::to_string(arg.mUint); break;
+        case LogArg::Type::DOUBLE: out += std::to_string(arg.mDouble); break;
+        case LogArg::Type::BOOL:   out += arg.mBool ? "true" : "false"; break;
+        case LogArg::Type::TEXT:   out += arg.mText; break;
+    }
+}
+}
+
+Logger &Logger::Instance()
+{
+    static Logger logger;
+    return logger;
+}
+
+Logger::Logger()
+{
+    mDrainer = std::thread([this] { DrainLoop(); });
+}
+
+Logger::~Logger()
+{
+    mStop.store(true);
+    mDrainer.join();
+    Flush();
+    if (mSink != stdout) {
+        std::fclose(mSink);
+    }
+}
+
+bool Logger::Open(const std::string &path)
+{
+    std::FILE *file = std::fopen(path.c_str(), "a");
+    if (!file) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mDrainMutex);
+    if (mSink != stdout) {
+        std::fclose(mSink);
+    }
+    mSink = file;
+    return true;
+}
+
+uint64_t Logger::Now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+void Logger::Push(const LogRecord &record)
+{
+    Ring *ring = GetRing();
+    uint32_t tail = ring->mTail.load(std::memory_order_relaxed);
+    uint32_t head = ring->mHead.load(std::memory_order_acquire);
+    if (tail - head == Ring::CAPACITY) {
+        ring->mDropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    ring->mRecords[tail & (Ring::CAPACITY - 1)] = record;
+    ring->mTail.store(tail + 1, std::memory_order_release);
+}
+
+Logger::Ring *Logger::GetRing()
+{
+    thread_local RingHandle handle;
+    if (!handle.mRing) {
+        // only the first record of a thread takes the lock
+        auto ring = std::make_unique<Ring>();
+        handle.mRing = ring.get();
+        std::lock_guard<std::mutex> lock(mRingsMutex);
+        mRings.push_back(std::move(ring));
+    }
+    return handle.mRing;
+}
+
+void Logger::Flush()
+{
+    Drain();
+}
+
+void Logger::DrainLoop()
+{
+    while (!mStop.load()) {
+        if (Drain() == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(DRAIN_INTERVAL_MS));
+        }
+    }
+}
+
+int Logger::Drain()
+{
+    std::lock_guard<std::mutex> drainLock(mDrainMutex);
+    std::vector<Ring *> rings;
+    {
+        std::lock_guard<std::mutex> lock(mRingsMutex);
+        // rings of exited threads are released once they are drained
+        mRings.erase(std::remove_if(mRings.begin(), mRings.end(), [](const std::unique_ptr<Ring> &ring) {
+            return ring->mRetired.load(std::memory_order_acquire)
+                && ring->mHead.load() == ring->mTail.load() && ring->mDropped.load() == 0;
+        }), mRings.end());
+        for (const auto &ring : mRings) {
+            rings.push_back(ring.get());
+        }
+    }
+
+    int count = 0;
+    mBuffer.clear();
+    for (Ring *ring : rings) {
+        uint32_t head = ring->mHead.load(std::memory_order_relaxed);
+        uint32_t tail = ring->mTail.load(std::memory_order_acquire);
+        for (; head != tail; head++, count++) {
+            Format(ring->mRecords[head & (Ring::CAPACITY - 1)], mBuffer);
+        }
+        ring->mHead.store(head, std::memory_order_release);
+
+        uint64_t dropped = ring->mDropped.exchange(0, std::memory_order_relaxed);
+        if (dropped > 0) {
+            mBuffer += "[warn] " + std::to_string(dropped) + " log records dropped\n";
+        }
+    }
+
+    if (!mBuffer.empty()) {
+        std::fwrite(mBuffer.data(), 1, mBuffer.size(), mSink);
+        std::fflush(mSink);
+    }
+    return count;
+}
+
+void Logger::Format(const LogRecord &record, std::string &out) const
+{
+    std::time_t seconds = record.mTime / 1000000000;
+    std::tm tm;
+#if defined(_WIN32)
+    localtime_s(&tm, &seconds);
+#else
+    localtime_r(&seconds, &tm);
+#endif
+    char prefix[48];
+    std::size_t len = std::strftime(prefix, sizeof(prefix), "[%H:%M:%S", &tm);
+    std::snprintf(prefix + len, sizeof(prefix) - len, ".%06d] [%s] ",
+        static_cast<int>(record.mTime / 1000 % 1000000), LevelName(record.mLevel));
+    out += prefix;
+
+    int argIndex = 0;
+    for (const char *p = record.mFormat; *p; p++) {
+        if (p[0] == '{' && p[1] == '}' && argIndex < record.mArgNum) {
+            AppendArg(record.mArgs[argIndex++], out);
+            p++;
+        }
+        else {
+            out += *p;
+        }
+    }
+    out += '\n';
+}
+
+}}
@@ -0,0 +1,253 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Records of levels below UNO_LOG_LEVEL are compiled out, their arguments
+ * are not even evaluated. 0: TRACE, 1: DEBUG, 2: INFO, 3: WARN, 4: ERROR
+ */
+#ifndef UNO_LOG_LEVEL
+#define UNO_LOG_LEVEL 2
+#endif
+
+#define UNO_LOG(level, ...) \
+    do { \
+        if constexpr (static_cast<int>(level) >= UNO_LOG_LEVEL) { \
+            ::UNO::Common::Logger::Instance().Log(level, __VA_ARGS__); \
+        } \
+    } while (0)
+
+#define UNO_LOG_TRACE(...) UNO_LOG(::UNO::Common::LogLevel::TRACE, __VA_ARGS__)
+#define UNO_LOG_DEBUG(...) UNO_LOG(::UNO::Common::LogLevel::DEBUG, __VA_ARGS__)
+#define UNO_LOG_INFO(...)  UNO_LOG(::UNO::Common::LogLevel::INFO, __VA_ARGS__)
+#define UNO_LOG_WARN(...)  UNO_LOG(::UNO::Common::LogLevel::WARN, __VA_ARGS__)
+#define UNO_LOG_ERROR(...) UNO_LOG(::UNO::Common::LogLevel::ERROR, __VA_ARGS__)
+
+namespace UNO { namespace Common {
+
+enum class LogLevel : uint8_t {
+    TRACE,
+    DEBUG,
+    INFO,
+    WARN,
+    ERROR
+};
+
+/**
+ * One argument of a record, captured by value. Numbers are kept as they are,
+ * everything else is rendered into the inline buffer (truncated to 22 characters),
+ * so that a record never points to memory of the caller.
+ */
+struct LogArg {
+    enum class Type : uint8_t {
+        INT,
+        UINT,
+        DOUBLE,
+        BOOL,
+        TEXT
+    };
+
+    union {
+        int64_t mInt;
+        uint64_t mUint;
+        double mDouble;
+        bool mBool;
+        char mText[23];
+    };
+    Type mType;
+};
+static_assert(sizeof(LogArg) == 32, "log arguments must stay fixed-width");
+
+/**
+ * A record is the format string, which must be a string literal, and its arguments,
+ * formatting is deferred to the background thread.
+ */
+struct LogRecord {
+    constexpr static int MAX_ARGS = 4;
+
+    uint64_t mTime;  // nanoseconds since epoch
+    const char *mFormat;
+    LogLevel mLevel;
+    uint8_t mArgNum;
+    LogArg mArgs[MAX_ARGS];
+};
+
+/**
+ * Structured logger for hot paths. \c Log copies a fixed-size record into a
+ * lock-free ring owned by the calling thread and returns, a background thread
+ * drains all rings, formats the records and writes them out in batches.
+ * If a ring is full the record is dropped (and counted) rather than blocking the caller.
+ *
+ * The format string uses "{}" placeholders, like spdlog.
+ */
+class Logger {
+public:
+    static Logger &Instance();
+
+    ~Logger();
+
+    Logger(const Logger &) = delete;
+    Logger &operator=(const Logger &) = delete;
+
+    /**
+     * Write formatted records to \p path instead of stdout.
+     *   \return false if the file cannot be opened, and stdout is kept
+     */
+    bool Open(const std::string &path);
+
+    template <std::size_t N, typename... Args>
+    void Log(LogLevel level, const char (&format)[N], const Args &...args) {
+        static_assert(sizeof...(Args) <= LogRecord::MAX_ARGS, "too many arguments for a log record");
+        LogRecord record;
+        record.mTime = Now();
+        record.mFormat = format;
+        record.mLevel = level;
+        record.mArgNum = sizeof...(Args);
+        int i = 0;
+        (Capture(record.mArgs[i++], args), ...);
+        Push(record);
+    }
+
+    /**
+     * Block until every record logged by now has been written out.
+     */
+    void Flush();
+
+private:
+    /**
+     * Single-producer single-consumer ring, the producer is the owning thread
+     * and the consumer is the background thread.
+     */
+    struct Ring {
+        constexpr static uint32_t CAPACITY = 1024;  // must be a power of 2
+
+        LogRecord mRecords[CAPACITY];
+        std::atomic<uint32_t> mHead{0};  // next to read, written by the consumer
+        std::atomic<uint32_t> mTail{0};  // next to write, written by the producer
+        std::atomic<uint64_t> mDropped{0};
+        std::atomic<bool> mRetired{false};  // the owning thread has exited
+    };
+
+    /**
+     * Retire the ring of a thread when the thread exits.
+     */
+    struct RingHandle {
+        Ring *mRing{nullptr};
+        ~RingHandle() {
+            if (mRing) {
+                mRing->mRetired.store(true, std::memory_order_release);
+            }
+        }
+    };
+
+    /**
+     * Writes into a fixed buffer and silently drops what does not fit.
+     */
+    class FixedBuf : public std::streambuf {
+    public:
+        FixedBuf(char *buffer, std::size_t size) { setp(buffer, buffer + size); }
+
+        std::size_t Size() const { return pptr() - pbase(); }
+
+    protected:
+        int_type overflow(int_type ch) override { return traits_type::not_eof(ch); }
+    };
+
+    template <typename T, typename = void>
+    struct IsStreamable : std::false_type {};
+
+    template <typename T>
+    struct IsStreamable<T, std::void_t<decltype(std::declval<std::ostream &>() << std::declval<const T &>())>>
+        : std::true_type {};
+
+private:
+    Logger();
+
+    static uint64_t Now();
+
+    void Push(const LogRecord &record);
+
+    Ring *GetRing();
+
+    void DrainLoop();
+
+    /**
+     * Move out all pending records of all rings to the sink.
+     *   \return number of records written out
+     */
+    int Drain();
+
+    void Format(const LogRecord &record, std::string &out) const;
+
+    template <typename T>
+    static void Capture(LogArg &arg, const T &value) {
+        if constexpr (std::is_same<T, bool>::value) {
+            arg.mType = LogArg::Type::BOOL;
+            arg.mBool = value;
+        }
+        else if constexpr (std::is_integral<T>::value && std::is_signed<T>::value) {
+            arg.mType = LogArg::Type::INT;
+            arg.mInt = value;
+        }
+        else if constexpr (std::is_integral<T>::value) {
+            arg.mType = LogArg::Type::UINT;
+            arg.mUint = value;
+        }
+        else if constexpr (std::is_floating_point<T>::value) {
+            arg.mType = LogArg::Type::DOUBLE;
+            arg.mDouble = value;
+        }
+        else if constexpr (std::is_convertible<const T &, const char *>::value) {
+            CaptureText(arg, value, std::strlen(value));
+        }
+        else if constexpr (std::is_same<T, std::string>::value) {
+            CaptureText(arg, value.data(), value.size());
+        }
+        else if constexpr (std::is_enum<T>::value && !IsStreamable<T>::value) {
+            arg.mType = LogArg::Type::INT;
+            arg.mInt = static_cast<int64_t>(value);
+        }
+        else {
+            // anything streamable, e.g. cards and colors
+            arg.mType = LogArg::Type::TEXT;
+            FixedBuf buf(arg.mText, sizeof(arg.mText) - 1);
+            std::ostream os(&buf);
+            os << value;
+            arg.mText[buf.Size()] = '\0';
+        }
+    }
+
+    static void CaptureText(LogArg &arg, const char *text, std::size_t len) {
+        arg.mType = LogArg::Type::TEXT;
+        len = std::min(len, sizeof(arg.mText) - 1);
+        std::memcpy(arg.mText, text, len);
+        arg.mText[len] = '\0';
+    }
+
+private:
+    constexpr static int DRAIN_INTERVAL_MS = 5;
+
+    std::mutex mRingsMutex;
+    std::vector<std::unique_ptr<Ring>> mRings;
+
+    // only one drain at a time, which is the single consumer of the rings
+    std::mutex mDrainMutex;
+    std::FILE *mSink{stdout};
+    std::string mBuffer;
+
+    std::atomic<bool> mStop{false};
+    std::thread mDrainer;
+};
+}}
@@ -0,0 +1,252 @@
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+#include "metrics.h"
+
+namespace UNO { namespace Common {
+
+namespace {
+
+int HighestBit(uint64_t value)
+{
+    int bit = 0;
+    while (value >>= 1) {
+        bit++;
+    }
+    return bit;
+}
+
+/**
+ * Split "name{labels}" into "name" and "labels".
+ */
+void SplitName(const std::string &fullName, std::string &name, std::string &labels)
+{
+    auto pos = fullName.find('{');
+    if (pos == std::string::npos) {
+        name = fullName;
+        labels.clear();
+    }
+    else {
+        name = fullName.substr(0, pos);
+        labels = fullName.substr(pos + 1, fullName.size() - pos - 2);
+    }
+}
+
+std::string WithLabels(const std::string &name, const std::string &labels, const std::string &extra = "")
+{
+    if (labels.empty() && extra.empty()) {
+        return name;
+    }
+    if (labels.empty() || extra.empty()) {
+        return name + "{" + labels + extra + "}";
+    }
+    return name + "{" + labels + "," + extra + "}";
+}
+}
+
+int Metrics::ShardOfThisThread()
+{
+    static std::atomic<int> nextShard{0};
+    thread_local int shard = nextShard.fetch_add(1, std::memory_order_relaxed) % MAX_SHARDS;
+    return shard;
+}
+
+Counter::Counter(int shardNum)
+    : mShardNum(shardNum), mShards(std::make_unique<CounterShard[]>(shardNum))
+{}
+
+uint64_t Counter::Get() const
+{
+    uint64_t sum = 0;
+    for (int i = 0; i < mShardNum; i++) {
+        sum += mShards[i].mValue.load(std::memory_order_relaxed);
+    }
+    return sum;
+}
+
+Histogram::Histogram(int shardNum)
+    : mShardNum(shardNum), mShards(std::make_unique<HistogramShard[]>(shardNum))
+{}
+
+int Histogram::BucketOf(uint64_t value)
+{
+    value = std::min(value, (uint64_t(1) << MAX_VALUE_BITS) - 1);
+    if (value < (uint64_t(1) << SUB_BUCKET_BITS)) {
+        return value;
+    }
+    int shift = HighestBit(value) - SUB_BUCKET_BITS + 1;
+    return shift * HALF_SUB_BUCKET_NUM + (value >> shift);
+}
+
+uint64_t Histogram::LowerBoundOf(int bucket)
+{
+    if (bucket < (1 << SUB_BUCKET_BITS)) {
+        return bucket;
+    }
+    int shift = bucket / HALF_SUB_BUCKET_NUM - 1;
+    uint64_t subBucket = bucket % HALF_SUB_BUCKET_NUM + HALF_SUB_BUCKET_NUM;
+    return subBucket << shift;
+}
+
+void Histogram::Record(uint64_t value)
+{
+    auto &shard = mShards[Shard()];
+    shard.mBuckets[BucketOf(value)].fetch_add(1, std::memory_order_relaxed);
+    shard.mSum.fetch_add(value, std::memory_order_relaxed);
+    uint64_t max = shard.mMax.load(std::memory_order_relaxed);
+    while (value > max && !shard.mMax.compare_exchange_weak(max, value, std::memory_order_relaxed)) {}
+}
+
+Histogram::Summary Histogram::Summarize() const
+{
+    Summary summary{};
+    std::vector<uint64_t> buckets(BUCKET_NUM, 0);
+    for (int i = 0; i < mShardNum; i++) {
+        for (int bucket = 0; bucket < BUCKET_NUM; bucket++) {
+            buckets[bucket] += mShards[i].mBuckets[bucket].load(std::memory_order_relaxed);
+        }
+        summary.mSum += mShards[i].mSum.load(std::memory_order_relaxed);
+        summary.mMax = std::max(summary.mMax, mShards[i].mMax.load(std::memory_order_relaxed));
+    }
+    for (auto count : buckets) {
+        summary.mCount += count;
+    }
+
+    // a quantile is reported as the upper bound of the bucket it falls in
+    auto quantile = [&buckets, &summary](double q) -> uint64_t {
+        uint64_t rank = static_cast<uint64_t>(q * summary.mCount);
+        uint64_t seen = 0;
+        for (int bucket = 0; bucket < BUCKET_NUM; bucket++) {
+            seen += buckets[bucket];
+            if (seen > rank) {
+                return std::min(LowerBoundOf(bucket + 1) - 1, summary.mMax);
+            }
+        }
+        return summary.mMax;
+    };
+    if (summary.mCount > 0) {
+        summary.mP50 = quantile(0.5);
+        summary.mP90 = quantile(0.9);
+        summary.mP99 = quantile(0.99);
+        summary.mP999 = quantile(0.999);
+    }
+    return summary;
+}
+
+MetricsRegistry &MetricsRegistry::Instance()
+{
+    static MetricsRegistry registry;
+    return registry;
+}
+
+MetricsRegistry::~MetricsRegistry()
+{
+    {
+        std::lock_guard<std::mutex> lock(mDumpMutex);
+        mStopDump = true;
+    }
+    mDumpCv.notify_one();
+    if (mDumper.joinable()) {
+        mDumper.join();
+    }
+}
+
+Counter &MetricsRegistry::GetCounter(const std::string &name, int shardNum)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto &counter = mCounters[name];
+    if (!counter) {
+        counter = std::make_unique<Counter>(shardNum);
+    }
+    return *counter;
+}
+
+Histogram &MetricsRegistry::GetHistogram(const std::string &name, int shardNum)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto &histogram = mHistograms[name];
+    if (!histogram) {
+        histogram = std::make_unique<Histogram>(shardNum);
+    }
+    return *histogram;
+}
+
+void MetricsRegistry::RemoveLabeled(const std::string &label)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    for (auto it = mCounters.begin(); it != mCounters.end(); ) {
+        it = (it->first.find(label) != std::string::npos) ? mCounters.erase(it) : std::next(it);
+    }
+    for (auto it = mHistograms.begin(); it != mHistograms.end(); ) {
+        it = (it->first.find(label) != std::string::npos) ? mHistograms.erase(it) : std::next(it);
+    }
+}
+
+void MetricsRegistry::Write(std::ostream &os) const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    std::string name, labels, lastName;
+    for (const auto &[fullName, counter] : mCounters) {
+        SplitName(fullName, name, labels);
+        if (name != lastName) {
+            os << "# TYPE " << name << " counter\n";
+            lastName = name;
+        }
+        os << fullName << " " << counter->Get() << "\n";
+    }
+    // a summary has no _max sample, so the maxima form a gauge family of their own,
+    // written after the summaries as the samples of a family must stay together
+    std::vector<std::pair<std::string, uint64_t>> maxima;
+    maxima.reserve(mHistograms.size());
+    for (const auto &[fullName, histogram] : mHistograms) {
+        SplitName(fullName, name, labels);
+        if (name != lastName) {
+            os << "# TYPE " << name << " summary\n";
+            lastName = name;
+        }
+        auto summary = histogram->Summarize();
+        os << WithLabels(name, labels, "quantile=\"0.5\"") << " " << summary.mP50 << "\n"
+           << WithLabels(name, labels, "quantile=\"0.9\"") << " " << summary.mP90 << "\n"
+           << WithLabels(name, labels, "quantile=\"0.99\"") << " " << summary.mP99 << "\n"
+           << WithLabels(name, labels, "quantile=\"0.999\"") << " " << summary.mP999 << "\n"
+           << WithLabels(name + "_sum", labels) << " " << summary.mSum << "\n"
+           << WithLabels(name + "_count", labels) << " " << summary.mCount << "\n";
+        maxima.emplace_back(fullName, summary.mMax);
+    }
+    lastName.clear();
+    for (const auto &[fullName, max] : maxima) {
+        SplitName(fullName, name, labels);
+        if (name != lastName) {
+            os << "# TYPE " << name << "_max gauge\n";
+            lastName = name;
+        }
+        os << WithLabels(name + "_max", labels) << " " << max << "\n";
+    }
+}
+
+void MetricsRegistry::StartPeriodicDump(const std::string &path, std::chrono::seconds interval)
+{
+    std::lock_guard<std::mutex> lock(mDumpMutex);
+    if (!mDumper.joinable()) {
+        mDumper = std::thread([this, path, interval] { DumpLoop(path, interval); });
+    }
+}
+
+void MetricsRegistry::DumpLoop(std::string path, std::chrono::seconds interval)
+{
+    std::unique_lock<std::mutex> lock(mDumpMutex);
+    while (!mDumpCv.wait_for(lock, interval, [this] { return mStopDump; })) {
+        lock.unlock();
+        std::string tmpPath = path + ".tmp";
+        {
+            std::ofstream file(tmpPath, std::ios::trunc);
+            Write(file);
+        }
+        std::rename(tmpPath.c_str(), path.c_str());
+        lock.lock();
+    }
+}
+
+}}
@@ -0,0 +1,168 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+
+namespace UNO { namespace Common {
+
+namespace Metrics {
+    // counters and histograms are split into shards so that threads on
+    // different cores do not contend for the same cache line
+    constexpr int MAX_SHARDS = 16;
+
+    /**
+     * Shard of the calling thread, threads are spread over the shards round robin.
+     */
+    int ShardOfThisThread();
+
+    inline uint64_t NowMicros() {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+}
+
+/**
+ * Monotonic counter, lock-free on the recording side.
+ */
+class Counter {
+public:
+    explicit Counter(int shardNum = Metrics::MAX_SHARDS);
+
+    void Add(uint64_t n = 1) {
+        mShards[Shard()].mValue.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    uint64_t Get() const;
+
+private:
+    int Shard() const { return mShardNum == 1 ? 0 : Metrics::ShardOfThisThread() % mShardNum; }
+
+private:
+    struct alignas(64) CounterShard {
+        std::atomic<uint64_t> mValue{0};
+    };
+
+    const int mShardNum;
+    std::unique_ptr<CounterShard[]> mShards;
+};
+
+/**
+ * HDR-style histogram of non-negative integers: values below 32 are exact, above
+ * that every power of 2 is split into 16 linear sub-buckets, so any recorded
+ * value is reported within about 6% of itself. Recording is a couple of shifts
+ * and a relaxed atomic increment.
+ */
+class Histogram {
+public:
+    struct Summary {
+        uint64_t mCount;
+        uint64_t mSum;
+        uint64_t mMax;
+        uint64_t mP50;
+        uint64_t mP90;
+        uint64_t mP99;
+        uint64_t mP999;
+    };
+
+    explicit Histogram(int shardNum = Metrics::MAX_SHARDS);
+
+    void Record(uint64_t value);
+
+    Summary Summarize() const;
+
+    static int BucketOf(uint64_t value);
+
+    static uint64_t LowerBoundOf(int bucket);
+
+public:
+    constexpr static int SUB_BUCKET_BITS = 5;
+    constexpr static int HALF_SUB_BUCKET_NUM = 1 << (SUB_BUCKET_BITS - 1);
+    // larger values are clamped, e.g. about 12 days in microseconds
+    constexpr static int MAX_VALUE_BITS = 40;
+    constexpr static int BUCKET_NUM = (MAX_VALUE_BITS - SUB_BUCKET_BITS + 2) * HALF_SUB_BUCKET_NUM;
+
+private:
+    int Shard() const { return mShardNum == 1 ? 0 : Metrics::ShardOfThisThread() % mShardNum; }
+
+private:
+    struct alignas(64) HistogramShard {
+        std::atomic<uint64_t> mBuckets[BUCKET_NUM];
+        std::atomic<uint64_t> mSum{0};
+        std::atomic<uint64_t> mMax{0};
+
+        HistogramShard() {
+            for (auto &bucket : mBuckets) {
+                bucket.store(0, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    const int mShardNum;
+    std::unique_ptr<HistogramShard[]> mShards;
+};
+
+/**
+ * Process-wide set of named metrics. A name may carry Prometheus labels,
+ * e.g. uno_messages_in_total{type="ACTION"}, and the whole set can be written
+ * in the Prometheus text format, on demand or periodically into a file.
+ *
+ * References returned by \c GetCounter and \c GetHistogram stay valid until the
+ * metric is removed, so callers look them up once and keep them.
+ */
+class MetricsRegistry {
+public:
+    static MetricsRegistry &Instance();
+
+    ~MetricsRegistry();
+
+    MetricsRegistry(const MetricsRegistry &) = delete;
+    MetricsRegistry &operator=(const MetricsRegistry &) = delete;
+
+    /**
+     * Get the counter of \p name, create it if it does not exist.
+     *   \param shardNum: 1 for metrics recorded by one thread only, like those of a table
+     */
+    Counter &GetCounter(const std::string &name, int shardNum = Metrics::MAX_SHARDS);
+
+    Histogram &GetHistogram(const std::string &name, int shardNum = Metrics::MAX_SHARDS);
+
+    /**
+     * Remove all metrics carrying \p label, e.g. table="3" when the table goes away.
+     */
+    void RemoveLabeled(const std::string &label);
+
+    /**
+     * Write all metrics in the Prometheus text format.
+     */
+    void Write(std::ostream &os) const;
+
+    /**
+     * Write all metrics to \p path every \p interval from a background thread,
+     * the file is replaced atomically so that a scraper never reads a partial one.
+     */
+    void StartPeriodicDump(const std::string &path, std::chrono::seconds interval);
+
+private:
+    MetricsRegistry() = default;
+
+    void DumpLoop(std::string path, std::chrono::seconds interval);
+
+private:
+    mutable std::mutex mMutex;
+    std::map<std::string, std::unique_ptr<Counter>> mCounters;
+    std::map<std::string, std::unique_ptr<Histogram>> mHistograms;
+
+    std::mutex mDumpMutex;
+    std::condition_variable mDumpCv;
+    bool mStopDump{false};
+    std::thread mDumper;
+};
+}}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <random>
+
+namespace UNO { namespace Common {
+
+/**
+ * A mt19937 which remembers its seed and how many numbers have been drawn from it,
+ * so that its whole state can be saved in a few bytes and restored exactly,
+ * instead of the 624 words of the engine itself.
+ */
+class Random {
+public:
+    using result_type = std::mt19937::result_type;
+
+    explicit Random(uint32_t seed = std::random_device{}())
+        : mSeed(seed), mEngine(seed) {}
+
+    constexpr static result_type min() { return std::mt19937::min(); }
+
+    constexpr static result_type max() { return std::mt19937::max(); }
+
+    result_type operator()() {
+        mDraws++;
+        return mEngine();
+    }
+
+    uint32_t GetSeed() const { return mSeed; }
+
+    uint64_t GetDraws() const { return mDraws; }
+
+    /**
+     * Bring the engine back to the state after \p draws numbers have been drawn with \p seed.
+     */
+    void Restore(uint32_t seed, uint64_t draws) {
+        mSeed = seed;
+        mDraws = draws;
+        mEngine.seed(seed);
+        mEngine.discard(draws);
+    }
+
+private:
+    uint32_t mSeed;
+    uint64_t mDraws{0};
+    std::mt19937 mEngine;
+};
+}}
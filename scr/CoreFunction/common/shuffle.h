@@ -0,0 +1,109 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+
+namespace UNO { namespace Common {
+
+/**
+ * Fast generator for shuffling, one per table. It runs LANES independent xoshiro128++
+ * streams side by side and refills a buffer of BUFFER_SIZE words at a time, which the
+ * compiler turns into SIMD code without any intrinsics. Every step is plain 32/64-bit
+ * integer arithmetic, so a seed gives the same words on every platform and compiler,
+ * unlike std::uniform_int_distribution whose algorithm is up to the standard library.
+ */
+class ShuffleRng {
+public:
+    constexpr static int LANES = 8;
+    constexpr static int BUFFER_SIZE = 8 * LANES;
+
+    explicit ShuffleRng(uint64_t seed = 0) { Seed(seed); }
+
+    void Seed(uint64_t seed) {
+        // expand the seed with splitmix64, which never leaves a lane all zero in practice
+        for (int lane = 0; lane < LANES; lane++) {
+            for (auto &word : mState) {
+                seed += 0x9e3779b97f4a7c15ULL;
+                uint64_t z = seed;
+                z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+                z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+                word[lane] = static_cast<uint32_t>((z ^ (z >> 31)) >> 32);
+            }
+        }
+        mNext = BUFFER_SIZE;
+    }
+
+    uint32_t Next() {
+        if (mNext == BUFFER_SIZE) {
+            Refill();
+        }
+        return mBuffer[mNext++];
+    }
+
+    /**
+     * Uniform in [0, range), by Lemire's multiply-and-shift with rejection, so
+     * nearly every call costs one multiplication and no division. range must not be 0.
+     */
+    uint32_t Bounded(uint32_t range) {
+        uint64_t product = static_cast<uint64_t>(Next()) * range;
+        uint32_t low = static_cast<uint32_t>(product);
+        if (low < range) {
+            uint32_t threshold = (0u - range) % range;
+            while (low < threshold) {
+                product = static_cast<uint64_t>(Next()) * range;
+                low = static_cast<uint32_t>(product);
+            }
+        }
+        return static_cast<uint32_t>(product >> 32);
+    }
+
+private:
+    static uint32_t Rotl(uint32_t x, int k) { return (x << k) | (x >> (32 - k)); }
+
+    void Refill() {
+        auto &[s0, s1, s2, s3] = mState;
+        for (int i = 0; i < BUFFER_SIZE; i += LANES) {
+            // the lanes are independent, so this loop is vectorized
+            for (int lane = 0; lane < LANES; lane++) {
+                mBuffer[i + lane] = Rotl(s0[lane] + s3[lane], 7) + s0[lane];
+                uint32_t t = s1[lane] << 9;
+                s2[lane] ^= s0[lane];
+                s3[lane] ^= s1[lane];
+                s1[lane] ^= s2[lane];
+                s0[lane] ^= s3[lane];
+                s2[lane] ^= t;
+                s3[lane] = Rotl(s3[lane], 11);
+            }
+        }
+        mNext = 0;
+    }
+
+private:
+    // state word k of every lane, lanes adjacent so that a step is one vector operation
+    std::array<std::array<uint32_t, LANES>, 4> mState;
+    std::array<uint32_t, BUFFER_SIZE> mBuffer;
+    int mNext;
+};
+
+/**
+ * Fisher-Yates from the back: for every n from \p from down to \p to + 1, swap the
+ * element at n - 1 with a uniform one in [0, n). The steps take their words from
+ * \p rng strictly in order, so shuffling [to, from) in one call or in pieces from
+ * the back gives the same order, which lets a pile shuffle lazily card by card.
+ * A full shuffle is ShuffleTail(data, data.size(), 0, rng).
+ */
+template <typename T, std::size_t Extent>
+void ShuffleTail(std::span<T, Extent> data, std::size_t from, std::size_t to, ShuffleRng &rng) {
+    for (std::size_t n = from; n > to; n--) {
+        std::swap(data[n - 1], data[rng.Bounded(static_cast<uint32_t>(n))]);
+    }
+}
+
+template <typename T, std::size_t Extent>
+void Shuffle(std::span<T, Extent> data, ShuffleRng &rng) {
+    ShuffleTail(data, data.size(), 0, rng);
+}
+}}
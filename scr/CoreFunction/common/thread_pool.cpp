@@ -0,0 +1,120 @@
+#include <algorithm>
+
+#include "thread_pool.h"
+
+namespace UNO { namespace Common {
+
+namespace {
+// the pool the current thread works for and its queue, if any
+thread_local const ThreadPool *currentPool = nullptr;
+thread_local int currentQueue = -1;
+}
+
+ThreadPool::ThreadPool(int threadNum)
+{
+    threadNum = std::max(threadNum, 1);
+    for (int i = 0; i < threadNum; i++) {
+        mQueues.push_back(std::make_unique<WorkQueue>());
+    }
+    for (int i = 0; i < threadNum; i++) {
+        mWorkers.emplace_back([this, i] { WorkLoop(i); });
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStop = true;
+    }
+    mWorkCv.notify_all();
+    for (auto &worker : mWorkers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::Submit(std::function<void()> task)
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+    int index = (currentPool == this) ? currentQueue : (mNextQueue++ % mQueues.size());
+    {
+        std::lock_guard<std::mutex> queueLock(mQueues[index]->mMutex);
+        mQueues[index]->mTasks.push_back(std::move(task));
+    }
+    mQueuedNum++;
+    mPendingNum++;
+    lock.unlock();
+    mWorkCv.notify_one();
+}
+
+void ThreadPool::Wait()
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+    mDoneCv.wait(lock, [this] { return mPendingNum == 0; });
+    if (mError) {
+        auto error = mError;
+        mError = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+void ThreadPool::WorkLoop(int index)
+{
+    currentPool = this;
+    currentQueue = index;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mWorkCv.wait(lock, [this] { return mStop || mQueuedNum > 0; });
+            if (mQueuedNum == 0) {
+                return;
+            }
+            // claim a task, which is then guaranteed to be in one of the queues
+            mQueuedNum--;
+        }
+
+        std::function<void()> task;
+        while (!TryPop(index, task)) {
+            std::this_thread::yield();
+        }
+        try {
+            task();
+        }
+        catch (...) {
+            std::lock_guard<std::mutex> lock(mMutex);
+            if (!mError) {
+                mError = std::current_exception();
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (--mPendingNum == 0) {
+            mDoneCv.notify_all();
+        }
+    }
+}
+
+bool ThreadPool::TryPop(int index, std::function<void()> &task)
+{
+    {
+        auto &own = *mQueues[index];
+        std::lock_guard<std::mutex> lock(own.mMutex);
+        if (!own.mTasks.empty()) {
+            task = std::move(own.mTasks.back());
+            own.mTasks.pop_back();
+            return true;
+        }
+    }
+    for (std::size_t i = 1; i < mQueues.size(); i++) {
+        auto &other = *mQueues[(index + i) % mQueues.size()];
+        std::lock_guard<std::mutex> lock(other.mMutex);
+        if (!other.mTasks.empty()) {
+            task = std::move(other.mTasks.front());
+            other.mTasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+}}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace UNO { namespace Common {
+
+/**
+ * Fixed set of worker threads with a task queue each. A worker takes the newest
+ * task of its own queue first and steals the oldest of another queue when its
+ * own is empty, so a long task on one worker does not hold up the tasks queued behind it.
+ */
+class ThreadPool {
+public:
+    explicit ThreadPool(int threadNum = std::thread::hardware_concurrency());
+
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    /**
+     * Queue \p task. Tasks submitted by a worker go to its own queue,
+     * others are spread over the queues round robin.
+     */
+    void Submit(std::function<void()> task);
+
+    /**
+     * Block until all submitted tasks have finished.
+     * Rethrows the first exception a task has thrown since the last call, if any.
+     */
+    void Wait();
+
+    int GetThreadNum() const { return static_cast<int>(mWorkers.size()); }
+
+private:
+    struct alignas(64) WorkQueue {
+        std::mutex mMutex;
+        std::deque<std::function<void()>> mTasks;
+    };
+
+    void WorkLoop(int index);
+
+    /**
+     * Take a task from the own queue, or steal one from another.
+     */
+    bool TryPop(int index, std::function<void()> &task);
+
+private:
+    std::vector<std::unique_ptr<WorkQueue>> mQueues;
+    std::vector<std::thread> mWorkers;
+
+    std::mutex mMutex;
+    std::condition_variable mWorkCv;
+    std::condition_variable mDoneCv;
+    // tasks in the queues not yet taken by a worker
+    int mQueuedNum{0};
+    // tasks submitted but not finished
+    int mPendingNum{0};
+    unsigned mNextQueue{0};
+    bool mStop{false};
+    std::exception_ptr mError;
+};
+}}
@@ -1,22 +1,93 @@
-#include <ctime>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <atomic>
 #include <algorithm>
-#include <iostream>
+#include <array>
+#include <ranges>
 
 #include "game_board.h"
+#include "../common/logger.h"
+#include "../common/config.h"
+#include "../common/shuffle.h"
 
 namespace UNO { namespace Game {
 
-GameBoard::GameBoard(std::shared_ptr<Network::IServer> serverSp)
+namespace {
+std::atomic<int> nextTableId{0};
+}
+
+GameBoard::TableMetrics::TableMetrics(int tableId)
+    : mTableLabel("table=\"" + std::to_string(tableId) + "\"")
+{
+    auto &registry = Common::MetricsRegistry::Instance();
+    const char *phaseNames[] = {"START", "SKILL", "CARD_PLAY", "END"};
+    for (int phase = 0; phase < 4; phase++) {
+        mPhaseDuration[phase] = &registry.GetHistogram(
+            std::string("uno_turn_phase_us{phase=\"") + phaseNames[phase] + "\"}");
+    }
+    mClientWait = &registry.GetHistogram("uno_client_wait_us");
+    mProcessing = &registry.GetHistogram("uno_turn_processing_us");
+    mDrawStackSize = &registry.GetHistogram("uno_draw_stack_size");
+    mReshuffles = &registry.GetCounter("uno_deck_reshuffles_total");
+    for (int type = 0; type < 4; type++) {
+        mSkillActivations[type] = &registry.GetCounter("uno_skill_activations_total{character=\""
+            + CharacterFactory::GetCharacterName(static_cast<CharacterType>(type)) + "\"}");
+    }
+
+    // a table is driven by one coroutine at a time, so its own metrics need no shards
+    mTurns = &registry.GetCounter("uno_table_turns_total{" + mTableLabel + "}", 1);
+    mTableClientWait = &registry.GetHistogram("uno_table_client_wait_us{" + mTableLabel + "}", 1);
+}
+
+GameBoard::TableMetrics::~TableMetrics()
+{
+    Common::MetricsRegistry::Instance().RemoveLabeled(mTableLabel);
+}
+
+GameBoard::GameBoard(std::shared_ptr<Network::IServer> serverSp, Common::Common::GameMode mode)
     : mServer(serverSp), 
-    mDiscardPile(std::make_unique<DiscardPile>()),
-    mDeck(std::make_unique<Deck>(*mDiscardPile))
+    mMode(mode),
+    mPlayerNum(Common::Common::mPlayerNum),
+    mDiscardPile(std::make_unique<IndexedDiscardPile>()),
+    mDeck(std::make_unique<Deck>(mDiscardPile->RefillSource())),
+    mMetrics(nextTableId++)
 {
+    switch (mMode) {
+        case Common::Common::GameMode::CLASSIC:
+            UseRules<ClassicRules>();
+            break;
+        case Common::Common::GameMode::WITH_CHARACTERS:
+            UseRules<CharacterRules>();
+            break;
+        case Common::Common::GameMode::CUSTOM:
+            UseRules<CustomRules>();
+            break;
+    }
+
     mServer->RegisterReceiveJoinGameInfoCallback(
         [this](int index, const JoinGameInfo &info) {
             ReceiveUsername(index, info.mUsername);
         }
     );
-    mServer->RegisterAllPlayersJoinedCallback([this] { StartGame(); });
+    mServer->RegisterAllPlayersJoinedCallback([this] {
+        if (mIsRestored) {
+            ResumeGame();
+        }
+        else {
+            StartGame();
+        }
+    });
+}
+
+GameBoard::~GameBoard() = default;
+
+template <typename Rules>
+void GameBoard::UseRules()
+{
+    mPlayTurn = &GameBoard::PlayTurn<Rules>;
+    // a custom table may still have the character system switched off
+    mAssignsCharacters = Rules::HAS_CHARACTERS && Common::Common::mEnableCharacterSystem;
 }
 
 void GameBoard::Start()
@@ -29,6 +100,85 @@ std::shared_ptr<Network::IServer> GameBoard::CreateServer(const std::string &por
     return std::make_shared<Network::Server>(port);
 }
 
+void GameBoard::RunServer(const Common::GameConfigInfo &configInfo)
+{
+    if (!configInfo.mMetricsPath.empty()) {
+        Common::MetricsRegistry::Instance().StartPeriodicDump(configInfo.mMetricsPath,
+            std::chrono::seconds(METRICS_DUMP_SECONDS));
+    }
+    GameBoard gameBoard(CreateServer(configInfo.mPort), configInfo.mGameMode);
+    if (!configInfo.mJournalPath.empty()) {
+        // a table that crashed mid-game resumes from its journal, otherwise a new one is journaled
+        if (!gameBoard.Recover(configInfo.mJournalPath)) {
+            gameBoard.EnableJournal(configInfo.mJournalPath);
+        }
+    }
+    gameBoard.Start();
+}
+
+void GameBoard::EnableJournal(const std::string &path)
+{
+    mJournal = std::make_unique<Journal>(path);
+}
+
+bool GameBoard::Recover(const std::string &path)
+{
+    uint32_t snapshotSeq;
+    std::vector<uint8_t> image;
+    std::vector<JournalRecord> tail;
+    if (!Journal::Load(path, snapshotSeq, image, tail) || !DecodeTable(image.data(), image.size())) {
+        return false;
+    }
+
+    for (const auto &record : tail) {
+        Replay(record);
+    }
+    UNO_LOG_INFO("table recovered from {}, {} records replayed", path, tail.size());
+
+    uint32_t lastSeq = tail.empty() ? snapshotSeq : tail.back().mSeq;
+    mJournal = std::make_unique<Journal>(path, lastSeq + 1);
+    // continue from a snapshot of the recovered state, so the old tail is not replayed twice
+    mJournal->Snapshot(TakeSnapshot());
+    mIsRestored = true;
+    return true;
+}
+
+void GameBoard::DumpTable(const std::string &path) const
+{
+    std::vector<uint8_t> image;
+    EncodeTable(image);
+
+    // write aside and rename, so that the new host never maps a partial image
+    std::string tmpPath = path + ".tmp";
+    std::FILE *file = std::fopen(tmpPath.c_str(), "wb");
+    if (!file) {
+        throw std::runtime_error("cannot open table image: " + tmpPath);
+    }
+    std::fwrite(image.data(), 1, image.size(), file);
+    std::fclose(file);
+    std::rename(tmpPath.c_str(), path.c_str());
+}
+
+bool GameBoard::RestoreTable(const std::string &path)
+{
+    MappedFile file(path);
+    if (!file.IsOpen() || !DecodeTable(file.GetData(), file.GetSize())) {
+        return false;
+    }
+    UNO_LOG_INFO("table restored from {}", path);
+    if (mJournal) {
+        mJournal->Snapshot(TakeSnapshot());
+    }
+    mIsRestored = true;
+    return true;
+}
+
+void GameBoard::RequestMigration(const std::string &path)
+{
+    std::lock_guard<std::mutex> lock(mMigrationMutex);
+    mMigrationPath = path;
+}
+
 void GameBoard::ResetGame()
 {
     mServer->Reset();
@@ -41,17 +191,28 @@ void GameBoard::ResetGame()
     mPackagePlayerIndex = -1;
 }
 
-void GameBoard::ReceiveUsername(int index, const std::string &username)
+void GameBoard::ReceiveUsername(int index, const std::string &fullUsername)
 {
-    std::cout << "receive, index: " << index << ", username: " << username << std::endl;
-    mPlayerStats.emplace_back(username, 7);
+    // clients cut their names to the length Config allows, this guards the GameStartMsg
+    // of the table against any other client
+    std::string username = fullUsername.substr(0, Common::Common::MAX_USERNAME_LEN);
+    UNO_LOG_INFO("receive, index: {}, username: {}", index, username);
+    if (mIsRestored) {
+        // players reattach to the seats of the restored table in the original order
+        if (index >= mPlayerStats.size() || mPlayerStats[index].GetUsername() != username) {
+            UNO_LOG_WARN("player {} does not belong to seat {}", username, index);
+        }
+    }
+    else {
+        mPlayerStats.emplace_back(username, Common::Common::mInitHandCardsNum);
+    }
     std::vector<std::string> tmpUsernames;
     std::for_each(mPlayerStats.begin(), mPlayerStats.end(),
         [&tmpUsernames](const PlayerStat &stat) {
             tmpUsernames.push_back(stat.GetUsername());
         }
     );
-    Common::Util::Deliver<JoinGameRspInfo>(mServer, index, Common::Common::mPlayerNum, tmpUsernames);
+    Common::Util::Deliver<JoinGameRspInfo>(mServer, index, mPlayerNum, tmpUsernames);
     for (int i = 0; i < index; i++) {
         Common::Util::Deliver<JoinGameInfo>(mServer, i, username);
     }
@@ -62,17 +223,16 @@ void GameBoard::StartGame()
 #ifdef ENABLE_LOG
     spdlog::info("Game Starts.");
 #endif
-    mDeck->Init();
-    std::vector<std::array<Card, 7>> initHandCards = 
-        mDeck->DealInitHandCards(Common::Common::mPlayerNum);
+    std::vector<std::vector<Card>> initHandCards = DealFromShoe();
 
     // Assign random characters to each player
-    for (auto& playerStat : mPlayerStats) {
-        auto characterType = CharacterFactory::GetRandomCharacter();
-        auto character = CharacterFactory::CreateCharacter(characterType);
-        playerStat.AssignCharacter(std::move(character));
-        std::cout << "Player " << playerStat.GetUsername() 
-                  << " assigned character: " << playerStat.GetCharacterName() << std::endl;
+    if (mAssignsCharacters) {
+        for (auto& playerStat : mPlayerStats) {
+            auto characterType = CharacterFactory::GetRandomCharacter();
+            auto character = CharacterFactory::CreateCharacter(characterType);
+            playerStat.AssignCharacter(std::move(character));
+            UNO_LOG_INFO("Player {} assigned character: {}", playerStat.GetUsername(), playerStat.GetCharacterName());
+        }
     }
 
     // flip a card
@@ -93,8 +253,7 @@ void GameBoard::StartGame()
     }
 
     // choose the first player randomly
-    std::srand(std::time(nullptr));
-    int firstPlayer = std::rand() % Common::Common::mPlayerNum;
+    int firstPlayer = std::uniform_int_distribution<int>(0, mPlayerNum - 1)(mRandom);
 
     std::vector<std::string> tmpUsernames;
     std::for_each(mPlayerStats.begin(), mPlayerStats.end(),
@@ -102,81 +261,201 @@ void GameBoard::StartGame()
             tmpUsernames.push_back(stat.GetUsername());
         }
     );
-    for (int player = 0; player < Common::Common::mPlayerNum; player++) {
+    for (int player = 0; player < mPlayerNum; player++) {
         Common::Util::Deliver<GameStartInfo>(mServer, player, initHandCards[player], flippedCard,
-            Common::Util::WrapWithPlayerNum(firstPlayer - player), tmpUsernames);
+            Common::Util::Wrap(firstPlayer - player, mPlayerNum), tmpUsernames);
 
         std::rotate(tmpUsernames.begin(), tmpUsernames.begin() + 1, tmpUsernames.end());
     }
 
-    mGameStat.reset(new GameStat(firstPlayer, flippedCard));
+    mGameStat.reset(new GameStat(firstPlayer, flippedCard, mPlayerNum));
     
     // Initialize skill usage tracking
-    for (int i = 0; i < Common::Common::mPlayerNum; i++) {
+    for (int i = 0; i < mPlayerNum; i++) {
         mSkillUsedThisTurn[i] = false;
     }
 
-    GameLoop();
+    if (mJournal) {
+        for (int player = 0; player < mPlayerNum; player++) {
+            Record(JournalEventType::DEAL, player, {}, Common::Common::mInitHandCardsNum);
+        }
+        mJournal->Snapshot(TakeSnapshot());
+    }
+
+    SpawnGameLoop();
 }
 
-void GameBoard::GameLoop()
+std::vector<std::vector<Card>> GameBoard::DealFromShoe()
 {
-    while (!mGameStat->DoesGameEnd()) {
-        try {
-            int currentPlayer = mGameStat->GetCurrentPlayer();
-            
-            // 新增：检查特殊效果状态
-            if (mGameStat->IsSpecialEffectActive()) {
-                std::cout << "Special effect active, handling special phase" << std::endl;
-                // 处理特殊效果阶段（如Flash卡效果）
-            }
-            
-            // Start of turn phase
-            mGameStat->SetCurrentPhase(GameStat::TurnPhase::START);
-            std::cout << "Player " << currentPlayer << "'s turn - START phase" << std::endl;
-            
-            // Reset skill usage for this turn
-            mSkillUsedThisTurn[currentPlayer] = false;
+    mDeck->Init();
+    // the other decks of the shoe are copies of the first one, shuffled in together
+    std::vector<Card> shoe(mDeck->GetPile().begin(), mDeck->GetPile().end());
+    std::size_t deckSize = shoe.size();
+    shoe.reserve(deckSize * Common::Common::mDeckNum);
+    for (int deck = 1; deck < Common::Common::mDeckNum; deck++) {
+        for (std::size_t i = 0; i < deckSize; i++) {
+            shoe.push_back(shoe[i]);
+        }
+    }
+    if (Common::Common::mDeckNum > 1) {
+        uint64_t seed = mRandom();
+        Common::ShuffleRng rng((seed << 32) | mRandom());
+        Common::Shuffle(std::span(shoe), rng);
+        mDeck->Clear();
+        for (const Card &card : shoe) {
+            mDeck->PushBack(card);
+        }
+    }
 
-            // Skill usage phase
-            mGameStat->SetCurrentPhase(GameStat::TurnPhase::SKILL);
-            std::cout << "Player " << currentPlayer << "'s turn - SKILL phase" << std::endl;
-            HandleSkillPhase();
+    // deal one card to each player in turn, like at a real table
+    std::vector<std::vector<Card>> initHandCards(mPlayerNum);
+    for (auto &handCards : initHandCards) {
+        handCards.reserve(Common::Common::mInitHandCardsNum);
+    }
+    for (int i = 0; i < Common::Common::mInitHandCardsNum; i++) {
+        for (auto &handCards : initHandCards) {
+            handCards.push_back(mDeck->Draw());
+        }
+    }
+    return initHandCards;
+}
 
-            // Card play phase
-            mGameStat->SetCurrentPhase(GameStat::TurnPhase::CARD_PLAY);
-            std::cout << "Player " << currentPlayer << "'s turn - CARD_PLAY phase" << std::endl;
-            
-            auto actionInfo = Common::Util::Receive<ActionInfo>(mServer, currentPlayer);
-            switch (actionInfo->mActionType) {
-                case ActionType::DRAW:
-                    HandleDraw(Common::Util::DynamicCast<DrawInfo>(actionInfo));
-                    break;
-                case ActionType::SKIP:
-                    HandleSkip(Common::Util::DynamicCast<SkipInfo>(actionInfo));
-                    break;
-                case ActionType::PLAY:
-                    HandlePlay(Common::Util::DynamicCast<PlayInfo>(actionInfo));
-                    break;
-                default:
-                    assert(0);
-            }
+void GameBoard::ResumeGame()
+{
+#ifdef ENABLE_LOG
+    spdlog::info("Game Resumes.");
+#endif
+    mIsRestored = false;
+    // players keep their hand cards across the migration, they only need to catch up with the table
+    for (int player = 0; player < mPlayerNum; player++) {
+        Common::Util::Deliver<GameStateUpdateInfo>(mServer, player,
+            Common::Util::Wrap(mGameStat->GetCurrentPlayer() - player, mPlayerNum),
+            mGameStat->GetCurrentPhase(), mGameStat->IsSpecialEffectActive(),
+            mGameStat->GetLastPlayedCard(), mGameStat->GetCardsNumToDraw());
+    }
+
+    SpawnGameLoop();
+}
+
+void GameBoard::SpawnGameLoop()
+{
+    // exceptions escaping the game are rethrown from the context's run(), like they used to be
+    asio::co_spawn(mServer->GetExecutor(), GameLoop(), [](std::exception_ptr e) {
+        if (e) {
+            std::rethrow_exception(e);
+        }
+    });
+}
 
-            // End of turn phase
-            mGameStat->SetCurrentPhase(GameStat::TurnPhase::END);
-            std::cout << "Player " << currentPlayer << "'s turn - END phase" << std::endl;
-            HandleTurnEnd();
+asio::awaitable<void> GameBoard::GameLoop()
+{
+    while (!mGameStat->DoesGameEnd()) {
+        try {
+            co_await (this->*mPlayTurn)();
 
+            std::string migrationPath;
+            {
+                std::lock_guard<std::mutex> lock(mMigrationMutex);
+                migrationPath.swap(mMigrationPath);
+            }
+            if (!migrationPath.empty()) {
+                DumpTable(migrationPath);
+                UNO_LOG_INFO("table dumped to {} for migration", migrationPath);
+                co_return;
+            }
         }
         catch (const std::exception &e) {
             /// TODO: handle the condition that someone has disconnected
-            std::cout << "someone has disconnected, shutdown server" << std::endl;
+            UNO_LOG_ERROR("someone has disconnected, shutdown server");
+            Common::Logger::Instance().Flush();
             std::exit(-1);
         }
     }
     ResetGame();
 }
 
+template <typename Rules>
+asio::awaitable<void> GameBoard::PlayTurn()
+{
+    int currentPlayer = mGameStat->GetCurrentPlayer();
+    uint64_t turnStart = Common::Metrics::NowMicros();
+    
+    // 新增：检查特殊效果状态
+    if (mGameStat->IsSpecialEffectActive()) {
+        UNO_LOG_DEBUG("Special effect active, handling special phase");
+        // 处理特殊效果阶段（如Flash卡效果）
+    }
+    
+    // Start of turn phase
+    mGameStat->SetCurrentPhase(GameStat::TurnPhase::START);
+    Record(JournalEventType::PHASE, currentPlayer, {}, static_cast<int>(GameStat::TurnPhase::START));
+    UNO_LOG_DEBUG("Player {}'s turn - START phase", currentPlayer);
+    
+    // Reset skill usage for this turn
+    if constexpr (Rules::HAS_CHARACTERS) {
+        mSkillUsedThisTurn[currentPlayer] = false;
+    }
+    uint64_t phaseStart = Common::Metrics::NowMicros();
+    mMetrics.mPhaseDuration[static_cast<int>(GameStat::TurnPhase::START)]->Record(phaseStart - turnStart);
+
+    // Skill usage phase
+    mGameStat->SetCurrentPhase(GameStat::TurnPhase::SKILL);
+    Record(JournalEventType::PHASE, currentPlayer, {}, static_cast<int>(GameStat::TurnPhase::SKILL));
+    UNO_LOG_DEBUG("Player {}'s turn - SKILL phase", currentPlayer);
+    if constexpr (Rules::HAS_CHARACTERS) {
+        HandleSkillPhase();
+    }
+    uint64_t now = Common::Metrics::NowMicros();
+    mMetrics.mPhaseDuration[static_cast<int>(GameStat::TurnPhase::SKILL)]->Record(now - phaseStart);
+    phaseStart = now;
+
+    // Card play phase, the table is suspended rather than blocking a thread while waiting
+    mGameStat->SetCurrentPhase(GameStat::TurnPhase::CARD_PLAY);
+    Record(JournalEventType::PHASE, currentPlayer, {}, static_cast<int>(GameStat::TurnPhase::CARD_PLAY));
+    UNO_LOG_DEBUG("Player {}'s turn - CARD_PLAY phase", currentPlayer);
+    
+    uint64_t waitStart = Common::Metrics::NowMicros();
+    auto actionInfo = co_await AsyncReceive<ActionInfo>(currentPlayer);
+    uint64_t wait = Common::Metrics::NowMicros() - waitStart;
+    mMetrics.mClientWait->Record(wait);
+    mMetrics.mTableClientWait->Record(wait);
+    switch (actionInfo->mActionType) {
+        case ActionType::DRAW:
+            HandleDraw<Rules>(Common::Util::DynamicCast<DrawInfo>(actionInfo));
+            break;
+        case ActionType::SKIP:
+            HandleSkip(Common::Util::DynamicCast<SkipInfo>(actionInfo));
+            break;
+        case ActionType::PLAY:
+            HandlePlay<Rules>(Common::Util::DynamicCast<PlayInfo>(actionInfo));
+            break;
+        default:
+            assert(0);
+    }
+    if constexpr (Rules::HAS_CUSTOM_CARDS) {
+        if (mIsFlashEffectActive && !mGameStat->DoesGameEnd()) {
+            co_await HandleFlashCardEffect(currentPlayer, mFlashEffectColor);
+        }
+    }
+
+    now = Common::Metrics::NowMicros();
+    mMetrics.mPhaseDuration[static_cast<int>(GameStat::TurnPhase::CARD_PLAY)]->Record(now - phaseStart);
+    phaseStart = now;
+
+    // End of turn phase
+    mGameStat->SetCurrentPhase(GameStat::TurnPhase::END);
+    Record(JournalEventType::PHASE, currentPlayer, {}, static_cast<int>(GameStat::TurnPhase::END));
+    UNO_LOG_DEBUG("Player {}'s turn - END phase", currentPlayer);
+    HandleTurnEnd<Rules>();
+
+    CheckpointJournal();
+
+    now = Common::Metrics::NowMicros();
+    mMetrics.mPhaseDuration[static_cast<int>(GameStat::TurnPhase::END)]->Record(now - phaseStart);
+    mMetrics.mProcessing->Record(now - turnStart - wait);
+    mMetrics.mTurns->Add();
+}
+
 void GameBoard::HandleSkillPhase()
 {
     int currentPlayer = mGameStat->GetCurrentPlayer();
@@ -185,68 +464,76 @@ void GameBoard::HandleSkillPhase()
     if (currentStat.HasCharacter() && currentStat.CanUseSkill() && !mSkillUsedThisTurn[currentPlayer]) {
         // In a real implementation, we would send a message to the client
         // asking if they want to use their skill, and receive their decision
-        std::cout << "Player " << currentPlayer << " can use skill: " 
-                  << currentStat.GetCharacterName() << std::endl;
+        UNO_LOG_DEBUG("Player {} can use skill: {}", currentPlayer, currentStat.GetCharacterName());
         
         // For demonstration, we'll auto-use skills in certain conditions
         // In a real game, this would be player's choice
         if (currentStat.GetCharacterType() == CharacterType::COLLECTOR && 
-            !mDiscardPile->GetPile().empty()) {
-            // Auto-use Collector skill if discard pile is not empty
+            mDiscardPile->GetPile().size() > 1) {
+            // Auto-use Collector skill if there is a card below the top of the discard pile
             ProcessCollectorSkill(currentPlayer);
             mSkillUsedThisTurn[currentPlayer] = true;
         }
         // 新增：其他角色的技能触发条件
         else if (currentStat.GetCharacterType() == CharacterType::LUCKY_STAR) {
             // Lucky Star 技能在抽牌阶段处理
-            std::cout << "Lucky Star skill available for draw phase" << std::endl;
+            UNO_LOG_DEBUG("Lucky Star skill available for draw phase");
         }
     }
 }
 
+template <typename Rules>
 void GameBoard::HandleTurnEnd()
 {
     int currentPlayer = mGameStat->GetCurrentPlayer();
     
     // Update character cooldowns
-    for (auto& playerStat : mPlayerStats) {
-        playerStat.UpdateCharacterCooldown();
-    }
-    
-    // Reset Flash effect if it was active
-    if (mIsFlashEffectActive) {
-        mIsFlashEffectActive = false;
-        mFlashCardsPlayed = 0;
-        mPlayersAffectedByFlash.clear();
-        mGameStat->SetSpecialEffectActive(false);  // 新增：更新游戏状态
+    if constexpr (Rules::HAS_CHARACTERS) {
+        for (auto& playerStat : mPlayerStats) {
+            playerStat.UpdateCharacterCooldown();
+        }
     }
     
-    // 新增：重置Package效果状态
-    if (mIsPackageEffectActive) {
-        mIsPackageEffectActive = false;
-        mPackagePlayerIndex = -1;
+    if constexpr (Rules::HAS_CUSTOM_CARDS) {
+        // Reset Flash effect if it was active
+        if (mIsFlashEffectActive) {
+            mIsFlashEffectActive = false;
+            mFlashCardsPlayed = 0;
+            mPlayersAffectedByFlash.clear();
+            mGameStat->SetSpecialEffectActive(false);  // 新增：更新游戏状态
+        }
+        
+        // 新增：重置Package效果状态
+        if (mIsPackageEffectActive) {
+            mIsPackageEffectActive = false;
+            mPackagePlayerIndex = -1;
+        }
     }
     
-    std::cout << "Turn ended for player " << currentPlayer << std::endl;
+    UNO_LOG_DEBUG("Turn ended for player {}", currentPlayer);
 }
 
+template <typename Rules>
 void GameBoard::HandleDraw(const std::unique_ptr<DrawInfo> &info)
 {
-    std::cout << *info << std::endl;
+    UNO_LOG_DEBUG("Player {} draws {} cards", mGameStat->GetCurrentPlayer(), info->mNumber);
 
     // Check for Lucky Star skill during draw phase
     int currentPlayer = mGameStat->GetCurrentPlayer();
     PlayerStat& currentStat = mPlayerStats[currentPlayer];
     
-    if (currentStat.HasCharacter() && 
+    if (Rules::HAS_CHARACTERS && currentStat.HasCharacter() && 
         currentStat.GetCharacterType() == CharacterType::LUCKY_STAR &&
         currentStat.CanUseSkill() && !mSkillUsedThisTurn[currentPlayer]) {
         ProcessLuckyStarSkill(currentPlayer);
-        mSkillUsedThisTurn[currentPlayer] = true;
+        Record(JournalEventType::DRAW, currentPlayer, {}, info->mNumber,
+            DRAW_FLAG_PENALTY | DRAW_FLAG_NO_DECK);
     } else {
         // Normal draw
-        std::vector<Card> cardsToDraw = mDeck->Draw(info->mNumber);
+        mMetrics.mDrawStackSize->Record(info->mNumber);
+        std::vector<Card> cardsToDraw = DrawFromDeck(info->mNumber);
         Common::Util::Deliver<DrawRspInfo>(mServer, currentPlayer, info->mNumber, cardsToDraw);
+        Record(JournalEventType::DRAW, currentPlayer, {}, info->mNumber, DRAW_FLAG_PENALTY);
     }
 
     // Broadcast to other players
@@ -259,24 +546,27 @@ void GameBoard::HandleDraw(const std::unique_ptr<DrawInfo> &info)
 
 void GameBoard::HandleSkip(const std::unique_ptr<SkipInfo> &info)
 {
-    std::cout << *info << std::endl;
+    UNO_LOG_DEBUG("Player {} skips", mGameStat->GetCurrentPlayer());
 
     // broadcast to other players
     Broadcast<SkipInfo>(*info);
+    Record(JournalEventType::SKIP, mGameStat->GetCurrentPlayer());
 
     // update stat
     mPlayerStats[mGameStat->GetCurrentPlayer()].UpdateAfterSkip();
     mGameStat->UpdateAfterSkip();
 }
 
+template <typename Rules>
 void GameBoard::HandlePlay(const std::unique_ptr<PlayInfo> &info)
 {
-    std::cout << *info << std::endl;
+    UNO_LOG_DEBUG("Player {} plays {}, next color: {}", mGameStat->GetCurrentPlayer(),
+        info->mCard, info->mNextColor);
     
     // 新增：验证Wild Draw Four出牌条件
     if (info->mCard.mText == CardText::DRAW_FOUR && info->mCard.mColor == CardColor::BLACK) {
         if (!CanPlayWildDrawFour(mGameStat->GetCurrentPlayer())) {
-            std::cout << "Invalid Wild Draw Four play - player has matching color cards" << std::endl;
+            UNO_LOG_WARN("Invalid Wild Draw Four play - player has matching color cards");
             // 在实际实现中，这里应该拒绝出牌并让玩家重新选择
             return;
         }
@@ -285,7 +575,11 @@ void GameBoard::HandlePlay(const std::unique_ptr<PlayInfo> &info)
     mDiscardPile->Add(info->mCard);
     
     // Handle special card effects
-    HandleSpecialCardEffects(info->mCard);
+    if constexpr (Rules::HAS_CUSTOM_CARDS) {
+        HandleSpecialCardEffects(info->mCard);
+    }
+    Record(JournalEventType::PLAY, mGameStat->GetCurrentPlayer(), info->mCard,
+        static_cast<int>(info->mNextColor));
 
     if (info->mCard.mColor == CardColor::BLACK) {
         // change the color to the specified next color to show in UI
@@ -310,7 +604,8 @@ void GameBoard::HandleSpecialCardEffects(const Card& card)
     
     switch (card.mText) {
         case CardText::PACKAGE:
-            std::cout << "Package Card played by player " << currentPlayer << std::endl;
+            UNO_LOG_DEBUG("Package Card played by player {}", currentPlayer);
+            Record(JournalEventType::EFFECT, currentPlayer, card);
             // 设置Package效果状态
             mIsPackageEffectActive = true;
             mPackagePlayerIndex = currentPlayer;
@@ -322,11 +617,14 @@ void GameBoard::HandleSpecialCardEffects(const Card& card)
             break;
             
         case CardText::FLASH:
-            std::cout << "Flash Card played by player " << currentPlayer << std::endl;
+            UNO_LOG_DEBUG("Flash Card played by player {}", currentPlayer);
+            Record(JournalEventType::EFFECT, currentPlayer, card);
             mGameStat->SetSpecialEffectActive(true);
             // In real implementation, ask player to choose a color
             // For now, auto-choose the card's color
-            HandleFlashCardEffect(currentPlayer, card.mColor);
+            // the other players are prompted once the play has been broadcast, see PlayTurn
+            mIsFlashEffectActive = true;
+            mFlashEffectColor = card.mColor;
             break;
             
         default:
@@ -336,8 +634,7 @@ void GameBoard::HandleSpecialCardEffects(const Card& card)
 
 void GameBoard::HandlePackageCardEffect(int playerIndex, CardColor chosenColor)
 {
-    std::cout << "Package Card effect: Player " << playerIndex 
-              << " can discard all " << chosenColor << " number cards" << std::endl;
+    UNO_LOG_DEBUG("Package Card effect: Player {} can discard all {} number cards", playerIndex, chosenColor);
     
     // In a real implementation, we would:
     // 1. Send a message to the client to choose which color to discard
@@ -347,14 +644,13 @@ void GameBoard::HandlePackageCardEffect(int playerIndex, CardColor chosenColor)
     
     // For now, just log the effect
     PlayerStat& playerStat = mPlayerStats[playerIndex];
-    std::cout << "Player " << playerIndex << " would discard all " 
-              << chosenColor << " number cards from their hand" << std::endl;
-    std::cout << "Player has " << playerStat.GetHandCardCount() << " cards in hand" << std::endl;
+    UNO_LOG_DEBUG("Player {} would discard all {} number cards from {} cards in hand",
+        playerIndex, chosenColor, playerStat.GetHandCardCount());
 }
 
-void GameBoard::HandleFlashCardEffect(int playerIndex, CardColor chosenColor)
+asio::awaitable<void> GameBoard::HandleFlashCardEffect(int playerIndex, CardColor chosenColor)
 {
-    std::cout << "Flash Card effect activated! Color: " << chosenColor << std::endl;
+    UNO_LOG_DEBUG("Flash Card effect activated! Color: {}", chosenColor);
     
     mIsFlashEffectActive = true;
     mFlashEffectColor = chosenColor;
@@ -362,38 +658,108 @@ void GameBoard::HandleFlashCardEffect(int playerIndex, CardColor chosenColor)
     mPlayersAffectedByFlash.clear();
     mGameStat->SetSpecialEffectActive(true);
     
-    int currentPlayer = playerIndex;
+    // prompt all other players at once and collect their answers under one deadline,
+    // so the effect takes one round trip rather than one per player; the client answers
+    // from the hand it follows as soon as a prompt arrives, see Client::GetHandCards, and
+    // an answer that misses the deadline is dropped by the session rather than taken for an action
+    std::vector<int> targetPlayers;
+    for (int i = 1; i < mPlayerNum; i++) {
+        targetPlayers.push_back((playerIndex + i) % mPlayerNum);
+    }
+    for (int targetPlayer : targetPlayers) {
+        Common::Util::Deliver<SpecialEffectInfo>(mServer, targetPlayer,
+            Common::Util::Wrap(playerIndex - targetPlayer, mPlayerNum), CardText::FLASH, chosenColor);
+    }
+    auto responses = co_await AsyncReceiveAll<SpecialEffectInfo>(targetPlayers,
+        std::chrono::seconds(Common::Common::mTimeoutPerTurn + DEADLINE_GRACE_SECONDS));
     
     // Process Flash effect for other players in sequence
-    for (int i = 1; i < Common::Common::mPlayerNum; i++) {
-        int targetPlayer = (currentPlayer + i) % Common::Common::mPlayerNum;
+    for (std::size_t i = 0; i < targetPlayers.size(); i++) {
+        int targetPlayer = targetPlayers[i];
         
-        // Check if target player has the specified color card
-        // In real implementation, we would check their actual hand
-        bool hasColorCard = false; // This would be determined by actual hand checking
+        // a player answers with the Flash color and the card of it they play,
+        // no answer in time counts as not having one
+        bool hasColorCard = responses[i] && responses[i]->mTargetColor == chosenColor
+            && responses[i]->mCard.mColor == chosenColor;
         
         if (!hasColorCard) {
             // Player must draw cards equal to number of Flash cards already played
             int cardsToDraw = mFlashCardsPlayed;
             if (cardsToDraw > 0) {
-                std::vector<Card> drawnCards = mDeck->Draw(cardsToDraw);
-                std::cout << "Player " << targetPlayer << " draws " << cardsToDraw 
-                          << " cards due to Flash effect" << std::endl;
+                std::vector<Card> drawnCards = DrawFromDeck(cardsToDraw);
+                UNO_LOG_DEBUG("Player {} draws {} cards due to Flash effect", targetPlayer, cardsToDraw);
                 mPlayersAffectedByFlash.push_back(targetPlayer);
                 
                 // Send draw response to affected player
                 Common::Util::Deliver<DrawRspInfo>(mServer, targetPlayer, cardsToDraw, drawnCards);
                 // 更新受影响玩家的状态
                 mPlayerStats[targetPlayer].UpdateAfterDraw(cardsToDraw);
+                Record(JournalEventType::DRAW, targetPlayer, {}, cardsToDraw, 0);
             }
         } else {
-            mFlashCardsPlayed++;
+            UNO_LOG_DEBUG("Player {} answers Flash with {}", targetPlayer, responses[i]->mCard);
+            PlayFlashAnswer(targetPlayer, responses[i]->mCard);
+            Record(JournalEventType::PLAY, targetPlayer, responses[i]->mCard, 0, PLAY_FLASH_ANSWER);
         }
     }
     
-    std::cout << "Flash effect completed. " << mFlashCardsPlayed 
-              << " cards played, " << mPlayersAffectedByFlash.size() 
-              << " players affected" << std::endl;
+    UNO_LOG_DEBUG("Flash effect completed. {} cards played, {} players affected",
+        mFlashCardsPlayed, mPlayersAffectedByFlash.size());
+}
+
+void GameBoard::PlayFlashAnswer(int playerIndex, Card card)
+{
+    mDiscardPile->Add(card);
+    mGameStat->SetLastPlayedCard(card);
+    mFlashCardsPlayed++;
+
+    PlayerStat &stat = mPlayerStats[playerIndex];
+    stat.UpdateAfterPlay(card);
+    if (stat.GetRemainingHandCardsNum() == 0) {
+        mGameStat->GameEnds();
+        UNO_LOG_INFO("Player {} ({}) wins the game on a Flash answer!", playerIndex, stat.GetUsername());
+    }
+}
+
+template <typename InfoT>
+asio::awaitable<std::vector<std::unique_ptr<InfoT>>> GameBoard::AsyncReceiveAll(
+    const std::vector<int> &indexes, std::chrono::steady_clock::duration timeout)
+{
+    // shared with the receiving coroutines, which all run on the table's strand
+    // and therefore need no synchronization
+    struct Collection {
+        explicit Collection(asio::any_io_executor executor, std::size_t size)
+            : mInfos(size), mPendingNum(size), mAllReceived(executor, std::chrono::steady_clock::time_point::max()) {}
+
+        std::vector<std::unique_ptr<InfoT>> mInfos;
+        std::size_t mPendingNum;
+        asio::steady_timer mAllReceived;
+    };
+
+    auto executor = co_await asio::this_coro::executor;
+    auto collection = std::make_shared<Collection>(executor, indexes.size());
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    for (std::size_t i = 0; i < indexes.size(); i++) {
+        asio::co_spawn(executor, [this, collection, i, index = indexes[i], deadline]() -> asio::awaitable<void> {
+            try {
+                collection->mInfos[i] = Common::Util::DynamicCast<InfoT>(co_await mServer->AsyncReceiveInfo(
+                    &typeid(InfoT), index, deadline - std::chrono::steady_clock::now()));
+            }
+            catch (const std::exception &e) {
+                UNO_LOG_WARN("no answer from player {}: {}", index, e.what());
+            }
+            if (--collection->mPendingNum == 0) {
+                collection->mAllReceived.cancel();
+            }
+        }, asio::detached);
+    }
+
+    if (collection->mPendingNum > 0) {
+        // every receive ends by the deadline at the latest, the last one wakes us up
+        std::error_code ec;
+        co_await collection->mAllReceived.async_wait(asio::redirect_error(asio::use_awaitable, ec));
+    }
+    co_return std::move(collection->mInfos);
 }
 
 // 以下技能处理方法保持不变（为了完整性保留）
@@ -418,69 +784,122 @@ void GameBoard::HandleCharacterSkill(int playerIndex, CharacterType skillType, i
 
 void GameBoard::ProcessLuckyStarSkill(int playerIndex)
 {
-    std::cout << "Lucky Star skill used by player " << playerIndex << std::endl;
-    
-    // View top 3 cards of the deck
-    std::vector<Card> topCards;
-    for (int i = 0; i < 3 && !mDeck->Empty(); i++) {
-        topCards.push_back(mDeck->Draw());
+    UNO_LOG_DEBUG("Lucky Star skill used by player {}", playerIndex);
+    OfferLuckyStar(playerIndex);
+    TakeLuckyStarCard(0);
+}
+
+const std::vector<Card> &GameBoard::OfferLuckyStar(int playerIndex)
+{
+    // the use is spent before the deck is looked at, so nobody peeks and then declines
+    mPlayerStats[playerIndex].UseSkill();
+    mSkillUsedThisTurn[playerIndex] = true;
+
+    // the offer is a copy of the top, so what the player sees is exactly what they choose from
+    const auto &deck = mDeck->GetPile();
+    int viewNum = std::min<int>(LUCKY_STAR_VIEW_NUM, deck.size());
+    mLuckyStarPlayer = playerIndex;
+    mLuckyStarOffer.assign(deck.begin(), deck.begin() + viewNum);
+    return mLuckyStarOffer;
+}
+
+void GameBoard::TakeLuckyStarCard(int index)
+{
+    if (mLuckyStarPlayer < 0) {
+        return;
     }
-    
-    // In real implementation, send these cards to the client to choose one
-    // For now, auto-choose the first card
-    Card chosenCard = topCards.empty() ? Card() : topCards[0];
-    
-    // Return the other two cards to the deck in original order
-    for (int i = topCards.size() - 1; i >= 0; i--) {
-        if (i != 0) { // Skip the chosen card
-            mDeck->PutToBottom(topCards[i]);
-        }
+    int playerIndex = mLuckyStarPlayer;
+    if (index < 0 || index >= static_cast<int>(mLuckyStarOffer.size())) {
+        index = 0;
     }
-    
-    // Give the chosen card to the player
-    if (!topCards.empty()) {
-        std::vector<Card> chosenCards = {chosenCard};
+    mLuckyStarPlayer = -1;
+    mLuckyStarOffer.clear();
+
+    std::vector<Card> chosenCards = PickWithLuckyStar(index);
+    if (!chosenCards.empty()) {
         Common::Util::Deliver<DrawRspInfo>(mServer, playerIndex, 1, chosenCards);
         mPlayerStats[playerIndex].UpdateAfterDraw(1);
     }
-    
-    // Mark skill as used
-    mPlayerStats[playerIndex].UseSkill();
+
+    mMetrics.mSkillActivations[static_cast<int>(CharacterType::LUCKY_STAR)]->Add();
+    Record(JournalEventType::SKILL, playerIndex, {}, static_cast<int>(CharacterType::LUCKY_STAR), index);
+}
+
+std::vector<Card> GameBoard::PickWithLuckyStar(int chosenIndex)
+{
+    // the deck is not refilled just to look
+    int viewNum = std::min<int>(LUCKY_STAR_VIEW_NUM, mDeck->GetPile().size());
+    if (viewNum == 0) {
+        return {};
+    }
+    if (chosenIndex < 0 || chosenIndex >= viewNum) {
+        chosenIndex = 0;
+    }
+    UNO_LOG_DEBUG("Lucky Star views {} cards, chooses {}", viewNum, mDeck->GetPile()[chosenIndex]);
+
+    // the other cards stay on the top in their original order
+    return {ExtractFromDeck(chosenIndex)};
+}
+
+Card GameBoard::ExtractFromDeck(int index)
+{
+    // the cards above are drawn and put back in reverse, at most index of them,
+    // and the deck never refills as it has more than index cards
+    std::array<Card, LUCKY_STAR_VIEW_NUM> above;
+    for (int i = 0; i < index; i++) {
+        above[i] = mDeck->Draw();
+    }
+    Card card = mDeck->Draw();
+    for (int i = index - 1; i >= 0; i--) {
+        mDeck->PushFront(above[i]);
+    }
+    return card;
 }
 
 void GameBoard::ProcessCollectorSkill(int playerIndex)
 {
-    std::cout << "Collector skill used by player " << playerIndex << std::endl;
+    UNO_LOG_DEBUG("Collector skill used by player {}", playerIndex);
     
-    auto discardPile = mDiscardPile->GetPile();
-    if (discardPile.empty()) {
-        std::cout << "Discard pile is empty, skill fails" << std::endl;
+    std::vector<Card> collectedCards = PickWithCollector();
+    if (collectedCards.empty()) {
+        UNO_LOG_DEBUG("No card below the top of the discard pile, skill fails");
         return;
     }
     
-    // In real implementation, send discard pile to client to choose a card
-    // For now, auto-choose the top card (excluding the very top if it's the current play)
-    Card chosenCard = discardPile.size() > 1 ? discardPile[1] : discardPile[0];
+    UNO_LOG_DEBUG("Player {} collects card: {}", playerIndex, collectedCards[0]);
     
-    std::cout << "Player " << playerIndex << " collects card: " << chosenCard << std::endl;
-    
-    // Give the card to the player (in real implementation, remove from discard pile)
-    std::vector<Card> collectedCards = {chosenCard};
     Common::Util::Deliver<DrawRspInfo>(mServer, playerIndex, 1, collectedCards);
     mPlayerStats[playerIndex].UpdateAfterDraw(1);
     
     // Mark skill as used
     mPlayerStats[playerIndex].UseSkill();
+    mMetrics.mSkillActivations[static_cast<int>(CharacterType::COLLECTOR)]->Add();
+    Record(JournalEventType::SKILL, playerIndex, {}, static_cast<int>(CharacterType::COLLECTOR));
+}
+
+std::vector<Card> GameBoard::PickWithCollector()
+{
+    // the top card is the one in play and cannot be collected
+    int candidateNum = std::ranges::distance(mDiscardPile->Candidates());
+    if (candidateNum == 0) {
+        return {};
+    }
+    
+    // In real implementation, send the candidates to client to choose a card
+    // For now, auto-choose the card right below the top
+    return {mDiscardPile->TakeAt(candidateNum - 1)};
 }
 
 void GameBoard::ProcessThiefSkill(int playerIndex, int targetPlayer, CardText cardType)
 {
-    std::cout << "Thief skill used by player " << playerIndex 
-              << " on player " << targetPlayer << " for card type: " << static_cast<int>(cardType) << std::endl;
+    UNO_LOG_DEBUG("Thief skill used by player {} on player {} for card type: {}",
+        playerIndex, targetPlayer, static_cast<int>(cardType));
+    Record(JournalEventType::SKILL, playerIndex, {}, static_cast<int>(CharacterType::THIEF), targetPlayer);
     
     // Check if target has Defender and try to defend
     if (ProcessDefenderSkill(targetPlayer)) {
-        std::cout << "Defender skill activated! Thief skill blocked." << std::endl;
+        UNO_LOG_DEBUG("Defender skill activated! Thief skill blocked.");
+        mMetrics.mSkillActivations[static_cast<int>(CharacterType::DEFENDER)]->Add();
         return;
     }
     
@@ -489,10 +908,11 @@ void GameBoard::ProcessThiefSkill(int playerIndex, int targetPlayer, CardText ca
     // 2. If yes, randomly steal one card of that type
     // 3. Give one card from thief to target player
     
-    std::cout << "Thief skill executed successfully" << std::endl;
+    UNO_LOG_DEBUG("Thief skill executed successfully");
     
     // Mark skill as used
     mPlayerStats[playerIndex].UseSkill();
+    mMetrics.mSkillActivations[static_cast<int>(CharacterType::THIEF)]->Add();
 }
 
 bool GameBoard::ProcessDefenderSkill(int targetPlayer)
@@ -518,9 +938,8 @@ void GameBoard::Win()
 #endif
     
     int winnerIndex = mGameStat->GetCurrentPlayer();
-    std::cout << "Player " << winnerIndex << " (" << mPlayerStats[winnerIndex].GetUsername() 
-              << ") wins the game!" << std::endl;
-    std::cout << "Character: " << mPlayerStats[winnerIndex].GetCharacterName() << std::endl;
+    UNO_LOG_INFO("Player {} ({}) wins the game! Character: {}", winnerIndex,
+        mPlayerStats[winnerIndex].GetUsername(), mPlayerStats[winnerIndex].GetCharacterName());
 }
 
 void GameBoard::BroadcastGameStateUpdate()
@@ -557,4 +976,274 @@ bool GameBoard::CanPlayWildDrawFour(int playerIndex) const
     return true;
 }
 
+std::vector<Card> GameBoard::DrawFromDeck(int number)
+{
+    auto sizeBefore = mDeck->GetPile().size();
+    std::vector<Card> cards = mDeck->Draw(number);
+    if (mDeck->GetPile().size() + cards.size() != sizeBefore) {
+        // the discard pile has been shuffled back, which replay is unable to reproduce
+        mDiscardPile->Reindex();
+        mSnapshotDue = true;
+        mMetrics.mReshuffles->Add();
+    }
+    return cards;
+}
+
+void GameBoard::Record(JournalEventType type, int player, Card card, int arg, int arg2)
+{
+    if (mJournal) {
+        mJournal->Append({0, type, static_cast<int8_t>(player),
+            static_cast<uint8_t>(card.mColor), static_cast<uint8_t>(card.mText),
+            static_cast<int16_t>(arg), static_cast<int16_t>(arg2)});
+    }
+}
+
+void GameBoard::CheckpointJournal()
+{
+    if (mJournal && mJournal->Failed()) {
+        // the writer has logged the failure, the table goes on without a journal
+        mJournal.reset();
+        return;
+    }
+    if (mJournal && (mSnapshotDue || mJournal->RecordsSinceSnapshot() >= SNAPSHOT_INTERVAL)) {
+        mJournal->Snapshot(TakeSnapshot());
+        mSnapshotDue = false;
+    }
+}
+
+void GameBoard::EncodeTable(std::vector<uint8_t> &image) const
+{
+    const auto &deck = mDeck->GetPile();
+    const auto &discardPile = mDiscardPile->GetPile();
+    int seatNum = mPlayerStats.size();
+    std::size_t size = TableImage::SizeOf(seatNum, deck.size(), discardPile.size());
+    image.assign(size, 0);
+
+    TableImageHeader header{};
+    header.mMagic = TableImage::MAGIC;
+    header.mVersion = TableImage::VERSION;
+    header.mHeaderSize = sizeof(TableImageHeader);
+    header.mTotalSize = size;
+    header.mDeckSize = deck.size();
+    header.mDiscardPileSize = discardPile.size();
+    header.mSeatNum = seatNum;
+    header.mCurrentPlayer = mGameStat->GetCurrentPlayer();
+    header.mFlags = (mGameStat->IsInClockwise() ? TableImageHeader::FLAG_CLOCKWISE : 0)
+        | (mGameStat->DoesGameEnd() ? TableImageHeader::FLAG_GAME_ENDS : 0)
+        | (mGameStat->IsSpecialEffectActive() ? TableImageHeader::FLAG_SPECIAL_EFFECT : 0)
+        | (mIsFlashEffectActive ? TableImageHeader::FLAG_FLASH_ACTIVE : 0)
+        | (mIsPackageEffectActive ? TableImageHeader::FLAG_PACKAGE_ACTIVE : 0);
+    header.mCurrentPhase = static_cast<uint8_t>(mGameStat->GetCurrentPhase());
+    header.mLastPlayedCard = PackedCard::Pack(mGameStat->GetLastPlayedCard());
+    header.mCardsNumToDraw = mGameStat->GetCardsNumToDraw();
+    header.mFlashEffectColor = static_cast<uint8_t>(mFlashEffectColor);
+    header.mFlashCardsPlayed = mFlashCardsPlayed;
+    header.mPackagePlayerIndex = mPackagePlayerIndex;
+    header.mPackageTargetColor = static_cast<uint8_t>(mPackageTargetColor);
+    header.mRandomSeed = mRandom.GetSeed();
+    header.mRandomDraws = mRandom.GetDraws();
+
+    uint8_t *cursor = image.data();
+    std::memcpy(cursor, &header, sizeof(header));
+    cursor += sizeof(header);
+
+    for (int i = 0; i < seatNum; i++) {
+        const auto &stat = mPlayerStats[i];
+        TableImageSeat seat{};
+        std::strncpy(seat.mUsername, stat.GetUsername().c_str(), sizeof(seat.mUsername) - 1);
+        seat.mRemainingHandCardsNum = stat.GetRemainingHandCardsNum();
+        seat.mCharacterType = static_cast<uint8_t>(stat.GetCharacterType());
+        seat.mLastPlayedCard = PackedCard::Pack(stat.GetLastPlayedCard());
+        if (stat.HasCharacter()) {
+            seat.mFlags |= TableImageSeat::FLAG_HAS_CHARACTER;
+            seat.mUsesRemaining = stat.GetCharacter()->GetUsesRemaining();
+            seat.mCooldown = stat.GetCharacter()->GetCooldown();
+            if (stat.GetCharacter()->IsInCooldown()) {
+                seat.mFlags |= TableImageSeat::FLAG_IN_COOLDOWN;
+            }
+        }
+        auto skillUsed = mSkillUsedThisTurn.find(i);
+        if (skillUsed != mSkillUsedThisTurn.end() && skillUsed->second) {
+            seat.mFlags |= TableImageSeat::FLAG_SKILL_USED;
+        }
+        if (std::find(mPlayersAffectedByFlash.begin(), mPlayersAffectedByFlash.end(), i)
+            != mPlayersAffectedByFlash.end()) {
+            seat.mFlags |= TableImageSeat::FLAG_AFFECTED_BY_FLASH;
+        }
+        if (stat.DoPlayInLastRound()) {
+            seat.mFlags |= TableImageSeat::FLAG_PLAYED_IN_LAST_ROUND;
+        }
+        std::memcpy(cursor, &seat, sizeof(seat));
+        cursor += sizeof(seat);
+    }
+
+    for (auto card : deck) {
+        *cursor++ = PackedCard::Pack(card).mCode;
+    }
+    for (auto card : discardPile) {
+        *cursor++ = PackedCard::Pack(card).mCode;
+    }
+}
+
+bool GameBoard::DecodeTable(const uint8_t *data, std::size_t size)
+{
+    // Parse checks every field, so nothing of the table is touched for an image it rejects
+    TableImageView view;
+    if (!view.Parse(data, size)) {
+        UNO_LOG_WARN("rejected a table image of {} bytes", size);
+        return false;
+    }
+    const auto &header = view.GetHeader();
+
+    mDeck->Clear();
+    for (int i = 0; i < header.mDeckSize; i++) {
+        mDeck->PushBack(view.GetDeckCard(i));
+    }
+    mDiscardPile->Clear();
+    for (int i = 0; i < header.mDiscardPileSize; i++) {
+        mDiscardPile->Add(view.GetDiscardPileCard(i));
+    }
+
+    mPlayerNum = header.mSeatNum;
+    mServer->SetPlayerNum(mPlayerNum);
+    Card lastPlayedCard = header.mLastPlayedCard.Unpack();
+    mGameStat.reset(new GameStat(header.mCurrentPlayer, lastPlayedCard, mPlayerNum));
+    mGameStat->SetIsInClockwise(header.mFlags & TableImageHeader::FLAG_CLOCKWISE);
+    mGameStat->SetLastPlayedCard(lastPlayedCard);
+    mGameStat->SetCardsNumToDraw(header.mCardsNumToDraw);
+    mGameStat->SetCurrentPhase(static_cast<GameStat::TurnPhase>(header.mCurrentPhase));
+    mGameStat->SetSpecialEffectActive(header.mFlags & TableImageHeader::FLAG_SPECIAL_EFFECT);
+    if (header.mFlags & TableImageHeader::FLAG_GAME_ENDS) {
+        mGameStat->GameEnds();
+    }
+
+    mIsFlashEffectActive = header.mFlags & TableImageHeader::FLAG_FLASH_ACTIVE;
+    mFlashEffectColor = static_cast<CardColor>(header.mFlashEffectColor);
+    mFlashCardsPlayed = header.mFlashCardsPlayed;
+    mIsPackageEffectActive = header.mFlags & TableImageHeader::FLAG_PACKAGE_ACTIVE;
+    mPackagePlayerIndex = header.mPackagePlayerIndex;
+    mPackageTargetColor = static_cast<CardColor>(header.mPackageTargetColor);
+    mRandom.Restore(header.mRandomSeed, header.mRandomDraws);
+
+    mPlayerStats.clear();
+    mSkillUsedThisTurn.clear();
+    mPlayersAffectedByFlash.clear();
+    for (int i = 0; i < header.mSeatNum; i++) {
+        TableImageSeat seat = view.GetSeat(i);
+        seat.mUsername[sizeof(seat.mUsername) - 1] = '\0';
+        mPlayerStats.emplace_back(seat.mUsername, seat.mRemainingHandCardsNum);
+        mPlayerStats.back().RestoreState(seat.mFlags & TableImageSeat::FLAG_PLAYED_IN_LAST_ROUND,
+            seat.mLastPlayedCard.Unpack());
+        if (seat.mFlags & TableImageSeat::FLAG_HAS_CHARACTER) {
+            auto character = CharacterFactory::CreateCharacter(static_cast<CharacterType>(seat.mCharacterType));
+            if (character) {
+                character->RestoreState(seat.mUsesRemaining, seat.mCooldown,
+                    seat.mFlags & TableImageSeat::FLAG_IN_COOLDOWN);
+                mPlayerStats.back().AssignCharacter(std::move(character));
+            }
+        }
+        mSkillUsedThisTurn[i] = seat.mFlags & TableImageSeat::FLAG_SKILL_USED;
+        if (seat.mFlags & TableImageSeat::FLAG_AFFECTED_BY_FLASH) {
+            mPlayersAffectedByFlash.push_back(i);
+        }
+    }
+    return true;
+}
+
+std::vector<uint8_t> GameBoard::TakeSnapshot() const
+{
+    std::vector<uint8_t> image;
+    EncodeTable(image);
+    return image;
+}
+
+void GameBoard::Replay(const JournalRecord &record)
+{
+    int player = record.mPlayer;
+    Card card{static_cast<CardColor>(record.mColor), static_cast<CardText>(record.mText)};
+
+    switch (record.mType) {
+        case JournalEventType::DEAL:
+            // dealing is covered by the snapshot taken right after it
+            break;
+        case JournalEventType::DRAW:
+            if (!(record.mArg2 & DRAW_FLAG_NO_DECK)) {
+                DrawFromDeck(record.mArg);
+            }
+            mPlayerStats[player].UpdateAfterDraw(record.mArg);
+            if (record.mArg2 & DRAW_FLAG_PENALTY) {
+                mGameStat->UpdateAfterDraw();
+            }
+            break;
+        case JournalEventType::SKIP:
+            mPlayerStats[player].UpdateAfterSkip();
+            mGameStat->UpdateAfterSkip();
+            break;
+        case JournalEventType::PLAY:
+            if (record.mArg2 == PLAY_FLASH_ANSWER) {
+                PlayFlashAnswer(player, card);
+                break;
+            }
+            mDiscardPile->Add(card);
+            if (card.mColor == CardColor::BLACK) {
+                card.mColor = static_cast<CardColor>(record.mArg);
+            }
+            mPlayerStats[player].UpdateAfterPlay(card);
+            if (mPlayerStats[player].GetRemainingHandCardsNum() == 0) {
+                mGameStat->GameEnds();
+            }
+            mGameStat->UpdateAfterPlay(card);
+            break;
+        case JournalEventType::SKILL:
+            switch (static_cast<CharacterType>(record.mArg)) {
+                case CharacterType::LUCKY_STAR:
+                    if (!PickWithLuckyStar(record.mArg2).empty()) {
+                        mPlayerStats[player].UpdateAfterDraw(1);
+                    }
+                    mPlayerStats[player].UseSkill();
+                    break;
+                case CharacterType::COLLECTOR:
+                    PickWithCollector();
+                    mPlayerStats[player].UpdateAfterDraw(1);
+                    mPlayerStats[player].UseSkill();
+                    break;
+                case CharacterType::THIEF:
+                    if (!ProcessDefenderSkill(record.mArg2)) {
+                        mPlayerStats[player].UseSkill();
+                    }
+                    break;
+                default:
+                    break;
+            }
+            mSkillUsedThisTurn[player] = true;
+            break;
+        case JournalEventType::EFFECT:
+            mGameStat->SetSpecialEffectActive(true);
+            if (card.mText == CardText::PACKAGE) {
+                mIsPackageEffectActive = true;
+                mPackagePlayerIndex = player;
+                mPackageTargetColor = card.mColor;
+            }
+            else if (card.mText == CardText::FLASH) {
+                mIsFlashEffectActive = true;
+                mFlashEffectColor = card.mColor;
+                mFlashCardsPlayed = 0;
+                mPlayersAffectedByFlash.clear();
+            }
+            break;
+        case JournalEventType::PHASE: {
+            auto phase = static_cast<GameStat::TurnPhase>(record.mArg);
+            mGameStat->SetCurrentPhase(phase);
+            if (phase == GameStat::TurnPhase::START) {
+                mSkillUsedThisTurn[player] = false;
+            }
+            else if (phase == GameStat::TurnPhase::END) {
+                // the most general rules, what a table's rules lack has never been journaled
+                HandleTurnEnd<CustomRules>();
+            }
+            break;
+        }
+    }
+}
+
 }}
@@ -5,23 +5,94 @@
 #include <deque>
 #include <cstdlib>
 #include <map>
+#include <chrono>
+#include <mutex>
 
 #include "stat.h"
 #include "cards.h"
+#include "indexed_discard_pile.h"
+#include "journal.h"
+#include "table_image.h"
+#include "rules.h"
+#include "../common/random.h"
+#include "../common/metrics.h"
 #include "../network/server.h"
 
+namespace UNO { namespace Common {
+struct GameConfigInfo;
+}}
+
 namespace UNO { namespace Game {
 
 using namespace Network;
 
 class GameBoard {
 public:
-    explicit GameBoard(std::shared_ptr<Network::IServer> serverSp);
+    /**
+     * \param mode: rules the table is played with, fixed for the table's lifetime
+     */
+    explicit GameBoard(std::shared_ptr<Network::IServer> serverSp,
+        Common::Common::GameMode mode = Common::Common::mGameMode);
+
+    ~GameBoard();
 
     void Start();
 
     static std::shared_ptr<Network::IServer> CreateServer(const std::string &port);
 
+    /**
+     * The server side of the program: create the server and a table on it, recover the
+     * table from the journal or start journaling it if one is configured, start dumping
+     * the metrics if a path is given for them, and run. It returns when the server stops.
+     */
+    static void RunServer(const Common::GameConfigInfo &configInfo);
+
+    /**
+     * Append every state transition of the table to the journal at \p path.
+     */
+    void EnableJournal(const std::string &path);
+
+    /**
+     * Rebuild the table from the latest snapshot at \p path and replay the records
+     * appended after it, then keep journaling to the same path.
+     *   \return false if there is nothing to recover from
+     */
+    bool Recover(const std::string &path);
+
+    /**
+     * Write the image of the whole table to \p path, see table_image.h.
+     */
+    void DumpTable(const std::string &path) const;
+
+    /**
+     * Restore the table from an image written by \c DumpTable, possibly in another process.
+     * The game resumes instead of starting over once all players have reattached.
+     *   \return false if \p path does not hold an image this version can read
+     */
+    bool RestoreTable(const std::string &path);
+
+    /**
+     * Dump the table to \p path at the end of the current turn and stop running it,
+     * so that it can be restored on another host. Safe to call from any thread.
+     */
+    void RequestMigration(const std::string &path);
+
+    /**
+     * Fire the Lucky Star skill of \p playerIndex: spend a use and offer the top 3 cards
+     * of deck, which stay in place until the player takes one with \c TakeLuckyStarCard.
+     *   \return the offered cards, the top first, nothing if the deck is empty
+     */
+    const std::vector<Card> &OfferLuckyStar(int playerIndex);
+
+    /**
+     * Give the offered card at \p index to the player the offer was made to, an index out
+     * of the offer takes the top one, and withdraw the offer.
+     */
+    void TakeLuckyStarCard(int index);
+
+    // the cards offered by a Lucky Star that has fired and not chosen yet, nothing otherwise
+    const std::vector<Card> &GetLuckyStarOffer() const { return mLuckyStarOffer; }
+
 private:
     /**
      * Callback of receiving a \c JoinGameInfo from a player.
@@ -36,13 +107,64 @@ private:
     void StartGame();
 
     /**
-     * Main game loop, wait for \c ActionInfo from players and act accordingly.
+     * Fill the deck with a shoe of \c Common::mDeckNum standard decks and deal
+     * \c Common::mInitHandCardsNum cards to each player.
+     *   \return the initial hand cards of each player
+     */
+    std::vector<std::vector<Card>> DealFromShoe();
+
+    /**
+     * All players have reattached to a restored table, continue the game from where it was.
+     */
+    void ResumeGame();
+
+    /**
+     * Run \c GameLoop as a coroutine on the server's executor.
+     */
+    void SpawnGameLoop();
+
+    /**
+     * Main game loop, play turns until the game ends or the table is migrated.
+     */
+    asio::awaitable<void> GameLoop();
+
+    /**
+     * Play a turn through its phases, suspending whenever the current player is awaited.
+     * Instantiated once per rules policy, see rules.h.
+     */
+    template <typename Rules>
+    asio::awaitable<void> PlayTurn();
+
+    /**
+     * Make the table play its turns with \c Rules.
+     */
+    template <typename Rules>
+    void UseRules();
+
+    /**
+     * Suspend until \c InfoT arrives from player \p index. A player who does not answer
+     * within the turn's timeout plus a grace period is considered disconnected.
      */
-    void GameLoop();
+    template <typename InfoT>
+    asio::awaitable<std::unique_ptr<InfoT>> AsyncReceive(int index) {
+        auto timeout = std::chrono::seconds(Common::Common::mTimeoutPerTurn + DEADLINE_GRACE_SECONDS);
+        co_return Common::Util::DynamicCast<InfoT>(
+            co_await mServer->AsyncReceiveInfo(&typeid(InfoT), index, timeout));
+    }
+
+    /**
+     * Suspend until \c InfoT has arrived from each of \p indexes, receiving from all of them
+     * concurrently under a single deadline \p timeout from now.
+     *   \return the info of each index in order, nullptr for a player who has not answered in time
+     */
+    template <typename InfoT>
+    asio::awaitable<std::vector<std::unique_ptr<InfoT>>> AsyncReceiveAll(
+        const std::vector<int> &indexes, std::chrono::steady_clock::duration timeout);
     
     /**
      * Handle a \c DrawInfo from player.
      */
+    template <typename Rules>
     void HandleDraw(const std::unique_ptr<DrawInfo> &info);
     
     /**
@@ -53,6 +175,7 @@ private:
     /**
      * Handle a \c PlayInfo from player.
      */
+    template <typename Rules>
     void HandlePlay(const std::unique_ptr<PlayInfo> &info);
 
     /**
@@ -63,6 +186,7 @@ private:
     /**
      * Handle turn end phase.
      */
+    template <typename Rules>
     void HandleTurnEnd();
 
     /**
@@ -78,7 +202,13 @@ private:
     /**
      * Handle Flash Card effect.
      */
-    void HandleFlashCardEffect(int playerIndex, CardColor chosenColor);
+    asio::awaitable<void> HandleFlashCardEffect(int playerIndex, CardColor chosenColor);
+
+    /**
+     * Put the card a player answered a Flash prompt with onto the discard pile. It is played
+     * out of turn, so the turn does not move on, but it becomes the card to match.
+     */
+    void PlayFlashAnswer(int playerIndex, Card card);
 
     /**
      * Handle character skills.
@@ -86,7 +216,7 @@ private:
     void HandleCharacterSkill(int playerIndex, CharacterType skillType, int targetPlayer = -1, CardText cardType = CardText::EMPTY);
 
     /**
-     * Process Lucky Star skill.
+     * Process Lucky Star skill. No choice is asked from the client yet, so the top card is taken.
      */
     void ProcessLuckyStarSkill(int playerIndex);
 
@@ -115,15 +245,68 @@ private:
      */
     void ResetGame();
 
+    /**
+     * Append a record to the journal, if journaling is enabled.
+     */
+    void Record(JournalEventType type, int player, Card card = {}, int arg = 0, int arg2 = -1);
+
+    /**
+     * Snapshot the table if it is due, called once per turn.
+     */
+    void CheckpointJournal();
+
+    /**
+     * Encode the state of the table into \p image, see table_image.h.
+     */
+    void EncodeTable(std::vector<uint8_t> &image) const;
+
+    /**
+     * Overwrite the state of the table with an image.
+     *   \return false if \p data does not hold an image this version can read
+     */
+    bool DecodeTable(const uint8_t *data, std::size_t size);
+
+    std::vector<uint8_t> TakeSnapshot() const;
+
+    /**
+     * Apply a journal record to the state, without any network interaction.
+     */
+    void Replay(const JournalRecord &record);
+
+    /**
+     * Draw from deck, and remember to snapshot if the draw has reshuffled the deck,
+     * since the new order cannot be reproduced by replay.
+     */
+    std::vector<Card> DrawFromDeck(int number);
+
+    /**
+     * Take the card \p chosenIndex of the top 3 cards of deck, the others stay on the top
+     * in their order, an index out of them takes the top one.
+     *   \return the chosen card, or nothing if the deck is empty
+     */
+    std::vector<Card> PickWithLuckyStar(int chosenIndex);
+
+    /**
+     * Take the chosen card from below the top of the discard pile.
+     *   \return the chosen card, or nothing if the top is the only card
+     */
+    std::vector<Card> PickWithCollector();
+
+    /**
+     * Take the card \p index cards below the top of deck (0 is the top, at most 2)
+     * without moving the rest. The deck must have more than \p index cards.
+     */
+    Card ExtractFromDeck(int index);
+
     /**
      * Broadcast info to players other than the current one.
      */
     template <typename ActionInfoT>
     void Broadcast(ActionInfoT &info) {
         int currentPlayer = mGameStat->GetCurrentPlayer();
-        for (int i = 0; i < Common::Common::mPlayerNum; i++) {
+        for (int i = 0; i < mPlayerNum; i++) {
             if (i != currentPlayer) {
-                info.mPlayerIndex = Common::Util::WrapWithPlayerNum(currentPlayer - i);
+                info.mPlayerIndex = Common::Util::Wrap(currentPlayer - i, mPlayerNum);
                 mServer->DeliverInfo(&typeid(ActionInfoT), i, info);
             }
         }
@@ -151,7 +334,7 @@ private:
 
 public:
     // for tests
-    const std::unique_ptr<DiscardPile> &GetDiscardPile() const { return mDiscardPile; }
+    const std::unique_ptr<IndexedDiscardPile> &GetDiscardPile() const { return mDiscardPile; }
 
     const std::unique_ptr<Deck> &GetDeck() const { return mDeck; }
 
@@ -159,11 +342,46 @@ public:
 
     const std::vector<PlayerStat> &GetPlayerStats() const { return mPlayerStats; }
 
+    template <typename Rules>
+    bool PlaysWith() const { return mPlayTurn == &GameBoard::PlayTurn<Rules>; }
+
+private:
+    /**
+     * Metrics recorded by a table, looked up from the registry once. The process-wide
+     * ones are shared by all tables, the rest are labeled with the table's id.
+     */
+    struct TableMetrics {
+        explicit TableMetrics(int tableId);
+
+        ~TableMetrics();
+
+        const std::string mTableLabel;
+
+        // process-wide
+        Common::Histogram *mPhaseDuration[4];  // indexed by GameStat::TurnPhase
+        Common::Histogram *mClientWait;
+        Common::Histogram *mProcessing;
+        Common::Histogram *mDrawStackSize;
+        Common::Counter *mReshuffles;
+        Common::Counter *mSkillActivations[4];  // indexed by CharacterType
+
+        // of this table
+        Common::Counter *mTurns;
+        Common::Histogram *mTableClientWait;
+    };
+
 private:
     std::shared_ptr<Network::IServer> mServer;
 
+    // rules of the table, and the turn instantiated for them
+    const Common::Common::GameMode mMode;
+    asio::awaitable<void> (GameBoard::*mPlayTurn)();
+    bool mAssignsCharacters;
+    // seats of the table, which a restored table takes from its image
+    int mPlayerNum;
+
     // state of game board
-    std::unique_ptr<DiscardPile> mDiscardPile;
+    std::unique_ptr<IndexedDiscardPile> mDiscardPile;
     std::unique_ptr<Deck> mDeck;
     std::unique_ptr<GameStat> mGameStat;
 
@@ -178,10 +396,44 @@ private:
 
     // Skill usage tracking
     std::map<int, bool> mSkillUsedThisTurn;
+
+    // the pending offer of a Lucky Star, see OfferLuckyStar
+    int mLuckyStarPlayer{-1};
+    std::vector<Card> mLuckyStarOffer;
     
     // 新增：Package Card效果状态
     bool mIsPackageEffectActive{false};
     int mPackagePlayerIndex{-1};
     CardColor mPackageTargetColor{CardColor::RED};
+
+    TableMetrics mMetrics;
+
+    // random engine of the table, its state is part of the image
+    Common::Random mRandom;
+
+    // the table has been restored from an image or a journal and waits for players to reattach
+    bool mIsRestored{false};
+
+    // set by RequestMigration, the table is dumped to it at the end of the turn
+    std::mutex mMigrationMutex;
+    std::string mMigrationPath;
+
+    // journal of state transitions, nullptr if journaling is disabled
+    std::unique_ptr<Journal> mJournal;
+    bool mSnapshotDue{false};
+
+    // Lucky Star views this many cards on the top of deck
+    constexpr static int LUCKY_STAR_VIEW_NUM = 3;
+    // flags of a DRAW record
+    constexpr static int DRAW_FLAG_PENALTY = 1;  // the draw consumes the turn's draw penalty
+    constexpr static int DRAW_FLAG_NO_DECK = 2;  // the cards have been taken by a skill already
+    // mArg2 of a PLAY record whose card answered a Flash prompt, -1 for an ordinary play
+    constexpr static int PLAY_FLASH_ANSWER = 1;
+    // snapshot the table every SNAPSHOT_INTERVAL records at most
+    constexpr static int SNAPSHOT_INTERVAL = 64;
+    // the client gives up a turn after mTimeoutPerTurn by itself, the server waits a bit longer
+    constexpr static int DEADLINE_GRACE_SECONDS = 5;
+    // how often the metrics are dumped if the server is given a path for them
+    constexpr static int METRICS_DUMP_SECONDS = 5;
 };
 }}
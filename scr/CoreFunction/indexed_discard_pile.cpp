@@ -0,0 +1,90 @@
+#include <cassert>
+
+#include "indexed_discard_pile.h"
+#include "card_view.h"
+
+namespace UNO { namespace Game {
+
+IndexedDiscardPile::IndexedDiscardPile()
+{
+    // a pile rarely holds more than a couple of cards of a key, so this is the
+    // only allocation of the index in the common case
+    for (auto &positions : mPositions) {
+        positions.reserve(4);
+    }
+}
+
+int IndexedDiscardPile::KeyOf(Card card)
+{
+    return ToCode(card).ToByte();
+}
+
+void IndexedDiscardPile::Add(Card card)
+{
+    DiscardPile::Add(card);
+    auto &positions = mPositions[KeyOf(card)];
+    positions.push_back(mSlots.size());
+    mSlots.push_back(positions.size() - 1);
+}
+
+void IndexedDiscardPile::Clear()
+{
+    DiscardPile::Clear();
+    for (auto &positions : mPositions) {
+        positions.clear();
+    }
+    mSlots.clear();
+}
+
+int IndexedDiscardPile::Count(CardColor color, CardText text) const
+{
+    return mPositions[KeyOf(Card{color, text})].size();
+}
+
+int IndexedDiscardPile::Find(CardColor color, CardText text) const
+{
+    int top = static_cast<int>(mSlots.size()) - 1;
+    const auto &positions = mPositions[KeyOf(Card{color, text})];
+    for (auto it = positions.rbegin(); it != positions.rend(); ++it) {
+        if (static_cast<int>(*it) != top) {
+            return *it;
+        }
+    }
+    return -1;
+}
+
+Card IndexedDiscardPile::TakeAt(int position)
+{
+    assert(position >= 0 && position + 1 < static_cast<int>(mSlots.size()));
+
+    Card card = mPile[position];
+    // drop it from the list of its key, keeping the list in the order the cards were added
+    auto &positions = mPositions[KeyOf(card)];
+    uint32_t slot = mSlots[position];
+    positions.erase(positions.begin() + slot);
+    for (uint32_t i = slot; i < positions.size(); i++) {
+        mSlots[positions[i]] = i;
+    }
+
+    // the cards above move down by one
+    mPile.erase(mPile.begin() + position);
+    mSlots.erase(mSlots.begin() + position);
+    for (int i = position; i < static_cast<int>(mSlots.size()); i++) {
+        mPositions[KeyOf(mPile[i])][mSlots[i]]--;
+    }
+    return card;
+}
+
+void IndexedDiscardPile::Reindex()
+{
+    for (auto &positions : mPositions) {
+        positions.clear();
+    }
+    mSlots.clear();
+    for (Card card : GetPile()) {
+        auto &positions = mPositions[KeyOf(card)];
+        positions.push_back(mSlots.size());
+        mSlots.push_back(positions.size() - 1);
+    }
+}
+}}
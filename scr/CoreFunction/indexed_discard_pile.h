@@ -0,0 +1,83 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <ranges>
+#include <vector>
+
+#include "cards.h"
+
+namespace UNO { namespace Game {
+
+/**
+ * A discard pile that also indexes its cards by (color, text), for the Collector.
+ *
+ * Cards stay in the base pile, so the deck refills from it as before. The index keeps
+ * the positions of the cards of each (color, text) in the order they were added,
+ * along with a back pointer from each position into its list. A card other than the
+ * top one is taken out in place, so the rest of the pile keeps its order; only the
+ * entries of the cards above it are renumbered, which is cheap as the Collector
+ * usually takes a card near the top.
+ *
+ * The base pile is private so that every change goes through the index. The deck is
+ * the only exception, as it takes cards out of the base pile on its own when it
+ * refills, and Reindex() has to be called after each refill.
+ */
+class IndexedDiscardPile : private DiscardPile {
+public:
+    IndexedDiscardPile();
+
+    using DiscardPile::GetPile;
+
+    /**
+     * \return the base pile, only for the deck to refill from
+     */
+    DiscardPile &RefillSource() { return *this; }
+
+    void Add(Card card);
+
+    void Clear();
+
+    /**
+     * \return the number of cards of \p color and \p text in the pile, the top one included
+     */
+    int Count(CardColor color, CardText text) const;
+
+    /**
+     * \return the position of the latest card of \p color and \p text below the top,
+     *   where 0 is the bottom, or -1 if there is none
+     */
+    int Find(CardColor color, CardText text) const;
+
+    /**
+     * The cards that can be taken, i.e. all but the top one, bottom first. It is a view
+     * of the pile itself and is invalidated by the next change of the pile.
+     */
+    auto Candidates() const {
+        const auto &pile = GetPile();
+        return std::ranges::subrange(pile.begin(), pile.empty() ? pile.end() : pile.end() - 1);
+    }
+
+    /**
+     * Take out the card at \p position, which must be below the top. The other cards
+     * keep their order, and those above it move down by one.
+     */
+    Card TakeAt(int position);
+
+    /**
+     * Rebuild the index from the pile after the deck has refilled from it.
+     */
+    void Reindex();
+
+private:
+    static int KeyOf(Card card);
+
+private:
+    constexpr static int KEY_NUM = 256;  // a key is the one-byte code of a card
+
+    // positions of the cards of each key, in the order they were added
+    std::array<std::vector<uint32_t>, KEY_NUM> mPositions;
+    // for each position of the pile, its index in the list of its key
+    std::vector<uint32_t> mSlots;
+};
+}}
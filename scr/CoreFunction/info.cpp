@@ -1,4 +1,5 @@
 #include "info.h"
+#include "card_view.h"
 
 namespace UNO { namespace Game {
 
@@ -53,9 +54,6 @@ std::unique_ptr<JoinGameRspInfo> JoinGameRspInfo::Deserialize(const uint8_t *buf
 
 void GameStartInfo::Serialize(uint8_t *buffer) const
 {
-    GameStartMsg *msg = reinterpret_cast<GameStartMsg *>(buffer);
-    msg->mType = MsgType::GAME_START;
-
     std::string usernames{};
     std::for_each(mUsernames.begin(), mUsernames.end(),
         [&usernames](const std::string &username) {
@@ -69,15 +67,23 @@ void GameStartInfo::Serialize(uint8_t *buffer) const
         characterTypes.append(std::to_string(static_cast<int>(charType))).push_back(' ');
     }
 
-    msg->mLen = sizeof(Card) * 8 + sizeof(int) + usernames.size() + characterTypes.size();
-
-    std::copy(mInitHandCards.begin(), mInitHandCards.end(), msg->mInitHandCards);
-    msg->mFlippedCard = mFlippedCard;
-    msg->mFirstPlayer = mFirstPlayer;
-    
     // 合并用户名和角色类型信息
     std::string combinedInfo = usernames + "|" + characterTypes;
-    std::strcpy(msg->mUsernames, combinedInfo.c_str());
+    int len = sizeof(GameStartMsg) - sizeof(Msg) + mInitHandCards.size() + combinedInfo.size() + 1;
+    if (sizeof(Msg) + len > Common::Common::MAX_MSG_SIZE) {
+        throw std::length_error("GameStartMsg of " + std::to_string(sizeof(Msg) + len) + " bytes exceeds "
+            + std::to_string(Common::Common::MAX_MSG_SIZE));
+    }
+
+    GameStartMsg *msg = reinterpret_cast<GameStartMsg *>(buffer);
+    msg->mType = MsgType::GAME_START;
+    msg->mLen = len;
+
+    msg->mFlippedCard = ToCode(mFlippedCard);
+    msg->mFirstPlayer = mFirstPlayer;
+    msg->mInitHandCardsNum = mInitHandCards.size();
+    ToCodes(mInitHandCards.data(), mInitHandCards.size(), reinterpret_cast<Common::CardCode *>(msg->mPayload));
+    std::strcpy(msg->mPayload + mInitHandCards.size(), combinedInfo.c_str());
 }
 
 std::unique_ptr<GameStartInfo> GameStartInfo::Deserialize(const uint8_t *buffer)
@@ -85,12 +91,13 @@ std::unique_ptr<GameStartInfo> GameStartInfo::Deserialize(const uint8_t *buffer)
     const GameStartMsg *msg = reinterpret_cast<const GameStartMsg *>(buffer);
     std::unique_ptr<GameStartInfo> info = std::make_unique<GameStartInfo>();
 
-    std::copy(std::begin(msg->mInitHandCards), std::end(msg->mInitHandCards),
-            info->mInitHandCards.begin());
-    info->mFlippedCard = msg->mFlippedCard;
+    info->mFlippedCard = FromCode(msg->mFlippedCard);
     info->mFirstPlayer = msg->mFirstPlayer;
+    info->mInitHandCards.resize(msg->mInitHandCardsNum);
+    FromCodes(reinterpret_cast<const Common::CardCode *>(msg->mPayload), info->mInitHandCards.size(),
+        info->mInitHandCards.data());
     
-    std::string combinedInfo(msg->mUsernames);
+    std::string combinedInfo(msg->mPayload + msg->mInitHandCardsNum);
     // 分离用户名和角色类型信息
     size_t separatorPos = combinedInfo.find('|');
     std::string usernames = combinedInfo.substr(0, separatorPos);
@@ -122,6 +129,14 @@ std::unique_ptr<GameStartInfo> GameStartInfo::Deserialize(const uint8_t *buffer)
     return info;
 }
 
+int GameStartInfo::MaxSize(int playerNum, int initHandCardsNum)
+{
+    // a username and a character type with a delimiter each per seat, then '|' and '\0'
+    constexpr int maxCharacterTypeLen = 1;
+    return sizeof(GameStartMsg) + initHandCardsNum
+        + playerNum * (Common::Common::MAX_USERNAME_LEN + 1 + maxCharacterTypeLen + 1) + 2;
+}
+
 void ActionInfo::Serialize(uint8_t *buffer) const
 {
     ActionMsg *msg = reinterpret_cast<ActionMsg *>(buffer);
@@ -189,7 +204,7 @@ void PlayInfo::Serialize(uint8_t *buffer) const
     ActionInfo::Serialize(buffer);
     PlayMsg *msg = reinterpret_cast<PlayMsg *>(buffer);
     msg->mLen = sizeof(PlayMsg) - sizeof(Msg);
-    msg->mCard = mCard;
+    msg->mCard = ToCode(mCard);
     msg->mNextColor = mNextColor;
 }
 
@@ -197,7 +212,7 @@ std::unique_ptr<PlayInfo> PlayInfo::Deserialize(const uint8_t *buffer)
 {
     const PlayMsg *msg = reinterpret_cast<const PlayMsg *>(buffer);
     std::unique_ptr<PlayInfo> info = std::make_unique<PlayInfo>();
-    info->mCard = msg->mCard;
+    info->mCard = FromCode(msg->mCard);
     info->mNextColor = msg->mNextColor;
     return info;
 }
@@ -207,10 +222,10 @@ void DrawRspInfo::Serialize(uint8_t *buffer) const
     DrawRspMsg *msg = reinterpret_cast<DrawRspMsg *>(buffer);
     msg->mType = MsgType::DRAW_RSP;
 
-    msg->mLen = sizeof(int) + mNumber * sizeof(Card);
+    msg->mLen = sizeof(int) + mNumber * sizeof(Common::CardCode);
     msg->mNumber = mNumber;
 
-    std::copy(mCards.begin(), mCards.end(), msg->mCards);
+    ToCodes(mCards.data(), mCards.size(), msg->mCards);
 }
 
 std::unique_ptr<DrawRspInfo> DrawRspInfo::Deserialize(const uint8_t *buffer)
@@ -219,7 +234,7 @@ std::unique_ptr<DrawRspInfo> DrawRspInfo::Deserialize(const uint8_t *buffer)
     std::unique_ptr<DrawRspInfo> info = std::make_unique<DrawRspInfo>();
     info->mNumber = msg->mNumber;
     info->mCards.resize(info->mNumber);
-    std::copy(msg->mCards, msg->mCards + msg->mNumber, info->mCards.begin());
+    FromCodes(msg->mCards, msg->mNumber, info->mCards.data());
     return info;
 }
 
@@ -267,11 +282,11 @@ void SkillRspInfo::Serialize(uint8_t *buffer) const
 {
     SkillRspMsg *msg = reinterpret_cast<SkillRspMsg *>(buffer);
     msg->mType = MsgType::SKILL_RSP;
-    msg->mLen = sizeof(SkillRspMsg) - sizeof(Msg) + mAffectedCards.size() * sizeof(Card);
+    msg->mLen = sizeof(SkillRspMsg) - sizeof(Msg) + mAffectedCards.size() * sizeof(Common::CardCode);
     msg->mPlayerIndex = mPlayerIndex;
     msg->mSuccess = mSuccess;
     msg->mAffectedCardsCount = mAffectedCards.size();
-    std::copy(mAffectedCards.begin(), mAffectedCards.end(), msg->mAffectedCards);
+    ToCodes(mAffectedCards.data(), mAffectedCards.size(), msg->mAffectedCards);
 }
 
 std::unique_ptr<SkillRspInfo> SkillRspInfo::Deserialize(const uint8_t *buffer)
@@ -281,8 +296,7 @@ std::unique_ptr<SkillRspInfo> SkillRspInfo::Deserialize(const uint8_t *buffer)
     info->mPlayerIndex = msg->mPlayerIndex;
     info->mSuccess = msg->mSuccess;
     info->mAffectedCards.resize(msg->mAffectedCardsCount);
-    std::copy(msg->mAffectedCards, msg->mAffectedCards + msg->mAffectedCardsCount, 
-              info->mAffectedCards.begin());
+    FromCodes(msg->mAffectedCards, msg->mAffectedCardsCount, info->mAffectedCards.data());
     return info;
 }
 
@@ -295,6 +309,7 @@ void SpecialEffectInfo::Serialize(uint8_t *buffer) const
     msg->mPlayerIndex = mPlayerIndex;
     msg->mEffectType = static_cast<int>(mEffectType);
     msg->mTargetColor = static_cast<int>(mTargetColor);
+    msg->mCard = ToCode(mCard);
     msg->mAffectedPlayersCount = mAffectedPlayers.size();
     std::copy(mAffectedPlayers.begin(), mAffectedPlayers.end(), msg->mAffectedPlayers);
 }
@@ -306,6 +321,7 @@ std::unique_ptr<SpecialEffectInfo> SpecialEffectInfo::Deserialize(const uint8_t
     info->mPlayerIndex = msg->mPlayerIndex;
     info->mEffectType = static_cast<CardText>(msg->mEffectType);
     info->mTargetColor = static_cast<CardColor>(msg->mTargetColor);
+    info->mCard = FromCode(msg->mCard);
     info->mAffectedPlayers.resize(msg->mAffectedPlayersCount);
     std::copy(msg->mAffectedPlayers, msg->mAffectedPlayers + msg->mAffectedPlayersCount,
               info->mAffectedPlayers.begin());
@@ -321,7 +337,7 @@ void GameStateUpdateInfo::Serialize(uint8_t *buffer) const
     msg->mCurrentPlayer = mCurrentPlayer;
     msg->mCurrentPhase = static_cast<int>(mCurrentPhase);
     msg->mSpecialEffectActive = mSpecialEffectActive;
-    msg->mLastPlayedCard = mLastPlayedCard;
+    msg->mLastPlayedCard = ToCode(mLastPlayedCard);
     msg->mCardsNumToDraw = mCardsNumToDraw;
 }
 
@@ -332,7 +348,7 @@ std::unique_ptr<GameStateUpdateInfo> GameStateUpdateInfo::Deserialize(const uint
     info->mCurrentPlayer = msg->mCurrentPlayer;
     info->mCurrentPhase = static_cast<GameStat::TurnPhase>(msg->mCurrentPhase);
     info->mSpecialEffectActive = msg->mSpecialEffectActive;
-    info->mLastPlayedCard = msg->mLastPlayedCard;
+    info->mLastPlayedCard = FromCode(msg->mLastPlayedCard);
     info->mCardsNumToDraw = msg->mCardsNumToDraw;
     return info;
 }
@@ -405,7 +421,8 @@ bool SkillRspInfo::operator==(const SkillRspInfo &info) const
 bool SpecialEffectInfo::operator==(const SpecialEffectInfo &info) const
 {
     return (mPlayerIndex == info.mPlayerIndex) && (mEffectType == info.mEffectType)
-        && (mTargetColor == info.mTargetColor) && (mAffectedPlayers == info.mAffectedPlayers);
+        && (mTargetColor == info.mTargetColor) && (mCard == info.mCard)
+        && (mAffectedPlayers == info.mAffectedPlayers);
 }
 
 // 新增：GameStateUpdateInfo 操作符重载
@@ -441,10 +458,10 @@ std::ostream& operator<<(std::ostream& os, const GameStartInfo& info)
 {
     os << "GameStartInfo Received: " << std::endl;
     os << "\t mInitHandCards: [";
-    for (int i = 0; i < 6; i++) {
-        os << info.mInitHandCards[i] << ", ";
+    for (std::size_t i = 0; i < info.mInitHandCards.size(); i++) {
+        os << (i > 0 ? ", " : "") << info.mInitHandCards[i];
     }
-    os << info.mInitHandCards[6] << "]" << std::endl;
+    os << "]" << std::endl;
 
     os << "\t mFlippedCard: " << info.mFlippedCard << std::endl;
     os << "\t mFirstPlayer: " << info.mFirstPlayer << std::endl;
@@ -550,6 +567,7 @@ std::ostream& operator<<(std::ostream& os, const SpecialEffectInfo& info)
     os << "\t mPlayerIndex: " << info.mPlayerIndex << std::endl;
     os << "\t mEffectType: " << static_cast<int>(info.mEffectType) << std::endl;
     os << "\t mTargetColor: " << static_cast<int>(info.mTargetColor) << std::endl;
+    os << "\t mCard: " << info.mCard << std::endl;
     os << "\t mAffectedPlayers: [";
     if (!info.mAffectedPlayers.empty()) {
         for (int i = 0; i < info.mAffectedPlayers.size() - 1; i++) {
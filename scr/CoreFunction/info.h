@@ -14,12 +14,18 @@ namespace UNO { namespace Game {
 
 using namespace Network;
 
+/**
+ * Each info names the type of message it travels as in MSG_TYPE,
+ * the derived infos of \c ActionInfo all travel as ACTION.
+ */
 struct Info {
     // enable polymorphism
     virtual ~Info() {}
 };
 
 struct JoinGameInfo : public Info {
+    constexpr static MsgType MSG_TYPE = MsgType::JOIN_GAME;
+
     std::string mUsername;
 
     JoinGameInfo() {}
@@ -33,6 +39,8 @@ struct JoinGameInfo : public Info {
 };
 
 struct JoinGameRspInfo : public Info {
+    constexpr static MsgType MSG_TYPE = MsgType::JOIN_GAME_RSP;
+
     int mPlayerNum;
     std::vector<std::string> mUsernames;
 
@@ -48,28 +56,39 @@ struct JoinGameRspInfo : public Info {
 };
 
 struct GameStartInfo : public Info {
-    std::array<Card, 7> mInitHandCards;
+    constexpr static MsgType MSG_TYPE = MsgType::GAME_START;
+
+    std::vector<Card> mInitHandCards;
     Card mFlippedCard;
     int mFirstPlayer;
     std::vector<std::string> mUsernames;
     std::vector<CharacterType> mCharacterTypes;  // 新增：角色类型信息
 
     GameStartInfo() {}
-    GameStartInfo(const std::array<Card, 7> &initHandCards,
+    GameStartInfo(const std::vector<Card> &initHandCards,
         Card flippedCard, int firstPlayer,
         const std::vector<std::string> &usernames,
         const std::vector<CharacterType> &characterTypes = {})  // 新增：角色类型参数
         : mInitHandCards(initHandCards), mFlippedCard(flippedCard),
         mFirstPlayer(firstPlayer), mUsernames(usernames), mCharacterTypes(characterTypes) {}
 
+    /**
+     * Throws std::length_error without touching \p buffer if the message would not fit
+     * MAX_MSG_SIZE, see \c MaxSize.
+     */
     void Serialize(uint8_t *buffer) const;
     static std::unique_ptr<GameStartInfo> Deserialize(const uint8_t *buffer);
 
+    // the largest message for a table of playerNum seats whose usernames have the longest length
+    static int MaxSize(int playerNum, int initHandCardsNum);
+
     bool operator==(const GameStartInfo &info) const;
     friend std::ostream& operator<<(std::ostream& os, const GameStartInfo& info);
 };
 
 struct ActionInfo : public Info {
+    constexpr static MsgType MSG_TYPE = MsgType::ACTION;
+
     ActionType mActionType;
     int mPlayerIndex{-1};
 
@@ -126,6 +145,8 @@ struct PlayInfo : public ActionInfo {
 };
 
 struct DrawRspInfo : public Info {
+    constexpr static MsgType MSG_TYPE = MsgType::DRAW_RSP;
+
     int mNumber;
     std::vector<Card> mCards;
 
@@ -141,6 +162,8 @@ struct DrawRspInfo : public Info {
 };
 
 struct GameEndInfo : public Info {
+    constexpr static MsgType MSG_TYPE = MsgType::GAME_END;
+
     int mWinner;
 
     GameEndInfo() {}
@@ -154,6 +177,8 @@ struct GameEndInfo : public Info {
 
 // 新增：技能使用信息
 struct SkillUseInfo : public Info {
+    constexpr static MsgType MSG_TYPE = MsgType::SKILL_USE;
+
     int mPlayerIndex;
     CharacterType mSkillType;
     int mTargetPlayer;  // 对于需要目标的技能（如Thief）
@@ -174,6 +199,8 @@ struct SkillUseInfo : public Info {
 
 // 新增：技能响应信息
 struct SkillRspInfo : public Info {
+    constexpr static MsgType MSG_TYPE = MsgType::SKILL_RSP;
+
     int mPlayerIndex;
     bool mSuccess;
     std::vector<Card> mAffectedCards;  // 技能影响的卡牌
@@ -191,9 +218,12 @@ struct SkillRspInfo : public Info {
 
 // 新增：特殊效果信息（用于Package和Flash卡）
 struct SpecialEffectInfo : public Info {
+    constexpr static MsgType MSG_TYPE = MsgType::SPECIAL_EFFECT;
+
     int mPlayerIndex;
     CardText mEffectType;  // PACKAGE 或 FLASH
     CardColor mTargetColor; // 效果目标颜色
+    Card mCard{};           // Flash 应答时打出的牌，应答 BLACK 时无意义
     std::vector<int> mAffectedPlayers; // 受影响的玩家
 
     SpecialEffectInfo() {}
@@ -212,6 +242,8 @@ struct SpecialEffectInfo : public Info {
 
 // 新增：游戏状态更新信息
 struct GameStateUpdateInfo : public Info {
+    constexpr static MsgType MSG_TYPE = MsgType::GAME_STATE_UPDATE;
+
     int mCurrentPlayer;
     GameStat::TurnPhase mCurrentPhase;
     bool mSpecialEffectActive;
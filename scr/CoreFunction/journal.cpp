@@ -0,0 +1,252 @@
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#elif defined(_WIN32)
+#include <io.h>
+#endif
+
+#include "journal.h"
+#include "../common/logger.h"
+
+namespace UNO { namespace Game {
+
+namespace {
+
+bool SyncFile(std::FILE *file)
+{
+    if (std::fflush(file) != 0) {
+        return false;
+    }
+#if defined(__unix__) || defined(__APPLE__)
+    return ::fsync(::fileno(file)) == 0;
+#elif defined(_WIN32)
+    return ::_commit(::_fileno(file)) == 0;
+#else
+    return true;
+#endif
+}
+
+// a rename is durable only once the directory holding it is synced
+bool SyncDirectoryOf(const std::string &path)
+{
+#if defined(__unix__) || defined(__APPLE__)
+    auto slash = path.find_last_of('/');
+    std::string dir = (slash == std::string::npos) ? "." : path.substr(0, slash + 1);
+    int fd = ::open(dir.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    bool synced = (::fsync(fd) == 0);
+    ::close(fd);
+    return synced;
+#else
+    return true;
+#endif
+}
+
+bool ReadWholeFile(const std::string &path, std::vector<uint8_t> &buffer)
+{
+    std::FILE *file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        return false;
+    }
+    uint8_t chunk[4096];
+    std::size_t n;
+    while ((n = std::fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        buffer.insert(buffer.end(), chunk, chunk + n);
+    }
+    std::fclose(file);
+    return true;
+}
+}
+
+Journal::Journal(const std::string &path, uint32_t nextSeq)
+    : mPath(path), mNextSeq(nextSeq), mCommittedSeq(nextSeq - 1)
+{
+    mFile = std::fopen(mPath.c_str(), "ab");
+    if (!mFile) {
+        throw std::runtime_error("cannot open journal: " + mPath);
+    }
+    mPending.reserve(BATCH_SIZE);
+    mWriter = std::thread([this] { WriterLoop(); });
+}
+
+Journal::~Journal()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStop = true;
+    }
+    mCv.notify_one();
+    mWriter.join();
+    if (mFile) {
+        std::fclose(mFile);
+    }
+}
+
+void Journal::Append(JournalRecord record)
+{
+    record.mSeq = mNextSeq++;
+    mRecordsSinceSnapshot++;
+    bool batchFull;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mPending.push_back(record);
+        batchFull = (mPending.size() >= BATCH_SIZE);
+    }
+    if (batchFull) {
+        mCv.notify_one();
+    }
+}
+
+void Journal::Snapshot(std::vector<uint8_t> image)
+{
+    mRecordsSinceSnapshot = 0;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        // an older snapshot that has not been written yet is superseded
+        mPendingSnapshot = std::move(image);
+        mPendingSnapshotSeq = mNextSeq - 1;
+    }
+    mCv.notify_one();
+}
+
+bool Journal::Flush()
+{
+    uint32_t lastSeq = mNextSeq - 1;
+    std::unique_lock<std::mutex> lock(mMutex);
+    mCv.notify_one();
+    mFlushedCv.wait(lock, [this, lastSeq] {
+        return mCommittedSeq >= lastSeq && mPendingSnapshot.empty();
+    });
+    return !mFailed;
+}
+
+void Journal::WriterLoop()
+{
+    std::vector<JournalRecord> records;
+    std::vector<uint8_t> snapshot;
+    records.reserve(BATCH_SIZE);
+
+    while (true) {
+        uint32_t snapshotSeq;
+        bool stop;
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mCv.wait_for(lock, std::chrono::milliseconds(COMMIT_INTERVAL_MS), [this] {
+                return mStop || mPending.size() >= BATCH_SIZE || !mPendingSnapshot.empty();
+            });
+            records.swap(mPending);
+            snapshot.swap(mPendingSnapshot);
+            snapshotSeq = mPendingSnapshotSeq;
+            stop = mStop;
+        }
+
+        // once journaling has stopped, batches are still acknowledged so that Flush returns
+        if (!snapshot.empty() && mFile) {
+            // records covered by the snapshot are not needed anymore, so the journal
+            // restarts from the ones appended after it, but only once the snapshot is
+            // durable; otherwise the journal keeps them and recovery starts from the
+            // previous snapshot
+            if (WriteSnapshotFile(snapshotSeq, snapshot)) {
+                mFile = std::freopen(mPath.c_str(), "wb", mFile);
+                if (!mFile) {
+                    // freopen has closed the old file already, so the table can only be
+                    // recovered up to the snapshot just written
+                    UNO_LOG_ERROR("cannot reopen journal {}, the table is not journaled anymore", mPath);
+                    mFailed = true;
+                }
+                records.erase(std::remove_if(records.begin(), records.end(),
+                    [snapshotSeq](const JournalRecord &record) { return record.mSeq <= snapshotSeq; }),
+                    records.end());
+            }
+        }
+        if (mFile && (!records.empty() || !snapshot.empty())) {
+            bool written = records.empty()
+                || std::fwrite(records.data(), sizeof(JournalRecord), records.size(), mFile) == records.size();
+            if (!written || !SyncFile(mFile)) {
+                // later records would leave a gap after the torn ones, which Load cannot
+                // tell apart from a complete journal, so journaling stops here
+                UNO_LOG_ERROR("cannot write journal {}, the table is not journaled anymore", mPath);
+                std::fclose(mFile);
+                mFile = nullptr;
+                mFailed = true;
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            if (!records.empty()) {
+                mCommittedSeq = records.back().mSeq;
+            }
+            if (!snapshot.empty() && snapshotSeq > mCommittedSeq) {
+                mCommittedSeq = snapshotSeq;
+            }
+        }
+        mFlushedCv.notify_all();
+        records.clear();
+        snapshot.clear();
+
+        if (stop) {
+            std::lock_guard<std::mutex> lock(mMutex);
+            if (mPending.empty() && mPendingSnapshot.empty()) {
+                break;
+            }
+        }
+    }
+}
+
+bool Journal::WriteSnapshotFile(uint32_t seq, const std::vector<uint8_t> &image)
+{
+    // write aside, sync and rename, so that a crash never leaves a torn snapshot behind
+    std::string tmpPath = mPath + ".snap.tmp";
+    std::FILE *file = std::fopen(tmpPath.c_str(), "wb");
+    if (!file) {
+        UNO_LOG_ERROR("cannot open snapshot {}", tmpPath);
+        return false;
+    }
+    bool written = std::fwrite(&seq, sizeof(seq), 1, file) == 1
+        && std::fwrite(image.data(), 1, image.size(), file) == image.size()
+        && SyncFile(file);
+    written = (std::fclose(file) == 0) && written;
+    if (!written || std::rename(tmpPath.c_str(), (mPath + ".snap").c_str()) != 0
+        || !SyncDirectoryOf(mPath)) {
+        UNO_LOG_ERROR("cannot write snapshot {}, the journal keeps the records it covers", mPath + ".snap");
+        std::remove(tmpPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool Journal::Load(const std::string &path, uint32_t &snapshotSeq,
+    std::vector<uint8_t> &image, std::vector<JournalRecord> &tail)
+{
+    std::vector<uint8_t> buffer;
+    if (!ReadWholeFile(path + ".snap", buffer) || buffer.size() < sizeof(snapshotSeq)) {
+        return false;
+    }
+    std::memcpy(&snapshotSeq, buffer.data(), sizeof(snapshotSeq));
+    image.assign(buffer.begin() + sizeof(snapshotSeq), buffer.end());
+
+    buffer.clear();
+    ReadWholeFile(path, buffer);
+    // a torn record at the end of the file is what a crash in the middle of a commit leaves
+    std::size_t count = buffer.size() / sizeof(JournalRecord);
+    const uint8_t *data = buffer.data();
+    tail.clear();
+    for (std::size_t i = 0; i < count; i++) {
+        JournalRecord record;
+        std::memcpy(&record, data + i * sizeof(JournalRecord), sizeof(JournalRecord));
+        if (record.mSeq > snapshotSeq) {
+            tail.push_back(record);
+        }
+    }
+    return true;
+}
+
+}}
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+
+namespace UNO { namespace Game {
+
+enum class JournalEventType : uint8_t {
+    DEAL,
+    DRAW,
+    PLAY,
+    SKIP,
+    SKILL,
+    EFFECT,
+    PHASE
+};
+
+/**
+ * One state transition of a table. Records are fixed-width so that the journal
+ * file is just an array of them and can be appended and scanned without framing.
+ *   DEAL:   mPlayer got mArg cards at game start (informational, covered by the first snapshot)
+ *   DRAW:   mPlayer drew mArg cards, mArg2 is 1 if the draw consumed the turn's draw penalty
+ *   PLAY:   mPlayer played (mColor, mText), mArg is the next color if the card is black,
+ *           mArg2 is 1 if the card answered a Flash prompt out of turn
+ *   SKIP:   mPlayer skipped
+ *   SKILL:  mPlayer used the skill of CharacterType mArg on player mArg2,
+ *           for Lucky Star mArg2 is the index of the card kept from the top of deck
+ *   EFFECT: mPlayer triggered the effect of CardText mText with CardColor mColor
+ *   PHASE:  the turn of mPlayer entered GameStat::TurnPhase mArg
+ */
+struct JournalRecord {
+    uint32_t mSeq;
+    JournalEventType mType;
+    int8_t mPlayer;
+    uint8_t mColor;
+    uint8_t mText;
+    int16_t mArg;
+    int16_t mArg2;
+};
+static_assert(sizeof(JournalRecord) == 12, "journal records must stay fixed-width");
+
+/**
+ * Append-only per-table journal. \c Append and \c Snapshot only copy into an
+ * in-memory batch on the game thread; a background writer group-commits the
+ * batch with a single write + fsync, so durability costs the game loop nothing
+ * but a lock and a copy.
+ *
+ * Files: <path> holds the records, <path>.snap holds the sequence number of the
+ * last record covered by the latest snapshot, followed by the snapshot itself.
+ */
+class Journal {
+public:
+    explicit Journal(const std::string &path, uint32_t nextSeq = 1);
+
+    ~Journal();
+
+    Journal(const Journal &) = delete;
+    Journal &operator=(const Journal &) = delete;
+
+    /**
+     * Append a record, the sequence number is assigned here.
+     */
+    void Append(JournalRecord record);
+
+    /**
+     * Queue a snapshot covering every record appended so far.
+     *   \param image: the table image, see table_image.h
+     */
+    void Snapshot(std::vector<uint8_t> image);
+
+    /**
+     * Block until everything queued so far is durable.
+     *   \return false if the journal has failed, see \c Failed
+     */
+    bool Flush();
+
+    /**
+     * Whether a write to the journal has failed. The journal stops at the first
+     * failure, and the table can only be recovered up to the records before it.
+     */
+    bool Failed() const { return mFailed; }
+
+    /**
+     * Number of records appended since the last snapshot was queued.
+     */
+    int RecordsSinceSnapshot() const { return mRecordsSinceSnapshot; }
+
+    uint32_t GetLastSeq() const { return mNextSeq - 1; }
+
+    /**
+     * Load the latest snapshot and the records appended after it.
+     *   \param snapshotSeq: the sequence number of the last record covered by the snapshot
+     *   \return false if there is no snapshot at \p path
+     */
+    static bool Load(const std::string &path, uint32_t &snapshotSeq,
+        std::vector<uint8_t> &image, std::vector<JournalRecord> &tail);
+
+private:
+    void WriterLoop();
+
+    /**
+     * \return false if the snapshot could not be made durable, the previous one is then kept
+     */
+    bool WriteSnapshotFile(uint32_t seq, const std::vector<uint8_t> &image);
+
+private:
+    // records of one group commit
+    constexpr static int BATCH_SIZE = 256;
+    // longest time a record may wait in memory before being committed
+    constexpr static int COMMIT_INTERVAL_MS = 5;
+
+    const std::string mPath;
+    std::FILE *mFile{nullptr};
+
+    // touched by the game thread only
+    uint32_t mNextSeq;
+    int mRecordsSinceSnapshot{0};
+
+    std::mutex mMutex;
+    std::condition_variable mCv;
+    std::condition_variable mFlushedCv;
+    std::vector<JournalRecord> mPending;
+    std::vector<uint8_t> mPendingSnapshot;
+    uint32_t mPendingSnapshotSeq{0};
+    uint32_t mCommittedSeq{0};
+    bool mStop{false};
+    // set by the writer, read by the game thread
+    std::atomic<bool> mFailed{false};
+
+    std::thread mWriter;
+};
+}}
@@ -1,5 +1,6 @@
 #include <iostream>
 #include <map>
+#include <algorithm>
 
 #include "client.h"
 
@@ -23,6 +24,9 @@ void Client::Connect()
             [this, &socket](std::error_code ec, tcp::endpoint) {
                 if (!ec) {
                     mSession = std::make_unique<Session>(std::move(socket));
+                    mSession->SetUnexpectedMsgHandler([this](const uint8_t *buffer) {
+                        HandleUnexpectedMsg(buffer);
+                    });
                 }
             }
         );
@@ -43,6 +47,51 @@ void Client::Reset()
     mContext.restart();
 }
 
+void Client::HandleUnexpectedMsg(const uint8_t *buffer)
+{
+    switch (reinterpret_cast<const Msg *>(buffer)->mType) {
+        case MsgType::DRAW_RSP:
+            // the Flash penalty, sent while the player waits for the others to act
+            UpdateHandCards(*DrawRspInfo::Deserialize(buffer));
+            break;
+        case MsgType::SPECIAL_EFFECT: {
+            std::unique_ptr<SpecialEffectInfo> prompt = SpecialEffectInfo::Deserialize(buffer);
+            if (prompt->mEffectType != CardText::FLASH) {
+                break;
+            }
+            SpecialEffectInfo answer(prompt->mPlayerIndex, CardText::FLASH, CardColor::BLACK);
+            auto it = std::find_if(mHandCards.begin(), mHandCards.end(), [&prompt](const Card &card) {
+                return card.mColor == prompt->mTargetColor;
+            });
+            if (it != mHandCards.end()) {
+                answer.mTargetColor = prompt->mTargetColor;
+                answer.mCard = *it;
+                mHandCards.erase(it);
+            }
+            mSession->DeliverInfo<SpecialEffectInfo>(answer);
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+void Client::UpdateHandCards(const Info &info)
+{
+    if (auto gameStart = dynamic_cast<const GameStartInfo *>(&info)) {
+        mHandCards = gameStart->mInitHandCards;
+    }
+    else if (auto drawRsp = dynamic_cast<const DrawRspInfo *>(&info)) {
+        mHandCards.insert(mHandCards.end(), drawRsp->mCards.begin(), drawRsp->mCards.end());
+    }
+    else if (auto play = dynamic_cast<const PlayInfo *>(&info)) {
+        auto it = std::find(mHandCards.begin(), mHandCards.end(), play->mCard);
+        if (it != mHandCards.end()) {
+            mHandCards.erase(it);
+        }
+    }
+}
+
 std::unique_ptr<Info> Client::ReceiveInfo(const std::type_info *infoType)
 {
     using funcType = std::function<std::unique_ptr<Info>()>;
@@ -75,6 +124,7 @@ std::unique_ptr<Info> Client::ReceiveInfo(const std::type_info *infoType)
         std::cout << "oops, server has shutdown" << std::endl;
         std::exit(-1);
     }
+    UpdateHandCards(*info);
     return info;
 }
 
@@ -124,6 +174,7 @@ void Client::DeliverInfo(const std::type_info *infoType, const Info &info)
     };
     auto it = mapping.find(infoType);
     assert(it != mapping.end());
-    return it->second(info);
+    it->second(info);
+    UpdateHandCards(info);
 }
 }}
@@ -18,6 +18,13 @@ public:
 
     virtual void RegisterConnectCallback(const std::function<void()> &callback) = 0;
 
+    /**
+     * The hand as followed from the messages passed: the initial hand, every DrawRspInfo
+     * and the own plays. Flash prompts are answered from it, so the cards played on them
+     * and the Flash penalty drawn outside the own turn show up only here.
+     */
+    virtual const std::vector<Card> &GetHandCards() const = 0;
+
     virtual std::unique_ptr<Info> ReceiveInfo(const std::type_info *infoType) = 0;
 
     virtual void DeliverInfo(const std::type_info *infoType, const Info &info) = 0;
@@ -35,6 +42,8 @@ public:
         OnConnect = callback;
     }
 
+    const std::vector<Card> &GetHandCards() const override { return mHandCards; }
+
     std::unique_ptr<Info> ReceiveInfo(const std::type_info *infoType) override;
 
     void DeliverInfo(const std::type_info *infoType, const Info &info) override;
@@ -50,6 +59,15 @@ private:
         mSession->DeliverInfo<InfoT>(info);
     }
 
+    /**
+     * Handle a message that arrives while another is awaited: answer a Flash prompt with
+     * a card of its color, or BLACK if there is none, and take in the Flash penalty.
+     */
+    void HandleUnexpectedMsg(const uint8_t *buffer);
+
+    // follow the hand through a message received or delivered
+    void UpdateHandCards(const Info &info);
+
 private:
     std::function<void()> OnConnect;
 
@@ -60,6 +78,8 @@ private:
     asio::io_context mContext;
     std::unique_ptr<Session> mSession;
 
+    std::vector<Card> mHandCards;
+
     bool mShouldReset{true};
 };
 }}
@@ -2,6 +2,7 @@
 
 #include "../game/cards.h"
 #include "../game/stat.h"
+#include "../common/card_code.h"
 
 namespace UNO { namespace Network {
 
@@ -39,12 +40,14 @@ struct JoinGameRspMsg : public Msg {
 };
 
 struct GameStartMsg : public Msg {
-    Card mInitHandCards[7];
-    Card mFlippedCard;  // indicating the first card that should be played
+    // cards travel as one-byte codes, see card_view.h for the conversions
+    Common::CardCode mFlippedCard;  // indicating the first card that should be played
     int mFirstPlayer;  // the index of the first player to play a card
+    int mInitHandCardsNum;  // the hand size of the table
+    // mInitHandCardsNum codes of the initial hand cards, followed by
     // usernames of all players, not including player himself, ' ' as delimiter
     // and the order is from left side of the player to right side
-    char mUsernames[];
+    char mPayload[];
 };
 
 enum class ActionType : uint8_t {
@@ -67,13 +70,13 @@ struct SkipMsg : public ActionMsg {
 };
 
 struct PlayMsg : public ActionMsg {
-    Card mCard;
+    Common::CardCode mCard;
     CardColor mNextColor;  // valid only if mCard is black
 };
 
 struct DrawRspMsg : public Msg {
     int mNumber;
-    Card mCards[];
+    Common::CardCode mCards[];
 };
 
 struct GameEndMsg : public Msg {
@@ -93,7 +96,7 @@ struct SkillRspMsg : public Msg {
     int mPlayerIndex;
     bool mSuccess;
     int mAffectedCardsCount;
-    Card mAffectedCards[];  // 技能影响的卡牌
+    Common::CardCode mAffectedCards[];  // 技能影响的卡牌
 };
 
 // 新增：特殊效果消息（用于Package和Flash卡）
@@ -101,6 +104,7 @@ struct SpecialEffectMsg : public Msg {
     int mPlayerIndex;
     int mEffectType;    // CardText 枚举值（PACKAGE 或 FLASH）
     int mTargetColor;   // 效果目标颜色
+    Common::CardCode mCard;  // Flash 应答时打出的牌
     int mAffectedPlayersCount;
     int mAffectedPlayers[]; // 受影响的玩家索引
 };
@@ -110,7 +114,7 @@ struct GameStateUpdateMsg : public Msg {
     int mCurrentPlayer;
     int mCurrentPhase;  // GameStat::TurnPhase 枚举值
     bool mSpecialEffectActive;
-    Card mLastPlayedCard;
+    Common::CardCode mLastPlayedCard;
     int mCardsNumToDraw;
 };
 }}
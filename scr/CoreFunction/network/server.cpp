@@ -2,6 +2,7 @@
 #include <map>
 
 #include "server.h"
+#include "../common/metrics.h"
 
 namespace UNO { namespace Network {
 
@@ -17,11 +18,17 @@ void Server::Run()
     mAcceptor = std::make_unique<tcp::acceptor>(mContext, endpoint);
     while (mShouldReset) {
         mShouldReset = false;
+        mContext.restart();
         Accept();
         mContext.run();
 
         std::cout << "All players have joined. Game Start!" << std::endl;
+        // the game is spawned onto mContext as a coroutine, run it until it ends
+        static auto &gamesStarted = Common::MetricsRegistry::Instance().GetCounter("uno_games_started_total");
+        gamesStarted.Add();
         OnAllPlayersJoined();
+        mContext.restart();
+        mContext.run();
         Close();
     }
 }
@@ -34,11 +41,13 @@ void Server::Accept()
             int index = mSessions.size();
             std::cout << "a new player joins in, index : " << index << std::endl;
 
+            static auto &sessionsAccepted = Common::MetricsRegistry::Instance().GetCounter("uno_sessions_accepted_total");
+            sessionsAccepted.Add();
             mSessions.push_back(std::make_unique<Session>(std::move(socket)));
             std::unique_ptr<JoinGameInfo> info = mSessions.back()->ReceiveInfo<JoinGameInfo>();
             OnReceiveJoinGameInfo(index, *info);
         }
-        if (mSessions.size() < Common::Common::mPlayerNum) {
+        if (mSessions.size() < mPlayerNum) {
             Accept();
         }
     });
@@ -52,9 +61,9 @@ void Server::Close()
 
 void Server::Reset()
 {
+    // the context is restarted by Run before it runs again, it cannot be
+    // restarted here since the game calls Reset from inside mContext.run()
     mShouldReset = true;
-    // a invokation to restart is needed for subsequent run
-    mContext.restart();
 }
 
 std::unique_ptr<Info> Server::ReceiveInfo(const std::type_info *infoType, int index)
@@ -82,6 +91,26 @@ std::unique_ptr<Info> Server::ReceiveInfo(const std::type_info *infoType, int in
     return it->second(index);
 }
 
+asio::awaitable<std::unique_ptr<Info>> Server::AsyncReceiveInfo(const std::type_info *infoType,
+    int index, std::chrono::steady_clock::duration timeout)
+{
+    using funcType = std::function<asio::awaitable<std::unique_ptr<Info>>(int, std::chrono::steady_clock::duration)>;
+    static std::map<const std::type_info *, funcType> mapping{
+        {&typeid(ActionInfo),      [this](int index, std::chrono::steady_clock::duration timeout) {
+            return AsyncReceiveInfoImpl<ActionInfo>(index, timeout);
+        }},
+        {&typeid(SkillUseInfo),    [this](int index, std::chrono::steady_clock::duration timeout) {
+            return AsyncReceiveInfoImpl<SkillUseInfo>(index, timeout);
+        }},
+        {&typeid(SpecialEffectInfo), [this](int index, std::chrono::steady_clock::duration timeout) {
+            return AsyncReceiveInfoImpl<SpecialEffectInfo>(index, timeout);
+        }}
+    };
+    auto it = mapping.find(infoType);
+    assert(it != mapping.end());
+    co_return co_await it->second(index, timeout);
+}
+
 void Server::DeliverInfo(const std::type_info *infoType, int index, const Info &info)
 {
     using funcType = std::function<void(int, const Info &)>;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <chrono>
 #include <asio.hpp>
 
 #include "session.h"
@@ -23,9 +24,25 @@ public:
 
     virtual void RegisterAllPlayersJoinedCallback(const std::function<void()> &callback) = 0;
 
+    /**
+     * Set the number of players to wait for, which is the configured one by default.
+     */
+    virtual void SetPlayerNum(int playerNum) = 0;
+
     virtual std::unique_ptr<Info> ReceiveInfo(const std::type_info *infoType, int index) = 0;
 
     virtual void DeliverInfo(const std::type_info *infoType, int index, const Info &info) = 0;
+
+    /**
+     * Awaitable version of \c ReceiveInfo, throws a timed_out error if nothing arrives within \p timeout.
+     */
+    virtual asio::awaitable<std::unique_ptr<Info>> AsyncReceiveInfo(const std::type_info *infoType,
+        int index, std::chrono::steady_clock::duration timeout) = 0;
+
+    /**
+     * The executor that the game runs its coroutines on.
+     */
+    virtual asio::any_io_executor GetExecutor() = 0;
 };
 
 class Server : public IServer {
@@ -47,10 +64,17 @@ public:
         OnAllPlayersJoined = callback;
     }
 
+    void SetPlayerNum(int playerNum) override { mPlayerNum = playerNum; }
+
     std::unique_ptr<Info> ReceiveInfo(const std::type_info *infoType, int index) override;
 
     void DeliverInfo(const std::type_info *infoType, int index, const Info &info) override;
 
+    asio::awaitable<std::unique_ptr<Info>> AsyncReceiveInfo(const std::type_info *infoType,
+        int index, std::chrono::steady_clock::duration timeout) override;
+
+    asio::any_io_executor GetExecutor() override { return mContext.get_executor(); }
+
 private:
     void Accept();
 
@@ -59,6 +83,12 @@ private:
         return mSessions[index]->ReceiveInfo<InfoT>();
     }
 
+    template<typename InfoT>
+    asio::awaitable<std::unique_ptr<Info>> AsyncReceiveInfoImpl(int index,
+        std::chrono::steady_clock::duration timeout) {
+        co_return co_await mSessions[index]->AsyncReceiveInfo<InfoT>(timeout);
+    }
+
     template<typename InfoT>
     void DeliverInfoImpl(int index, const InfoT &info) {
         mSessions[index]->DeliverInfo<InfoT>(info);
@@ -72,6 +102,7 @@ private:
 
 private:
     const std::string mPort;
+    int mPlayerNum{Common::Common::mPlayerNum};
     
     asio::io_context mContext;
     std::unique_ptr<tcp::acceptor> mAcceptor;
@@ -1,8 +1,58 @@
 #include "session.h"
+#include "../common/metrics.h"
 #include <spdlog/spdlog.h>
 
 namespace UNO { namespace Network {
 
+namespace {
+
+const char *MSG_TYPE_NAMES[] = {
+    "JOIN_GAME", "JOIN_GAME_RSP", "GAME_START", "ACTION", "DRAW_RSP", "GAME_END",
+    "SKILL_USE", "SKILL_RSP", "SPECIAL_EFFECT", "GAME_STATE_UPDATE"
+};
+constexpr int MSG_TYPE_NUM = sizeof(MSG_TYPE_NAMES) / sizeof(MSG_TYPE_NAMES[0]);
+
+/**
+ * Messages and bytes per MsgType in one direction, shared by all sessions.
+ */
+class MsgMetrics {
+public:
+    explicit MsgMetrics(const std::string &direction) {
+        auto &registry = Common::MetricsRegistry::Instance();
+        for (int type = 0; type < MSG_TYPE_NUM; type++) {
+            std::string labels = "{direction=\"" + direction + "\",type=\"" + MSG_TYPE_NAMES[type] + "\"}";
+            mMessages[type] = &registry.GetCounter("uno_messages_total" + labels);
+            mBytes[type] = &registry.GetCounter("uno_message_bytes_total" + labels);
+        }
+    }
+
+    void Record(const uint8_t *buffer) {
+        const Msg *msg = reinterpret_cast<const Msg *>(buffer);
+        int type = static_cast<int>(msg->mType);
+        if (type < MSG_TYPE_NUM) {
+            mMessages[type]->Add();
+            mBytes[type]->Add(sizeof(Msg) + msg->mLen);
+        }
+    }
+
+private:
+    Common::Counter *mMessages[MSG_TYPE_NUM];
+    Common::Counter *mBytes[MSG_TYPE_NUM];
+};
+
+MsgMetrics &InMetrics()
+{
+    static MsgMetrics metrics("in");
+    return metrics;
+}
+
+MsgMetrics &OutMetrics()
+{
+    static MsgMetrics metrics("out");
+    return metrics;
+}
+}
+
 Session::Session(tcp::socket socket) : mSocket(std::move(socket)) 
 {
 #ifdef ENABLE_LOG
@@ -13,30 +63,37 @@ Session::Session(tcp::socket socket) : mSocket(std::move(socket))
 /**
  * Read will throw end-of-file exception if the corresponding client has disconnected
  */
-void Session::Read()
+void Session::Read(MsgType expectedType)
 {
-    std::memset(mReadBuffer, 0, MAX_BUFFER_SIZE);
-    
     try {
-        // read header
-        asio::read(mSocket, asio::buffer(mReadBuffer, sizeof(Msg)));
+        while (true) {
+            std::memset(mReadBuffer, 0, MAX_BUFFER_SIZE);
 
-        // read body
-        int len = reinterpret_cast<Msg *>(mReadBuffer)->mLen;
-        
-        // 验证消息长度
-        if (len < 0 || len > (MAX_BUFFER_SIZE - sizeof(Msg))) {
-            throw std::runtime_error("Invalid message length: " + std::to_string(len));
-        }
-        
-        asio::read(mSocket, asio::buffer(mReadBuffer + sizeof(Msg), len));
+            // read header
+            asio::read(mSocket, asio::buffer(mReadBuffer, sizeof(Msg)));
+
+            // read body
+            int len = reinterpret_cast<Msg *>(mReadBuffer)->mLen;
+            
+            // 验证消息长度
+            if (len < 0 || len > (MAX_BUFFER_SIZE - sizeof(Msg))) {
+                throw std::runtime_error("Invalid message length: " + std::to_string(len));
+            }
+            
+            asio::read(mSocket, asio::buffer(mReadBuffer + sizeof(Msg), len));
+            InMetrics().Record(mReadBuffer);
 
 #ifdef ENABLE_LOG
-        // 记录接收的消息类型（调试用）
-        MsgType msgType = reinterpret_cast<Msg *>(mReadBuffer)->mType;
-        spdlog::debug("Received message type: {}, length: {} from {}", 
-                     static_cast<int>(msgType), len, GetRemoteEndpoint());
+            // 记录接收的消息类型（调试用）
+            MsgType msgType = reinterpret_cast<Msg *>(mReadBuffer)->mType;
+            spdlog::debug("Received message type: {}, length: {} from {}", 
+                         static_cast<int>(msgType), len, GetRemoteEndpoint());
 #endif
+            if (reinterpret_cast<Msg *>(mReadBuffer)->mType == expectedType) {
+                break;
+            }
+            HandleUnexpectedMsg(expectedType);
+        }
     }
     catch (const std::exception &e) {
 #ifdef ENABLE_LOG
@@ -46,6 +103,74 @@ void Session::Read()
     }
 }
 
+asio::awaitable<void> Session::AsyncRead(std::chrono::steady_clock::duration timeout, MsgType expectedType)
+{
+    // the deadline cancels the pending read, the flags outlive this frame
+    // since the timer handler may still be queued when the read completes
+    auto timedOut = std::make_shared<bool>(false);
+    auto done = std::make_shared<bool>(false);
+    asio::steady_timer timer(mSocket.get_executor(), timeout);
+    timer.async_wait([this, timedOut, done](const std::error_code &ec) {
+        if (!ec && !*done) {
+            *timedOut = true;
+            mSocket.cancel();
+        }
+    });
+
+    try {
+        // the deadline covers the messages skipped on the way as well
+        while (true) {
+            std::memset(mReadBuffer, 0, MAX_BUFFER_SIZE);
+
+            // read header
+            co_await asio::async_read(mSocket, asio::buffer(mReadBuffer, sizeof(Msg)), asio::use_awaitable);
+
+            // read body
+            int len = reinterpret_cast<Msg *>(mReadBuffer)->mLen;
+            if (len < 0 || len > (MAX_BUFFER_SIZE - sizeof(Msg))) {
+                throw std::runtime_error("Invalid message length: " + std::to_string(len));
+            }
+            co_await asio::async_read(mSocket, asio::buffer(mReadBuffer + sizeof(Msg), len), asio::use_awaitable);
+            InMetrics().Record(mReadBuffer);
+
+            if (reinterpret_cast<Msg *>(mReadBuffer)->mType == expectedType) {
+                break;
+            }
+            HandleUnexpectedMsg(expectedType);
+        }
+    }
+    catch (const std::exception &e) {
+        *done = true;
+        timer.cancel();
+#ifdef ENABLE_LOG
+        spdlog::error("Read error from {}: {}", GetRemoteEndpoint(), e.what());
+#endif
+        if (*timedOut) {
+            throw std::system_error(asio::error::make_error_code(asio::error::timed_out));
+        }
+        throw;
+    }
+    *done = true;
+    timer.cancel();
+}
+
+void Session::HandleUnexpectedMsg(MsgType expectedType)
+{
+    if (OnUnexpectedMsg) {
+        OnUnexpectedMsg(mReadBuffer);
+        return;
+    }
+    static auto &dropped = Common::MetricsRegistry::Instance().GetCounter("uno_messages_dropped_total");
+    dropped.Add();
+#ifdef ENABLE_LOG
+    spdlog::warn("Dropped message type {} from {} while waiting for type {}",
+                 static_cast<int>(reinterpret_cast<Msg *>(mReadBuffer)->mType), GetRemoteEndpoint(),
+                 static_cast<int>(expectedType));
+#else
+    (void)expectedType;
+#endif
+}
+
 void Session::Write() 
 {
     try {
@@ -57,6 +182,7 @@ void Session::Write()
             throw std::runtime_error("Message too large for buffer: " + std::to_string(len));
         }
         
+        OutMetrics().Record(mWriteBuffer);
         asio::async_write(mSocket, asio::buffer(mWriteBuffer, len), 
             [this](std::error_code ec, std::size_t bytes_transferred) {
                 if (!ec) {
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <iostream>
+#include <chrono>
+#include <functional>
 #include <asio.hpp>
 
 #include "../game/info.h"
@@ -19,12 +21,34 @@ class Session {
 public:
     explicit Session(tcp::socket socket);
 
+    /**
+     * Messages of another type than InfoT that arrive first are passed to the handler
+     * set by \c SetUnexpectedMsgHandler, or dropped if there is none.
+     */
     template<typename InfoT>
     std::unique_ptr<InfoT> ReceiveInfo() {
-        Read();
+        Read(InfoT::MSG_TYPE);
         return InfoT::Deserialize(mReadBuffer);
     }
 
+    /**
+     * Awaitable version of \c ReceiveInfo, which suspends the calling coroutine rather than
+     * blocking the thread, and throws a timed_out error if nothing arrives within \p timeout.
+     */
+    template<typename InfoT>
+    asio::awaitable<std::unique_ptr<InfoT>> AsyncReceiveInfo(std::chrono::steady_clock::duration timeout) {
+        co_await AsyncRead(timeout, InfoT::MSG_TYPE);
+        co_return InfoT::Deserialize(mReadBuffer);
+    }
+
+    /**
+     * Handle messages that arrive while another type is awaited, e.g. a prompt of the
+     * server in the middle of a turn. The handler gets the whole message and may reply.
+     */
+    void SetUnexpectedMsgHandler(const std::function<void(const uint8_t *)> &handler) {
+        OnUnexpectedMsg = handler;
+    }
+
     template<typename InfoT>
     void DeliverInfo(const InfoT &info) {
         info.Serialize(mWriteBuffer);
@@ -65,8 +89,18 @@ public:
     }
 
 private:
-    // read from mSocket to mReadBuffer
-    void Read();
+    // read from mSocket to mReadBuffer until a message of expectedType arrives
+    void Read(MsgType expectedType);
+
+    // read from mSocket to mReadBuffer without blocking the thread
+    asio::awaitable<void> AsyncRead(std::chrono::steady_clock::duration timeout, MsgType expectedType);
+
+    /**
+     * Pass a message other than the awaited one to the handler, or drop it.
+     * A late reply, e.g. to a Flash prompt whose deadline has passed, ends up here
+     * instead of being taken for the message awaited now.
+     */
+    void HandleUnexpectedMsg(MsgType expectedType);
 
     // write from mWriteBuffer to mSocket
     void Write();
@@ -75,13 +109,15 @@ private:
     bool ValidateMessageLength(int expectedLen, int actualLen);
 
 private:
-    // 增加缓冲区大小以容纳新增的消息类型
-    constexpr static int MAX_BUFFER_SIZE = 512;  // 从256增加到512
+    // GameStartMsg 随人数和初始手牌数变长，Config 保证牌桌的 GameStartMsg 放得下
+    constexpr static int MAX_BUFFER_SIZE = Common::Common::MAX_MSG_SIZE;
 
     tcp::socket mSocket;
     uint8_t mReadBuffer[MAX_BUFFER_SIZE];
     uint8_t mWriteBuffer[MAX_BUFFER_SIZE];
 
+    std::function<void(const uint8_t *)> OnUnexpectedMsg;
+
     friend class Test::SessionFixture;
 };
 }}
@@ -0,0 +1,109 @@
+#include <algorithm>
+#include <cmath>
+
+#include "rating.h"
+
+namespace UNO { namespace Game {
+
+namespace {
+
+constexpr double PI = 3.14159265358979323846;
+const double Q = std::log(10.0) / 400.0;
+
+double ExpectedScore(double rating, double opponentRating, double g = 1.0)
+{
+    return 1.0 / (1.0 + std::pow(10.0, -g * (rating - opponentRating) / 400.0));
+}
+
+double ActualScore(int place, int opponentPlace)
+{
+    return place < opponentPlace ? 1.0 : (place == opponentPlace ? 0.5 : 0.0);
+}
+
+double GlickoG(double deviation)
+{
+    return 1.0 / std::sqrt(1.0 + 3.0 * Q * Q * deviation * deviation / (PI * PI));
+}
+}
+
+void RatingUpdater::Update(std::vector<Rating> &ratings, const std::vector<RatedGame> &games) const
+{
+    if (mSystem == RatingSystem::ELO) {
+        for (const auto &game : games) {
+            UpdateElo(ratings, game);
+        }
+    }
+    else {
+        UpdateGlicko(ratings, games);
+    }
+}
+
+void RatingUpdater::UpdateElo(std::vector<Rating> &ratings, const RatedGame &game) const
+{
+    int playerNum = game.mPlayers.size();
+    if (playerNum < 2) {
+        return;
+    }
+    // the pairwise games of one player share a single K, so that a table of 4 moves
+    // a rating about as much as a game of 2
+    double k = ELO_K / (playerNum - 1);
+    std::vector<double> deltas(playerNum, 0.0);
+    for (int i = 0; i < playerNum; i++) {
+        for (int j = 0; j < playerNum; j++) {
+            if (i != j) {
+                double expected = ExpectedScore(ratings[game.mPlayers[i]].mRating,
+                    ratings[game.mPlayers[j]].mRating);
+                deltas[i] += k * (ActualScore(game.mPlaces[i], game.mPlaces[j]) - expected);
+            }
+        }
+    }
+    for (int i = 0; i < playerNum; i++) {
+        ratings[game.mPlayers[i]].mRating += deltas[i];
+        ratings[game.mPlayers[i]].mGames++;
+    }
+}
+
+void RatingUpdater::UpdateGlicko(std::vector<Rating> &ratings, const std::vector<RatedGame> &games) const
+{
+    const std::vector<Rating> before = ratings;
+    // sums over the pairwise games of each player in this period
+    std::vector<double> variances(ratings.size(), 0.0);
+    std::vector<double> improvements(ratings.size(), 0.0);
+    std::vector<int> gameNums(ratings.size(), 0);
+
+    for (const auto &game : games) {
+        int playerNum = game.mPlayers.size();
+        for (int i = 0; i < playerNum; i++) {
+            int player = game.mPlayers[i];
+            for (int j = 0; j < playerNum; j++) {
+                if (i == j) {
+                    continue;
+                }
+                const Rating &opponent = before[game.mPlayers[j]];
+                double g = GlickoG(opponent.mDeviation);
+                double expected = ExpectedScore(before[player].mRating, opponent.mRating, g);
+                variances[player] += g * g * expected * (1.0 - expected);
+                improvements[player] += g * (ActualScore(game.mPlaces[i], game.mPlaces[j]) - expected);
+            }
+            gameNums[player]++;
+        }
+    }
+
+    for (std::size_t player = 0; player < ratings.size(); player++) {
+        Rating &rating = ratings[player];
+        // uncertainty grows with the time since the last period
+        double deviation = std::min(std::sqrt(rating.mDeviation * rating.mDeviation + GLICKO_C * GLICKO_C),
+            GLICKO_MAX_DEVIATION);
+        if (gameNums[player] == 0) {
+            rating.mDeviation = deviation;
+            continue;
+        }
+        double invDSquared = Q * Q * variances[player];
+        double denominator = 1.0 / (deviation * deviation) + invDSquared;
+        rating.mRating += Q / denominator * improvements[player];
+        rating.mDeviation = std::max(std::sqrt(1.0 / denominator), GLICKO_MIN_DEVIATION);
+        rating.mGames += gameNums[player];
+    }
+}
+
+}}
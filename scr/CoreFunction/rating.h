@@ -0,0 +1,52 @@
+#pragma once
+
+#include <vector>
+
+namespace UNO { namespace Game {
+
+struct Rating {
+    double mRating{1500.0};
+    double mDeviation{350.0};  // only used by Glicko
+    int mGames{0};
+};
+
+/**
+ * Result of one game for rating purposes, a game of n players counts as
+ * a win for each player against every player who finished behind them.
+ */
+struct RatedGame {
+    std::vector<int> mPlayers;  // indices into the ratings
+    std::vector<int> mPlaces;   // place of each player, 0 is the winner
+};
+
+enum class RatingSystem {
+    ELO,
+    GLICKO
+};
+
+class RatingUpdater {
+public:
+    explicit RatingUpdater(RatingSystem system) : mSystem(system) {}
+
+    /**
+     * Update \p ratings with the games of one rating period, e.g. a round of a tournament.
+     * Elo applies the games one by one in the given order; Glicko rates every player
+     * against the pre-period ratings of their opponents, so the order does not matter.
+     */
+    void Update(std::vector<Rating> &ratings, const std::vector<RatedGame> &games) const;
+
+private:
+    void UpdateElo(std::vector<Rating> &ratings, const RatedGame &game) const;
+
+    void UpdateGlicko(std::vector<Rating> &ratings, const std::vector<RatedGame> &games) const;
+
+private:
+    constexpr static double ELO_K = 32.0;
+    // deviation regained per rating period by an idle player
+    constexpr static double GLICKO_C = 30.0;
+    constexpr static double GLICKO_MAX_DEVIATION = 350.0;
+    constexpr static double GLICKO_MIN_DEVIATION = 30.0;
+
+    RatingSystem mSystem;
+};
+}}
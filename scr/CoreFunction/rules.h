@@ -0,0 +1,32 @@
+#pragma once
+
+#include "../common/common.h"
+
+namespace UNO { namespace Game {
+
+/**
+ * Rules policies \c GameBoard plays a table with. The policy of a table is
+ * chosen once when the table is created, and every turn runs code instantiated
+ * for it, so features a mode does not have are compiled out of its turns
+ * rather than skipped by a runtime check.
+ */
+struct ClassicRules {
+    constexpr static Common::Common::GameMode MODE = Common::Common::GameMode::CLASSIC;
+    // characters are assigned and their skills take effect
+    constexpr static bool HAS_CHARACTERS = false;
+    // Package and Flash cards take effect
+    constexpr static bool HAS_CUSTOM_CARDS = false;
+};
+
+struct CharacterRules {
+    constexpr static Common::Common::GameMode MODE = Common::Common::GameMode::WITH_CHARACTERS;
+    constexpr static bool HAS_CHARACTERS = true;
+    constexpr static bool HAS_CUSTOM_CARDS = false;
+};
+
+struct CustomRules {
+    constexpr static Common::Common::GameMode MODE = Common::Common::GameMode::CUSTOM;
+    constexpr static bool HAS_CHARACTERS = true;
+    constexpr static bool HAS_CUSTOM_CARDS = true;
+};
+}}
@@ -5,19 +5,21 @@ namespace UNO { namespace Game {
 
 // GameStat 实现
 GameStat::GameStat(const GameStartInfo &info)
-    : mCurrentPlayer(info.mFirstPlayer), 
+    : mPlayerNum(Common::Common::mPlayerNum),
+    mCurrentPlayer(info.mFirstPlayer), 
     mIsInClockwise(info.mFlippedCard.mText != CardText::REVERSE),
     mLastPlayedCard(info.mFlippedCard) {}
 
-GameStat::GameStat(int firstPlayer, Card flippedCard)
-    : mCurrentPlayer(firstPlayer),
+GameStat::GameStat(int firstPlayer, Card flippedCard, int playerNum)
+    : mPlayerNum(playerNum),
+    mCurrentPlayer(firstPlayer),
     mIsInClockwise(flippedCard.mText != CardText::REVERSE) {}
 
 void GameStat::NextPlayer()
 {
     mCurrentPlayer = mIsInClockwise ? 
-        Common::Util::WrapWithPlayerNum(mCurrentPlayer + 1) :
-        Common::Util::WrapWithPlayerNum(mCurrentPlayer - 1);
+        Common::Util::Wrap(mCurrentPlayer + 1, mPlayerNum) :
+        Common::Util::Wrap(mCurrentPlayer - 1, mPlayerNum);
     mTimeElapsed = 0;
     mCurrentPhase = TurnPhase::START; // 新回合开始
     mSpecialEffectActive = false; // 新回合开始时重置特殊效果状态
@@ -35,7 +35,7 @@ public:
     GameStat(const GameStartInfo &info);
 
     /// constructor for \c GameBoard
-    GameStat(int firstPlayer, Card flippedCard);
+    GameStat(int firstPlayer, Card flippedCard, int playerNum);
     
     void NextPlayer();
 
@@ -87,6 +87,7 @@ public:
     void SetCardsNumToDraw(int cardsNumToDraw) { mCardsNumToDraw = cardsNumToDraw; }
 
 private:
+    int mPlayerNum;
     int mCurrentPlayer;
     bool mIsInClockwise;
     bool mGameEnds{false};
@@ -141,6 +142,12 @@ public:
     // for test
     void SetLastPlayedCard(Card lastPlayedCard) { mLastPlayedCard = lastPlayedCard; }
 
+    // restore the state of the last round, e.g. from a snapshot
+    void RestoreState(bool doPlayInLastRound, Card lastPlayedCard) {
+        mDoPlayInLastRound = doPlayInLastRound;
+        mLastPlayedCard = lastPlayedCard;
+    }
+
 private:
     const std::string mUsername;
     std::unique_ptr<Character> mCharacter;  // 角色指针
@@ -175,6 +182,13 @@ public:
     // 新增：技能效果应用方法
     virtual void ApplySkillEffect(GameStat& gameStat, PlayerStat& playerStat) {}
 
+    // restore the skill state, e.g. from a snapshot
+    void RestoreState(int usesRemaining, int cooldown, bool isInCooldown) {
+        mUsesRemaining = usesRemaining;
+        mCooldown = cooldown;
+        mIsInCooldown = isInCooldown;
+    }
+
 protected:
     CharacterType mType;
     std::string mName;
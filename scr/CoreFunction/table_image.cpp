@@ -0,0 +1,140 @@
+#include <algorithm>
+#include <cstdio>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define UNO_HAS_MMAP
+#endif
+
+#include "table_image.h"
+#include "stat.h"
+
+namespace UNO { namespace Game {
+
+namespace {
+
+bool IsValidColor(uint8_t color)
+{
+    return color <= static_cast<uint8_t>(CardColor::BLACK);
+}
+
+// a card as the last played one may be the empty card, before anything has been played
+bool IsValidCard(PackedCard card)
+{
+    return Common::CardCode::FromByte(card.mCode).IsValid();
+}
+
+// a card of the deck or the discard pile must be a real one
+bool IsRealCard(PackedCard card)
+{
+    auto code = Common::CardCode::FromByte(card.mCode);
+    return code.IsValid() && code.GetCategory() != Common::CardCategory::NONE;
+}
+
+bool IsValidHeader(const TableImageHeader &header)
+{
+    int seatNum = header.mSeatNum;
+    return seatNum > 0 && seatNum <= TableImage::MAX_SEAT_NUM
+        && header.mCurrentPlayer >= 0 && header.mCurrentPlayer < seatNum
+        && (header.mFlags & ~TableImageHeader::FLAG_MASK) == 0
+        && header.mCurrentPhase <= static_cast<uint8_t>(GameStat::TurnPhase::END)
+        && IsValidCard(header.mLastPlayedCard)
+        && header.mCardsNumToDraw >= 1
+        && IsValidColor(header.mFlashEffectColor)
+        && header.mFlashCardsPlayed >= 0 && header.mFlashCardsPlayed < seatNum
+        && header.mPackagePlayerIndex >= -1 && header.mPackagePlayerIndex < seatNum
+        && IsValidColor(header.mPackageTargetColor);
+}
+
+bool IsValidSeat(const TableImageSeat &seat)
+{
+    bool hasCharacter = seat.mFlags & TableImageSeat::FLAG_HAS_CHARACTER;
+    return std::memchr(seat.mUsername, '\0', sizeof(seat.mUsername)) != nullptr
+        && seat.mRemainingHandCardsNum >= 0
+        && seat.mCharacterType <= static_cast<uint8_t>(CharacterType::NONE)
+        && hasCharacter == (seat.mCharacterType != static_cast<uint8_t>(CharacterType::NONE))
+        && seat.mUsesRemaining >= 0 && seat.mCooldown >= 0
+        && (seat.mFlags & ~TableImageSeat::FLAG_MASK) == 0
+        && IsValidCard(seat.mLastPlayedCard);
+}
+}
+
+bool TableImageView::Parse(const uint8_t *data, std::size_t size)
+{
+    if (size < sizeof(TableImageHeader)) {
+        return false;
+    }
+    std::memcpy(&mHeader, data, sizeof(TableImageHeader));
+    if (mHeader.mMagic != TableImage::MAGIC || mHeader.mVersion != TableImage::VERSION
+        || mHeader.mHeaderSize != sizeof(TableImageHeader)) {
+        return false;
+    }
+    if (mHeader.mTotalSize > size || mHeader.mTotalSize != TableImage::SizeOf(
+        mHeader.mSeatNum, mHeader.mDeckSize, mHeader.mDiscardPileSize)) {
+        return false;
+    }
+
+    if (!IsValidHeader(mHeader)) {
+        return false;
+    }
+
+    mSeats = data + sizeof(TableImageHeader);
+    mDeck = reinterpret_cast<const PackedCard *>(mSeats + mHeader.mSeatNum * sizeof(TableImageSeat));
+    mDiscardPile = mDeck + mHeader.mDeckSize;
+    for (int i = 0; i < mHeader.mSeatNum; i++) {
+        if (!IsValidSeat(GetSeat(i))) {
+            return false;
+        }
+    }
+    return std::all_of(mDeck, mDeck + mHeader.mDeckSize, IsRealCard)
+        && std::all_of(mDiscardPile, mDiscardPile + mHeader.mDiscardPileSize, IsRealCard);
+}
+
+MappedFile::MappedFile(const std::string &path)
+{
+#ifdef UNO_HAS_MMAP
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return;
+    }
+    struct stat st;
+    if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+        void *addr = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr != MAP_FAILED) {
+            mData = static_cast<const uint8_t *>(addr);
+            mSize = st.st_size;
+            mIsMapped = true;
+        }
+    }
+    ::close(fd);
+#else
+    std::FILE *file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        return;
+    }
+    uint8_t chunk[4096];
+    std::size_t n;
+    while ((n = std::fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        mBuffer.insert(mBuffer.end(), chunk, chunk + n);
+    }
+    std::fclose(file);
+    if (!mBuffer.empty()) {
+        mData = mBuffer.data();
+        mSize = mBuffer.size();
+    }
+#endif
+}
+
+MappedFile::~MappedFile()
+{
+#ifdef UNO_HAS_MMAP
+    if (mIsMapped) {
+        ::munmap(const_cast<uint8_t *>(mData), mSize);
+    }
+#endif
+}
+
+}}
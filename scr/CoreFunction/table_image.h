@@ -0,0 +1,168 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <type_traits>
+
+#include "card_view.h"
+
+namespace UNO { namespace Game {
+
+/**
+ * Binary image of a whole table, used both for live migration of a table to
+ * another process and for the snapshots of the journal.
+ *
+ * Layout (every field is fixed-width and little-endian, there is no padding
+ * the compiler may choose and no pointer, so the image can be read right off
+ * a mmap-ed file):
+ *   TableImageHeader
+ *   TableImageSeat[mSeatNum]
+ *   PackedCard[mDeckSize]         deck, the top card first
+ *   PackedCard[mDiscardPileSize]  discard pile, the bottom card first
+ */
+struct PackedCard {
+    uint8_t mCode;  // a Common::CardCode
+
+    static PackedCard Pack(Card card) {
+        return {ToCode(card).ToByte()};
+    }
+
+    Card Unpack() const {
+        return FromCode(Common::CardCode::FromByte(mCode));
+    }
+};
+static_assert(sizeof(PackedCard) == 1, "cards must be packed into 1 byte");
+
+struct TableImageHeader {
+    uint32_t mMagic;
+    uint16_t mVersion;
+    uint16_t mHeaderSize;
+    uint32_t mTotalSize;
+    uint16_t mDeckSize;
+    uint16_t mDiscardPileSize;
+
+    // GameStat
+    uint8_t mSeatNum;
+    int8_t mCurrentPlayer;
+    uint8_t mFlags;
+    uint8_t mCurrentPhase;
+    PackedCard mLastPlayedCard;
+    uint8_t mReserved;
+    int16_t mCardsNumToDraw;
+
+    // effects of Flash and Package cards
+    uint8_t mFlashEffectColor;
+    int8_t mFlashCardsPlayed;
+    int8_t mPackagePlayerIndex;
+    uint8_t mPackageTargetColor;
+
+    // state of the table's random engine
+    uint32_t mRandomSeed;
+    uint64_t mRandomDraws;
+
+    // bits of mFlags
+    constexpr static uint8_t FLAG_CLOCKWISE = 1 << 0;
+    constexpr static uint8_t FLAG_GAME_ENDS = 1 << 1;
+    constexpr static uint8_t FLAG_SPECIAL_EFFECT = 1 << 2;
+    constexpr static uint8_t FLAG_FLASH_ACTIVE = 1 << 3;
+    constexpr static uint8_t FLAG_PACKAGE_ACTIVE = 1 << 4;
+    constexpr static uint8_t FLAG_MASK = (1 << 5) - 1;
+};
+static_assert(sizeof(TableImageHeader) == 40, "layout of TableImageHeader must not change silently");
+
+struct TableImageSeat {
+    char mUsername[32];  // NUL-terminated, longer usernames are truncated
+    int16_t mRemainingHandCardsNum;
+    uint8_t mCharacterType;
+    int8_t mUsesRemaining;
+    int8_t mCooldown;
+    uint8_t mFlags;
+    PackedCard mLastPlayedCard;
+    uint8_t mReserved;
+
+    // bits of mFlags
+    constexpr static uint8_t FLAG_HAS_CHARACTER = 1 << 0;
+    constexpr static uint8_t FLAG_IN_COOLDOWN = 1 << 1;
+    constexpr static uint8_t FLAG_SKILL_USED = 1 << 2;
+    constexpr static uint8_t FLAG_AFFECTED_BY_FLASH = 1 << 3;
+    constexpr static uint8_t FLAG_PLAYED_IN_LAST_ROUND = 1 << 4;
+    constexpr static uint8_t FLAG_MASK = (1 << 5) - 1;
+};
+static_assert(sizeof(TableImageSeat) == 40, "layout of TableImageSeat must not change silently");
+
+static_assert(std::is_trivially_copyable<TableImageHeader>::value
+    && std::is_trivially_copyable<TableImageSeat>::value, "image records must be plain bytes");
+
+namespace TableImage {
+    // the magic doubles as a byte order mark, an image of the other byte order is rejected
+    constexpr uint32_t MAGIC = 0x554e4f54;  // "UNOT"
+    // bump it whenever the layout changes
+    constexpr uint16_t VERSION = 2;
+    // seats are indexed by an int8_t here and in the journal
+    constexpr int MAX_SEAT_NUM = INT8_MAX;
+
+    inline std::size_t SizeOf(int seatNum, int deckSize, int discardPileSize) {
+        return sizeof(TableImageHeader) + seatNum * sizeof(TableImageSeat)
+            + (deckSize + discardPileSize) * sizeof(PackedCard);
+    }
+}
+
+/**
+ * Read-only view of an image. It never copies the cards, and is valid as long as
+ * the underlying bytes are, which need no particular alignment.
+ */
+class TableImageView {
+public:
+    /**
+     * Check that \p data holds an image this version can read, and that every field of it
+     * describes a table that can be run: seats and cards within range and agreeing with the header.
+     *   \return false if it is truncated, of another version, inconsistent or not an image at all
+     */
+    bool Parse(const uint8_t *data, std::size_t size);
+
+    const TableImageHeader &GetHeader() const { return mHeader; }
+
+    TableImageSeat GetSeat(int index) const {
+        TableImageSeat seat;
+        std::memcpy(&seat, mSeats + index * sizeof(TableImageSeat), sizeof(TableImageSeat));
+        return seat;
+    }
+
+    Card GetDeckCard(int index) const { return mDeck[index].Unpack(); }
+
+    Card GetDiscardPileCard(int index) const { return mDiscardPile[index].Unpack(); }
+
+private:
+    TableImageHeader mHeader;
+    const uint8_t *mSeats{nullptr};
+    const PackedCard *mDeck{nullptr};
+    const PackedCard *mDiscardPile{nullptr};
+};
+
+/**
+ * A file mapped into memory read-only, or read into a buffer where mmap is not available.
+ */
+class MappedFile {
+public:
+    explicit MappedFile(const std::string &path);
+
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    bool IsOpen() const { return mData != nullptr; }
+
+    const uint8_t *GetData() const { return mData; }
+
+    std::size_t GetSize() const { return mSize; }
+
+private:
+    const uint8_t *mData{nullptr};
+    std::size_t mSize{0};
+    bool mIsMapped{false};
+    std::vector<uint8_t> mBuffer;
+};
+}}
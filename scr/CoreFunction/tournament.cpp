@@ -0,0 +1,278 @@
+#include <algorithm>
+#include <iomanip>
+#include <numeric>
+#include <stdexcept>
+
+#include "tournament.h"
+#include "../common/logger.h"
+
+namespace UNO { namespace Game {
+
+Tournament::Tournament(std::vector<std::string> roster, const TournamentConfig &config, MatchRunner runner)
+    : mConfig(config),
+    mRunner(std::move(runner)),
+    mPool(config.mThreadNum),
+    mRatings(roster.size()),
+    mRatingUpdater(config.mRatingSystem)
+{
+    if (mConfig.mSeatNum < 2 || roster.size() < static_cast<std::size_t>(mConfig.mSeatNum)) {
+        throw std::invalid_argument("a tournament needs at least one full table");
+    }
+    for (auto &name : roster) {
+        mStandings.emplace_back();
+        mStandings.back().mName = std::move(name);
+    }
+}
+
+void Tournament::Run()
+{
+    while (true) {
+        auto matches = ScheduleRound();
+        if (matches.empty()) {
+            break;
+        }
+        UNO_LOG_INFO("tournament round {}: {} matches", mRound, matches.size());
+        PlayRound(matches);
+        ApplyRound(matches);
+        mMatches.insert(mMatches.end(), matches.begin(), matches.end());
+        mRound++;
+    }
+}
+
+std::vector<Match> Tournament::ScheduleRound()
+{
+    mByes.clear();
+    switch (mConfig.mFormat) {
+        case TournamentFormat::ROUND_ROBIN:
+            return ScheduleRoundRobin();
+        case TournamentFormat::SWISS:
+            return ScheduleSwiss();
+        case TournamentFormat::KNOCKOUT:
+            return ScheduleKnockout();
+    }
+    return {};
+}
+
+std::vector<Match> Tournament::ScheduleRoundRobin()
+{
+    std::vector<Match> matches;
+    if (mRound > 0) {
+        return matches;
+    }
+    // enumerate every group of mSeatNum entrants in lexicographic order
+    int entrantNum = mStandings.size();
+    std::vector<int> group(mConfig.mSeatNum);
+    std::iota(group.begin(), group.end(), 0);
+    while (true) {
+        for (int game = 0; game < mConfig.mGamesPerMatch; game++) {
+            Match match{};
+            match.mRound = mRound;
+            match.mSeats = group;
+            std::rotate(match.mSeats.begin(), match.mSeats.begin() + game % mConfig.mSeatNum, match.mSeats.end());
+            matches.push_back(std::move(match));
+        }
+
+        int i = mConfig.mSeatNum - 1;
+        while (i >= 0 && group[i] == entrantNum - mConfig.mSeatNum + i) {
+            i--;
+        }
+        if (i < 0) {
+            break;
+        }
+        group[i]++;
+        for (int j = i + 1; j < mConfig.mSeatNum; j++) {
+            group[j] = group[j - 1] + 1;
+        }
+    }
+    return matches;
+}
+
+std::vector<Match> Tournament::ScheduleSwiss()
+{
+    std::vector<Match> matches;
+    int rounds = mConfig.mRounds;
+    if (rounds == 0) {
+        for (std::size_t covered = 1; covered < mStandings.size(); covered *= mConfig.mSeatNum) {
+            rounds++;
+        }
+    }
+    if (mRound >= rounds) {
+        return matches;
+    }
+
+    std::vector<int> entrants(mStandings.size());
+    std::iota(entrants.begin(), entrants.end(), 0);
+    std::stable_sort(entrants.begin(), entrants.end(), [this](int lhs, int rhs) {
+        if (mStandings[lhs].mPoints != mStandings[rhs].mPoints) {
+            return mStandings[lhs].mPoints > mStandings[rhs].mPoints;
+        }
+        return mRatings[lhs].mRating > mRatings[rhs].mRating;
+    });
+    SeatInOrder(entrants, matches);
+    return matches;
+}
+
+std::vector<Match> Tournament::ScheduleKnockout()
+{
+    std::vector<Match> matches;
+    std::vector<int> entrants;
+    for (int i = 0; i < static_cast<int>(mStandings.size()); i++) {
+        if (!mStandings[i].mIsEliminated) {
+            entrants.push_back(i);
+        }
+    }
+    if (entrants.size() < 2) {
+        return matches;
+    }
+    if (entrants.size() <= static_cast<std::size_t>(mConfig.mSeatNum)) {
+        SeatInOrder(entrants, matches);
+        return matches;
+    }
+
+    // the strongest entrants get the byes, and the rest are spread over the tables
+    // like seeding a bracket
+    std::stable_sort(entrants.begin(), entrants.end(), [this](int lhs, int rhs) {
+        return mRatings[lhs].mRating > mRatings[rhs].mRating;
+    });
+    std::size_t byeNum = entrants.size() % mConfig.mSeatNum;
+    std::size_t tableNum = entrants.size() / mConfig.mSeatNum;
+    std::vector<int> seeded;
+    for (std::size_t table = 0; table < tableNum; table++) {
+        for (std::size_t i = byeNum + table; i < entrants.size(); i += tableNum) {
+            seeded.push_back(entrants[i]);
+        }
+    }
+    SeatInOrder(seeded, matches);
+    mByes.assign(entrants.begin(), entrants.begin() + byeNum);
+    return matches;
+}
+
+void Tournament::SeatInOrder(const std::vector<int> &entrants, std::vector<Match> &matches)
+{
+    std::size_t seatNum = mConfig.mSeatNum;
+    std::size_t seated = entrants.size() / seatNum * seatNum;
+    if (seated == 0) {
+        // fewer entrants than seats, e.g. the last two of a knockout of 3-player tables
+        seated = entrants.size();
+        seatNum = entrants.size();
+    }
+    for (std::size_t i = 0; i < seated; i += seatNum) {
+        Match match{};
+        match.mRound = mRound;
+        match.mSeats.assign(entrants.begin() + i, entrants.begin() + i + seatNum);
+        matches.push_back(std::move(match));
+    }
+    mByes.assign(entrants.begin() + seated, entrants.end());
+}
+
+void Tournament::PlayRound(std::vector<Match> &matches)
+{
+    for (std::size_t i = 0; i < matches.size(); i++) {
+        matches[i].mSeed = SeedOf(mMatches.size() + i);
+        // each match writes its own slot only, so the results need no lock
+        Match *match = &matches[i];
+        mPool.Submit([this, match] {
+            mRunner(*match);
+            if (match->mPlaces.size() != match->mSeats.size()) {
+                throw std::runtime_error("match runner did not report a place for every seat");
+            }
+        });
+    }
+    mPool.Wait();
+}
+
+void Tournament::ApplyRound(const std::vector<Match> &matches)
+{
+    std::vector<RatedGame> games;
+    for (const auto &match : matches) {
+        int seatNum = match.mSeats.size();
+        for (int seat = 0; seat < seatNum; seat++) {
+            Standing &standing = mStandings[match.mSeats[seat]];
+            standing.mGames++;
+            // a place is worth a point for every player finishing behind
+            standing.mPoints += seatNum - 1 - match.mPlaces[seat];
+            if (match.mPlaces[seat] == 0) {
+                standing.mWins++;
+            }
+            else if (mConfig.mFormat == TournamentFormat::KNOCKOUT) {
+                standing.mIsEliminated = true;
+            }
+        }
+        games.push_back({match.mSeats, match.mPlaces});
+    }
+    // a bye is worth a win
+    for (int entrant : mByes) {
+        mStandings[entrant].mPoints += mConfig.mSeatNum - 1;
+    }
+    mRatingUpdater.Update(mRatings, games);
+}
+
+uint32_t Tournament::SeedOf(int matchIndex) const
+{
+    // splitmix64, so that neighbouring matches get unrelated seeds
+    uint64_t z = (static_cast<uint64_t>(mConfig.mSeed) << 32) + matchIndex + 0x9e3779b97f4a7c15ULL;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return static_cast<uint32_t>(z ^ (z >> 31));
+}
+
+std::vector<Standing> Tournament::GetStandings() const
+{
+    std::vector<Standing> standings = mStandings;
+    for (std::size_t i = 0; i < standings.size(); i++) {
+        standings[i].mRating = mRatings[i];
+    }
+    std::stable_sort(standings.begin(), standings.end(), [](const Standing &lhs, const Standing &rhs) {
+        if (lhs.mIsEliminated != rhs.mIsEliminated) {
+            return !lhs.mIsEliminated;
+        }
+        if (lhs.mPoints != rhs.mPoints) {
+            return lhs.mPoints > rhs.mPoints;
+        }
+        return lhs.mRating.mRating > rhs.mRating.mRating;
+    });
+    return standings;
+}
+
+void Tournament::WriteReport(std::ostream &os) const
+{
+    os << std::left << std::setw(20) << "player" << std::right << std::setw(8) << "points"
+       << std::setw(8) << "games" << std::setw(8) << "wins" << std::setw(10) << "rating"
+       << std::setw(8) << "rd" << "\n";
+    os << std::fixed << std::setprecision(1);
+    for (const auto &standing : GetStandings()) {
+        os << std::left << std::setw(20) << standing.mName << std::right
+           << std::setw(8) << standing.mPoints << std::setw(8) << standing.mGames
+           << std::setw(8) << standing.mWins << std::setw(10) << standing.mRating.mRating
+           << std::setw(8) << standing.mRating.mDeviation << "\n";
+    }
+
+    // win rate of each character type against the rate of a random seat
+    int games[4] = {0};
+    double wins[4] = {0};
+    double expectedWins[4] = {0};
+    for (const auto &match : mMatches) {
+        for (std::size_t seat = 0; seat < match.mCharacters.size(); seat++) {
+            int type = static_cast<int>(match.mCharacters[seat]);
+            if (type < 4) {
+                games[type]++;
+                wins[type] += (match.mPlaces[seat] == 0);
+                expectedWins[type] += 1.0 / match.mSeats.size();
+            }
+        }
+    }
+    if (std::accumulate(games, games + 4, 0) > 0) {
+        os << std::setprecision(3) << "\n" << std::left << std::setw(20) << "character" << std::right << std::setw(8) << "games"
+           << std::setw(10) << "win rate" << std::setw(10) << "expected" << "\n";
+        for (int type = 0; type < 4; type++) {
+            if (games[type] > 0) {
+                os << std::left << std::setw(20)
+                   << CharacterFactory::GetCharacterName(static_cast<CharacterType>(type)) << std::right
+                   << std::setw(8) << games[type] << std::setw(10) << wins[type] / games[type]
+                   << std::setw(10) << expectedWins[type] / games[type] << "\n";
+            }
+        }
+    }
+}
+
+}}
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "stat.h"
+#include "rating.h"
+#include "../common/thread_pool.h"
+
+namespace UNO { namespace Game {
+
+enum class TournamentFormat {
+    ROUND_ROBIN,  // every group of mSeatNum entrants meets mGamesPerMatch times
+    SWISS,        // mRounds rounds, entrants with similar points meet
+    KNOCKOUT      // the winner of each table advances until one is left
+};
+
+struct TournamentConfig {
+    TournamentFormat mFormat{TournamentFormat::ROUND_ROBIN};
+    int mSeatNum{2};
+    // rounds of a Swiss tournament, 0 for as many as needed to rank the entrants
+    int mRounds{0};
+    // games per group of a round robin, the seats rotate between them
+    int mGamesPerMatch{1};
+    RatingSystem mRatingSystem{RatingSystem::ELO};
+    uint32_t mSeed{0};
+    int mThreadNum = std::thread::hardware_concurrency();
+};
+
+/**
+ * One game of a tournament. The scheduler fills in the seating and the seed,
+ * the runner plays the game on a headless table and fills in the outcome.
+ */
+struct Match {
+    int mRound;
+    std::vector<int> mSeats;  // entrant of each seat
+    uint32_t mSeed;           // the game must be reproducible from it
+
+    // outcome, filled in by the runner
+    std::vector<int> mPlaces;  // place of each seat, 0 is the winner
+    std::vector<CharacterType> mCharacters;  // character of each seat, empty if none are assigned
+    int mTurns{0};
+};
+
+/**
+ * Plays \p match to the end. Called concurrently from the workers of the tournament,
+ * so it must not share mutable state between calls.
+ */
+using MatchRunner = std::function<void(Match &match)>;
+
+struct Standing {
+    std::string mName;
+    Rating mRating;
+    int mPoints{0};
+    int mGames{0};
+    int mWins{0};
+    bool mIsEliminated{false};
+};
+
+/**
+ * Runs a tournament of a roster of players or bots. The matches of a round are
+ * independent and played in parallel across a work-stealing thread pool; ratings
+ * and standings are updated once the round is over, in schedule order, so that
+ * a tournament is reproducible from its seed regardless of the thread count.
+ */
+class Tournament {
+public:
+    Tournament(std::vector<std::string> roster, const TournamentConfig &config, MatchRunner runner);
+
+    /**
+     * Play all rounds.
+     */
+    void Run();
+
+    /**
+     * Standings ordered by points and rating, the first is the champion.
+     */
+    std::vector<Standing> GetStandings() const;
+
+    const std::vector<Match> &GetMatches() const { return mMatches; }
+
+    /**
+     * Write the standings and the win rates of each character type, for balance checks.
+     */
+    void WriteReport(std::ostream &os) const;
+
+private:
+    /**
+     * Seat the matches of the next round.
+     *   \return no matches when the tournament is over
+     */
+    std::vector<Match> ScheduleRound();
+
+    std::vector<Match> ScheduleRoundRobin();
+
+    std::vector<Match> ScheduleSwiss();
+
+    std::vector<Match> ScheduleKnockout();
+
+    /**
+     * Seat \p entrants at tables of mSeatNum in order, the remaining ones get a bye.
+     */
+    void SeatInOrder(const std::vector<int> &entrants, std::vector<Match> &matches);
+
+    void PlayRound(std::vector<Match> &matches);
+
+    void ApplyRound(const std::vector<Match> &matches);
+
+    uint32_t SeedOf(int matchIndex) const;
+
+private:
+    const TournamentConfig mConfig;
+    const MatchRunner mRunner;
+    Common::ThreadPool mPool;
+
+    std::vector<Standing> mStandings;
+    std::vector<Rating> mRatings;
+    RatingUpdater mRatingUpdater;
+
+    int mRound{0};
+    std::vector<int> mByes;  // entrants with a bye in the current round
+    std::vector<Match> mMatches;
+};
+}}
@@ -0,0 +1,92 @@
+#include "CardPiles.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace UNO {
+
+void CardPiles::reset(size_t newCapacity) {
+    if (newCapacity != capacity) {
+        codes = std::make_unique<Common::CardCode[]>(newCapacity);
+        capacity = newCapacity;
+    }
+    clear();
+}
+
+void CardPiles::pushDraw(Common::CardCode code) {
+    if (drawSize + discardSize >= capacity) {
+        throw std::length_error("card piles are full");
+    }
+    codes[drawSize++] = code;
+    unshuffledCount = drawSize;
+}
+
+void CardPiles::pushDiscard(Common::CardCode code) {
+    if (drawSize + discardSize >= capacity) {
+        throw std::length_error("card piles are full");
+    }
+    discardSize++;
+    codes[capacity - discardSize] = code;
+}
+
+void CardPiles::shuffleTop(size_t count, Common::ShuffleRng& rng) {
+    size_t shuffledFrom = drawSize - std::min(count, drawSize);
+    if (unshuffledCount > shuffledFrom) {
+        // 从还没洗的牌中逐张随机选一张放到当前位置，分几次洗和一次洗完的结果相同
+        Common::ShuffleTail(std::span(codes.get(), capacity), unshuffledCount, shuffledFrom, rng);
+        unshuffledCount = shuffledFrom;
+    }
+}
+
+size_t CardPiles::draw(std::span<Common::CardCode> out, size_t count, Common::ShuffleRng& rng) {
+    size_t n = std::min({count, out.size(), drawSize});
+    shuffleTop(n, rng);
+    // 顶部是连续的一段，倒序复制即为抽牌顺序
+    std::reverse_copy(codes.get() + drawSize - n, codes.get() + drawSize, out.begin());
+    drawSize -= n;
+    return n;
+}
+
+std::span<const Common::CardCode> CardPiles::peek(size_t count, Common::ShuffleRng& rng) {
+    size_t n = std::min(count, drawSize);
+    shuffleTop(n, rng);
+    return {codes.get() + drawSize - n, n};
+}
+
+Common::CardCode CardPiles::extractAt(size_t index) {
+    if (index >= drawSize) {
+        throw std::out_of_range("not enough cards in the draw pile");
+    }
+    size_t position = drawSize - 1 - index;
+    Common::CardCode code = codes[position];
+    std::copy(codes.get() + position + 1, codes.get() + drawSize, codes.get() + position);
+    drawSize--;
+    // 取出的牌在还没洗的部分时，没洗的部分也少了一张
+    if (position < unshuffledCount) {
+        unshuffledCount--;
+    }
+    return code;
+}
+
+size_t CardPiles::reshuffleFromDiscard() {
+    if (discardSize <= 1) {
+        return 0; // 需要至少一张牌在弃牌堆中（顶牌）
+    }
+
+    Common::CardCode topCard = codes[capacity - discardSize];
+    size_t added = discardSize - 1;
+    // 顶牌下面的牌紧接着抽牌堆放好，目标位置总在源位置之前，顺序复制不会覆盖还没复制的牌
+    Common::CardCode *below = codes.get() + capacity - added;
+    std::copy(below, below + added, codes.get() + drawSize);
+    // 抽牌堆原有的牌仍在上面（通常抽牌堆此时为空，什么也不做）
+    std::rotate(codes.get(), codes.get() + drawSize, codes.get() + drawSize + added);
+    drawSize += added;
+
+    codes[capacity - 1] = topCard;
+    discardSize = 1;
+
+    // 新加入的牌和底部原本没洗的牌都排在底部，在被抽到前逐张洗
+    unshuffledCount += added;
+    return added;
+}
+
+} // namespace UNO
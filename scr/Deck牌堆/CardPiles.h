@@ -0,0 +1,108 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include "../CoreFunction/common/card_code.h"
+#include "../CoreFunction/common/shuffle.h"
+
+namespace UNO {
+
+/**
+ * 抽牌堆和弃牌堆共用的一块定长数组，每张牌占一个字节（Common::CardCode）。
+ * 数组在牌局创建时按整副牌的张数分配一次，之后抽牌、弃牌、重洗都只在数组内
+ * 移动下标和交换元素，不再分配内存。
+ *
+ * 布局（capacity 为整副牌的张数）：
+ *   [0, drawSize)                       抽牌堆，底牌在前，顶牌在 drawSize - 1
+ *   [drawSize, capacity - discardSize)  空位，对应在玩家手中的牌
+ *   [capacity - discardSize, capacity)  弃牌堆，顶牌在前，底牌在 capacity - 1
+ * 两个牌堆相向增长，手牌之外的每张牌都恰好占一个位置，所以不会溢出。
+ */
+class CardPiles {
+public:
+    CardPiles() = default;
+    explicit CardPiles(size_t capacity) { reset(capacity); }
+
+    /**
+     * 设置容量并清空两个牌堆，容量不变时不重新分配
+     */
+    void reset(size_t capacity);
+
+    /**
+     * 清空两个牌堆，保留容量
+     */
+    void clear() { drawSize = 0; discardSize = 0; unshuffledCount = 0; }
+
+    size_t getCapacity() const { return capacity; }
+
+    // 抽牌堆
+    size_t getDrawSize() const { return drawSize; }
+    std::span<const Common::CardCode> getDrawPile() const { return {codes.get(), drawSize}; }
+
+    /**
+     * 把一张牌放到抽牌堆顶部，用于组牌和恢复牌局，放入的牌视为还没洗
+     */
+    void pushDraw(Common::CardCode code);
+
+    /**
+     * 把整个抽牌堆标记为还没洗，之后逐张在被抽到前洗好
+     */
+    void markUnshuffled() { unshuffledCount = drawSize; }
+
+    /**
+     * 从抽牌堆顶部抽取最多 count 张牌写入 out，out[0] 是原来的顶牌。不会自动重洗。
+     * @return 实际抽到的张数
+     */
+    size_t draw(std::span<Common::CardCode> out, size_t count, Common::ShuffleRng& rng);
+
+    /**
+     * 查看抽牌堆顶部最多 count 张牌，不取出。这几张会先洗好，之后抽到的顺序和看到的一致；
+     * 洗牌本来就在牌被抽到前才进行，提前洗不改变牌的分布。
+     * @return 顶部的牌，顶牌在最后（和抽牌堆在数组中的顺序一致）
+     */
+    std::span<const Common::CardCode> peek(size_t count, Common::ShuffleRng& rng);
+
+    /**
+     * 取出从顶部数第 index 张牌（0 是顶牌），它上面的牌各下移一格，其余牌不动
+     * @throws std::out_of_range 抽牌堆没有这么多牌
+     */
+    Common::CardCode extractAt(size_t index);
+
+    // 弃牌堆
+    size_t getDiscardSize() const { return discardSize; }
+    std::span<const Common::CardCode> getDiscardPile() const { return {codes.get() + capacity - discardSize, discardSize}; }
+    Common::CardCode getTopDiscard() const { return discardSize > 0 ? codes[capacity - discardSize] : Common::CardCode(); }
+
+    /**
+     * 把一张牌放到弃牌堆顶部
+     * @throws std::length_error 两个牌堆已经占满了数组，说明这张牌不属于这副牌
+     */
+    void pushDiscard(Common::CardCode code);
+
+    /**
+     * 把弃牌堆中除顶牌外的所有牌移到抽牌堆底部。只移动数组中的元素，不分配内存；
+     * 移过去的牌在被抽到前才逐张洗。
+     * @return 移动的张数
+     */
+    size_t reshuffleFromDiscard();
+
+    size_t getUnshuffledCount() const { return unshuffledCount; }
+    void setUnshuffledCount(size_t count) { unshuffledCount = std::min(count, drawSize); }
+
+private:
+    /**
+     * 确保抽牌堆顶部 count 张牌已经洗好（从顶部往下逐张进行的 Fisher-Yates）
+     */
+    void shuffleTop(size_t count, Common::ShuffleRng& rng);
+
+private:
+    std::unique_ptr<Common::CardCode[]> codes;
+    size_t capacity = 0;
+    size_t drawSize = 0;
+    size_t discardSize = 0;
+    // 抽牌堆底部 [0, unshuffledCount) 的牌还没有洗，其余部分已是随机顺序
+    size_t unshuffledCount = 0;
+};
+
+} // namespace UNO
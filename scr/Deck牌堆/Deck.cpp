@@ -1,10 +1,14 @@
 #include "Deck.h"
+#include "CardFactory.h"
 #include <algorithm>
 #include <random>
 
 namespace UNO {
 
-Deck::Deck() : randomGenerator(std::random_device{}()) {}
+Deck::Deck(int deckNum) : deckNum(std::max(deckNum, 1)) {
+    std::random_device device;
+    randomGenerator.Seed((static_cast<uint64_t>(device()) << 32) | device());
+}
 
 void Deck::initialize() {
     clear();
@@ -13,125 +17,119 @@ void Deck::initialize() {
 }
 
 void Deck::clear() {
-    drawPile.clear();
-    discardPile.clear();
+    piles.clear();
 }
 
 void Deck::createStandardDeck() {
-    int cardId = 1;
-    
-    // 创建数字卡 (0-9，每种颜色0号一张，1-9各两张)
-    for (auto color : {CardColor::RED, CardColor::YELLOW, CardColor::GREEN, CardColor::BLUE}) {
-        // 数字0，每种颜色一张
-        drawPile.push_back(createCard(CardType::NUMBER, cardId++, color, 0));
-        
-        // 数字1-9，每种颜色两张
-        for (int number = 1; number <= 9; number++) {
-            drawPile.push_back(createCard(CardType::NUMBER, cardId++, color, number));
-            drawPile.push_back(createCard(CardType::NUMBER, cardId++, color, number));
+    // 整个牌靴的位置在第一局分配好，之后的牌局重用。
+    // 各副牌中相同的牌编码相同，可以互相替换，所以多副牌不需要额外区分
+    piles.reset(getShoeSize());
+    for (int deck = 0; deck < deckNum; deck++) {
+        for (auto code : getStandardDeck()) {
+            piles.pushDraw(code);
         }
     }
-    
-    // 创建标准功能卡 (Skip, Reverse, Draw Two)，每种颜色两张
-    for (auto color : {CardColor::RED, CardColor::YELLOW, CardColor::GREEN, CardColor::BLUE}) {
-        for (int i = 0; i < 2; i++) {
-            drawPile.push_back(createCard(CardType::SKIP, cardId++, color));
-            drawPile.push_back(createCard(CardType::REVERSE, cardId++, color));
-            drawPile.push_back(createCard(CardType::DRAW_TWO, cardId++, color));
+}
+
+std::span<const Common::CardCode> Deck::getStandardDeck() {
+    static const std::vector<Common::CardCode> standardDeck = [] {
+        std::vector<Common::CardCode> codes;
+        auto add = [&codes](CardType type, CardColor color = CardColor::WILD, int number = -1) {
+            codes.push_back(CardData(-1, color, type, number).toCode());
+        };
+        
+        // 创建数字卡 (0-9，每种颜色0号一张，1-9各两张)
+        for (auto color : {CardColor::RED, CardColor::YELLOW, CardColor::GREEN, CardColor::BLUE}) {
+            // 数字0，每种颜色一张
+            add(CardType::NUMBER, color, 0);
+        
+            // 数字1-9，每种颜色两张
+            for (int number = 1; number <= 9; number++) {
+                add(CardType::NUMBER, color, number);
+                add(CardType::NUMBER, color, number);
+            }
         }
-    }
     
-    // 创建万能卡 (Wild, Wild Draw Four)，各四张
-    for (int i = 0; i < 4; i++) {
-        drawPile.push_back(createCard(CardType::WILD, cardId++));
-        drawPile.push_back(createCard(CardType::WILD_DRAW_FOUR, cardId++));
-    }
+        // 创建标准功能卡 (Skip, Reverse, Draw Two)，每种颜色两张
+        for (auto color : {CardColor::RED, CardColor::YELLOW, CardColor::GREEN, CardColor::BLUE}) {
+            for (int i = 0; i < 2; i++) {
+                add(CardType::SKIP, color);
+                add(CardType::REVERSE, color);
+                add(CardType::DRAW_TWO, color);
+            }
+        }
     
-    // 创建自定义卡 (Package Card)，每种颜色两张
-    for (auto color : {CardColor::RED, CardColor::YELLOW, CardColor::GREEN, CardColor::BLUE}) {
-        for (int i = 0; i < 2; i++) {
-            drawPile.push_back(createCard(CardType::PACKAGE, cardId++, color));
+        // 创建万能卡 (Wild, Wild Draw Four)，各四张
+        for (int i = 0; i < 4; i++) {
+            add(CardType::WILD);
+            add(CardType::WILD_DRAW_FOUR);
         }
-    }
     
-    // 创建自定义卡 (Flash Card)，两张
-    for (int i = 0; i < 2; i++) {
-        drawPile.push_back(createCard(CardType::FLASH, cardId++));
-    }
-}
-
-std::shared_ptr<Card> Deck::createCard(CardType type, int id, CardColor color, int number) {
-    CardData data(id, color, type, number);
+        // 创建自定义卡 (Package Card)，每种颜色两张
+        for (auto color : {CardColor::RED, CardColor::YELLOW, CardColor::GREEN, CardColor::BLUE}) {
+            for (int i = 0; i < 2; i++) {
+                add(CardType::PACKAGE, color);
+            }
+        }
     
-    switch (type) {
-        case CardType::NUMBER:
-            data.name = std::to_string(number);
-            return std::make_shared<Card>(data);
-            
-        case CardType::SKIP:
-            data.name = "Skip";
-            return std::make_shared<SkipCard>(id, color);
-            
-        case CardType::REVERSE:
-            data.name = "Reverse";
-            return std::make_shared<ReverseCard>(id, color);
-            
-        case CardType::DRAW_TWO:
-            data.name = "Draw Two";
-            return std::make_shared<DrawTwoCard>(id, color);
-            
-        case CardType::WILD:
-            data.name = "Wild";
-            return std::make_shared<WildCard>(id);
-            
-        case CardType::WILD_DRAW_FOUR:
-            data.name = "Wild Draw Four";
-            return std::make_shared<WildDrawFourCard>(id);
-            
-        case CardType::PACKAGE:
-            data.name = "Package";
-            return std::make_shared<PackageCard>(id, color);
-            
-        case CardType::FLASH:
-            data.name = "Flash";
-            return std::make_shared<FlashCard>(id);
-            
-        default:
-            return std::make_shared<Card>(data);
-    }
+        // 创建自定义卡 (Flash Card)，两张
+        for (int i = 0; i < 2; i++) {
+            add(CardType::FLASH);
+        }
+        return codes;
+    }();
+    return standardDeck;
 }
 
 void Deck::shuffleDrawPile() {
-    std::shuffle(drawPile.begin(), drawPile.end(), randomGenerator);
+    // 整个抽牌堆都标记为未洗，抽牌时逐张洗，效果等同于立即洗一遍
+    piles.markUnshuffled();
 }
 
 std::shared_ptr<Card> Deck::drawCard() {
-    if (drawPile.empty()) {
-        reshuffleFromDiscard();
-    }
-    
-    if (drawPile.empty()) {
+    Common::CardCode code;
+    if (drawCodesInto({&code, 1}, 1) == 0) {
         return nullptr; // 牌堆完全空了
     }
-    
-    auto card = drawPile.back();
-    drawPile.pop_back();
-    return card;
+    return CardPrototypes::share(code);
 }
 
 std::vector<std::shared_ptr<Card>> Deck::drawCards(int count) {
-    std::vector<std::shared_ptr<Card>> cards;
-    for (int i = 0; i < count; i++) {
-        auto card = drawCard();
-        if (card) {
-            cards.push_back(card);
+    std::vector<std::shared_ptr<Card>> cards(std::max(count, 0));
+    cards.resize(drawInto(cards, cards.size()));
+    return cards;
+}
+
+size_t Deck::drawInto(std::span<std::shared_ptr<Card>> out, size_t count) {
+    count = std::min(count, out.size());
+    // 先按编码分批抽出，再创建卡牌对象，编码缓冲在栈上
+    Common::CardCode codes[16];
+    size_t drawn = 0;
+    while (drawn < count) {
+        size_t n = drawCodesInto(codes, std::min(count - drawn, std::size(codes)));
+        if (n == 0) {
+            break;
+        }
+        for (size_t i = 0; i < n; i++) {
+            out[drawn++] = CardPrototypes::share(codes[i]);
         }
     }
-    return cards;
+    return drawn;
+}
+
+size_t Deck::drawCodesInto(std::span<Common::CardCode> out, size_t count) {
+    count = std::min(count, out.size());
+    // 第一轮取抽牌堆里现有的牌，不够时补充一次再取第二轮
+    size_t drawn = piles.draw(out, count, randomGenerator);
+    if (drawn < count) {
+        piles.reshuffleFromDiscard();
+        drawn += piles.draw(out.subspan(drawn), count - drawn, randomGenerator);
+    }
+    return drawn;
 }
 
 void Deck::discardCard(std::shared_ptr<Card> card) {
-    discardPile.push_back(card);
+    piles.pushDiscard(card->getCardData().toCode());
 }
 
 std::vector<std::shared_ptr<Card>> Deck::dealInitialHand(int cardCount) {
@@ -139,64 +137,104 @@ std::vector<std::shared_ptr<Card>> Deck::dealInitialHand(int cardCount) {
 }
 
 std::shared_ptr<Card> Deck::getTopDiscardCard() const {
-    if (discardPile.empty()) {
+    if (piles.getDiscardSize() == 0) {
         return nullptr;
     }
-    return discardPile.back();
+    return CardPrototypes::share(piles.getTopDiscard());
 }
 
 void Deck::reshuffleFromDiscard() {
-    if (discardPile.size() <= 1) {
-        return; // 需要至少一张牌在弃牌堆中（顶牌）
-    }
-    
-    // 保留顶牌在弃牌堆中
-    auto topCard = discardPile.back();
-    discardPile.pop_back();
-    
-    // 将剩余的弃牌堆移到抽牌堆
-    drawPile = std::move(discardPile);
-    discardPile.clear();
-    discardPile.push_back(topCard);
-    
-    // 洗牌
-    shuffleDrawPile();
+    // 只在定长数组内移动，新加入的牌和底部原本没洗的牌在被抽到前逐张洗
+    piles.reshuffleFromDiscard();
 }
 
 nlohmann::json Deck::toJson() const {
+    // 每张牌导出为 CardData 的 JSON，抽牌堆底牌在前，弃牌堆顶牌在前
     nlohmann::json drawArray = nlohmann::json::array();
-    for (const auto& card : drawPile) {
-        drawArray.push_back(card->toJson());
+    for (auto code : piles.getDrawPile()) {
+        drawArray.push_back(CardFactory::create(code)->toJson());
     }
     
     nlohmann::json discardArray = nlohmann::json::array();
-    for (const auto& card : discardPile) {
-        discardArray.push_back(card->toJson());
+    for (auto code : piles.getDiscardPile()) {
+        discardArray.push_back(CardFactory::create(code)->toJson());
     }
     
     return {
+        {"deckNum", deckNum},
         {"drawPile", drawArray},
-        {"discardPile", discardArray}
+        {"discardPile", discardArray},
+        {"unshuffledCount", piles.getUnshuffledCount()}
     };
 }
 
 void Deck::fromJson(const nlohmann::json& data) {
-    drawPile.clear();
-    discardPile.clear();
+    deckNum = std::max(data.value("deckNum", 1), 1);
+    piles.reset(getShoeSize());
     
     if (data.contains("drawPile")) {
         for (const auto& cardData : data["drawPile"]) {
-            // 需要卡牌工厂来重建卡牌对象
-            // drawPile.push_back(CardFactory::createFromJson(cardData));
+            piles.pushDraw(CardFactory::createFromJson(cardData)->getCardData().toCode());
         }
     }
     
     if (data.contains("discardPile")) {
-        for (const auto& cardData : data["discardPile"]) {
-            // 需要卡牌工厂来重建卡牌对象
-            // discardPile.push_back(CardFactory::createFromJson(cardData));
+        // 保存时顶牌在前，倒序放回
+        const auto& discardArray = data["discardPile"];
+        for (auto it = discardArray.rbegin(); it != discardArray.rend(); ++it) {
+            piles.pushDiscard(CardFactory::createFromJson(*it)->getCardData().toCode());
+        }
+    }
+    
+    piles.setUnshuffledCount(data.value("unshuffledCount", piles.getDrawSize()));
+}
+
+void Deck::writeBinary(std::vector<uint8_t>& out) const {
+    BinaryWriter writer(out);
+    writer.write(BINARY_VERSION);
+    writer.write(static_cast<uint16_t>(piles.getCapacity()));
+    writer.write(static_cast<uint16_t>(piles.getDrawSize()));
+    writer.write(static_cast<uint16_t>(piles.getDiscardSize()));
+    writer.write(static_cast<uint16_t>(piles.getUnshuffledCount()));
+    // 编码本身就是一个字节，两个牌堆都可以整段写出
+    auto drawPile = piles.getDrawPile();
+    auto discardPile = piles.getDiscardPile();
+    writer.writeBytes({reinterpret_cast<const uint8_t*>(drawPile.data()), drawPile.size()});
+    writer.writeBytes({reinterpret_cast<const uint8_t*>(discardPile.data()), discardPile.size()});
+}
+
+bool Deck::readBinary(BinaryReader& reader) {
+    uint8_t version;
+    uint16_t capacity, drawSize, discardSize, unshuffledCount;
+    if (!reader.read(version) || version != BINARY_VERSION || !reader.read(capacity)
+        || !reader.read(drawSize) || !reader.read(discardSize) || !reader.read(unshuffledCount)
+        || drawSize + discardSize > capacity) {
+        return false;
+    }
+    std::span<const uint8_t> drawCodes, discardCodes;
+    if (!reader.readBytes(drawSize, drawCodes) || !reader.readBytes(discardSize, discardCodes)) {
+        return false;
+    }
+    
+    piles.reset(capacity);
+    deckNum = std::max<int>(capacity / STANDARD_DECK_SIZE, 1);
+    for (uint8_t byte : drawCodes) {
+        auto code = Common::CardCode::FromByte(byte);
+        if (!code.IsValid()) {
+            return false;
+        }
+        piles.pushDraw(code);
+    }
+    // 弃牌堆顶牌在前，倒序放回
+    for (auto it = discardCodes.rbegin(); it != discardCodes.rend(); ++it) {
+        auto code = Common::CardCode::FromByte(*it);
+        if (!code.IsValid()) {
+            return false;
         }
+        piles.pushDiscard(code);
     }
+    piles.setUnshuffledCount(unshuffledCount);
+    return true;
 }
 
 } // namespace UNO
@@ -2,9 +2,13 @@
 #include <vector>
 #include <memory>
 #include <random>
+#include <span>
 #include <nlohmann/json.hpp>
 #include "Card.h"
 #include "FunctionCard.h"
+#include "CardPiles.h"
+#include "CardPrototypes.h"
+#include "BinaryIO.h"
 
 namespace UNO {
 
@@ -14,7 +18,10 @@ namespace UNO {
  */
 class Deck {
 public:
-    Deck();
+    /**
+     * @param deckNum 牌靴中标准牌组的副数，人数多的牌桌用多副牌混在一起，减少重洗
+     */
+    explicit Deck(int deckNum = 1);
     
     // 初始化方法
     void initialize();
@@ -23,38 +30,95 @@ public:
     // 牌堆操作
     std::shared_ptr<Card> drawCard();
     std::vector<std::shared_ptr<Card>> drawCards(int count);
+    
+    /**
+     * 一次抽取 count 张牌写入 out，按抽牌顺序排列（out[0] 是原来的顶牌），不分配内存。
+     * 抽牌堆不够时最多从弃牌堆补充一次。
+     * @return 实际抽到的张数，抽牌堆和弃牌堆都不够时小于 count
+     */
+    size_t drawInto(std::span<std::shared_ptr<Card>> out, size_t count);
+    
+    /**
+     * 同 drawInto，但直接写出单字节编码，不创建卡牌对象
+     */
+    size_t drawCodesInto(std::span<Common::CardCode> out, size_t count);
     void discardCard(std::shared_ptr<Card> card);
     
+    /**
+     * 查看抽牌堆顶部最多 count 张牌（幸运星），不取出、不分配内存，也不从弃牌堆补充。
+     * 返回的视图在牌堆下一次变化前有效
+     * @return 顶部的牌的编码，顶牌在最后
+     */
+    std::span<const Common::CardCode> peek(size_t count) { return piles.peek(count, randomGenerator); }
+    
+    /**
+     * 取出从顶部数第 index 张牌（0 是顶牌），其余牌的顺序不变
+     * @throws std::out_of_range 抽牌堆没有这么多牌
+     */
+    std::shared_ptr<Card> extractAt(size_t index) { return CardPrototypes::share(piles.extractAt(index)); }
+    
     // 发牌
     std::vector<std::shared_ptr<Card>> dealInitialHand(int cardCount = 7);
     
     // 牌堆状态
-    size_t getDrawPileSize() const { return drawPile.size(); }
-    size_t getDiscardPileSize() const { return discardPile.size(); }
-    bool isDrawPileEmpty() const { return drawPile.empty(); }
+    size_t getDrawPileSize() const { return piles.getDrawSize(); }
+    size_t getDiscardPileSize() const { return piles.getDiscardSize(); }
+    bool isDrawPileEmpty() const { return piles.getDrawSize() == 0; }
     
     // 弃牌堆操作
     std::shared_ptr<Card> getTopDiscardCard() const;
-    const std::vector<std::shared_ptr<Card>>& getDiscardPile() const { return discardPile; }
+    // 弃牌堆中所有牌的编码，顶牌在前
+    std::span<const Common::CardCode> getDiscardPile() const { return piles.getDiscardPile(); }
     
     // 重洗牌堆
     void reshuffleFromDiscard();
     
-    // 序列化
+    // 序列化（JSON 只用于调试和导出，存档使用二进制格式）
     nlohmann::json toJson() const;
     void fromJson(const nlohmann::json& data);
     
+    /**
+     * 二进制存档：容量、两个牌堆的张数和洗牌进度，之后每张牌一个编码字节
+     */
+    void writeBinary(std::vector<uint8_t>& out) const;
+    
+    /**
+     * 从二进制存档恢复，容量不变时不分配内存
+     * @return 数据被截断或含有无效编码时返回 false，牌堆状态未定义
+     */
+    bool readBinary(BinaryReader& reader);
+    
     // 统计信息
     int getTotalCards() const { return getDrawPileSize() + getDiscardPileSize(); }
+    int getDeckNum() const { return deckNum; }
+    
+    /**
+     * 设置洗牌的种子，同一种子和同样的操作顺序在任何平台上得到同样的牌序（用于模拟和复现）
+     */
+    void seed(uint64_t seed) { randomGenerator.Seed(seed); }
+    // 整个牌靴的张数，也是两个牌堆共用数组的容量
+    size_t getShoeSize() const { return STANDARD_DECK_SIZE * deckNum; }
+
+    // 标准牌组的张数：数字卡 76、功能卡 24、万能卡 8、Package 8、Flash 2
+    constexpr static size_t STANDARD_DECK_SIZE = 118;
+    
+    /**
+     * 一副标准牌组中每张牌的编码，AI 用它推算还没见过的牌
+     */
+    static std::span<const Common::CardCode> getStandardDeck();
+    // 二进制存档格式的版本，格式变化时加一
+    constexpr static uint8_t BINARY_VERSION = 1;
 
 private:
-    std::vector<std::shared_ptr<Card>> drawPile;
-    std::vector<std::shared_ptr<Card>> discardPile;
-    std::mt19937 randomGenerator;
+    // 两个牌堆只存编码，抽出的牌是共用的卡牌原型，不创建新对象。
+    // 洗牌按 Fisher-Yates 从顶部往下逐张进行，只在牌被抽到之前才洗
+    CardPiles piles;
+    Common::ShuffleRng randomGenerator;
+    int deckNum;
     
     void createStandardDeck();
     void shuffleDrawPile();
-    std::shared_ptr<Card> createCard(CardType type, int id, CardColor color = CardColor::WILD, int number = -1);
+
 };
 
 } // namespace UNO
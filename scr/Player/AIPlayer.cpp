@@ -14,14 +14,19 @@ std::shared_ptr<Card> AIPlayer::playTurn(GameState& gameState) {
 }
 
 bool AIPlayer::decideUseSkill(GameState& gameState) {
-    // 简单策略：暂时不使用技能
-    // 后续可以扩展为根据情况使用技能
-    return false;
+    // 按角色估值，比不发动好才发动
+    HeadlessCharacter skill = SkillPolicy::toHeadlessCharacter(character);
+    skillChoice = SkillChoice();
+    return SkillPolicy::choose(skill, SkillPolicy::observe(gameState, id, skill, handCards), skillChoice);
 }
 
 nlohmann::json AIPlayer::getSkillParameters(GameState& gameState) {
-    // 不使用技能，返回空参数
-    return nlohmann::json::object();
+    HeadlessCharacter skill = SkillPolicy::toHeadlessCharacter(character);
+    if (skill == HeadlessCharacter::LUCKY_STAR) {
+        // 决定发动之后才看抽牌堆
+        skillChoice.cardIndex = SkillPolicy::chooseKeptCard(gameState, id, handCards);
+    }
+    return SkillPolicy::toParameters(skill, skillChoice);
 }
 
 CardColor AIPlayer::chooseWildColor(GameState& gameState) {
@@ -29,96 +34,50 @@ CardColor AIPlayer::chooseWildColor(GameState& gameState) {
 }
 
 std::shared_ptr<Card> AIPlayer::selectCardToPlay(const GameState& gameState) {
-    // 获取所有可出的牌
-    auto playableCards = getPlayableCards(gameState);
+    // 一次遍历把能出的牌分类
+    auto topCard = gameState.getTopCard();
+    moves.classify(handCards, topCard.get());
     
-    if (playableCards.empty()) {
+    if (moves.playableCount() == 0) {
         return nullptr; // 没有可出的牌，需要抽牌
     }
     
     // 策略：优先出数字牌
-    auto numberCards = getPlayableNumberCards(gameState);
+    auto numberCards = moves.playable(MoveClassifier::Category::NUMBER);
     if (!numberCards.empty()) {
         // 有数字牌，随机选择一张数字牌
-        std::uniform_int_distribution<int> dist(0, numberCards.size() - 1);
-        return numberCards[dist(randomGenerator)];
-    }
-    
-    // 没有数字牌，出功能牌
-    auto functionCards = getPlayableFunctionCards(gameState);
-    if (!functionCards.empty()) {
-        // 随机选择一张功能牌
-        std::uniform_int_distribution<int> dist(0, functionCards.size() - 1);
-        return functionCards[dist(randomGenerator)];
+        std::uniform_int_distribution<size_t> dist(0, numberCards.size() - 1);
+        return handCards[numberCards[dist(randomGenerator)]];
     }
     
-    // 理论上不会执行到这里，因为playableCards不为空
-    return nullptr;
+    // 没有数字牌，在有颜色的功能牌和万能牌中随机选择一张
+    auto actionCards = moves.playable(MoveClassifier::Category::ACTION);
+    auto wildCards = moves.playable(MoveClassifier::Category::WILD);
+    std::uniform_int_distribution<size_t> dist(0, actionCards.size() + wildCards.size() - 1);
+    size_t choice = dist(randomGenerator);
+    return handCards[choice < actionCards.size() ? actionCards[choice] : wildCards[choice - actionCards.size()]];
 }
 
 CardColor AIPlayer::selectColorForWildCard(const GameState& gameState) {
     return getMostFrequentColorInHand();
 }
 
-bool AIPlayer::isNumberCard(const std::shared_ptr<Card>& card) const {
-    return card->getType() == CardType::NUMBER;
-}
-
-std::vector<std::shared_ptr<Card>> AIPlayer::getPlayableNumberCards(const GameState& gameState) const {
-    std::vector<std::shared_ptr<Card>> numberCards;
-    auto playableCards = getPlayableCards(gameState);
-    
-    for (const auto& card : playableCards) {
-        if (isNumberCard(card)) {
-            numberCards.push_back(card);
-        }
-    }
-    
-    return numberCards;
-}
-
-std::vector<std::shared_ptr<Card>> AIPlayer::getPlayableFunctionCards(const GameState& gameState) const {
-    std::vector<std::shared_ptr<Card>> functionCards;
-    auto playableCards = getPlayableCards(gameState);
-    
-    for (const auto& card : playableCards) {
-        if (!isNumberCard(card)) {
-            functionCards.push_back(card);
+CardColor AIPlayer::getMostFrequentColorInHand() {
+    // 各颜色的张数直接取自手牌索引（排除万能色）
+    CardColor mostFrequent = CardColor::RED;
+    size_t maxCount = 0;
+    for (auto color : {CardColor::RED, CardColor::YELLOW, CardColor::GREEN, CardColor::BLUE}) {
+        size_t count = countCards(color);
+        if (count > maxCount) {
+            mostFrequent = color;
+            maxCount = count;
         }
     }
     
-    return functionCards;
-}
-
-CardColor AIPlayer::getMostFrequentColorInHand() const {
-    // 统计手牌中各种颜色的数量（排除万能色）
-    std::unordered_map<CardColor, int> colorCount;
-    
-    for (const auto& card : handCards) {
-        CardColor color = card->getColor();
-        if (color != CardColor::WILD) {
-            colorCount[color]++;
-        }
-    }
-    
-    if (colorCount.empty()) {
+    if (maxCount == 0) {
         // 如果手牌中只有万能牌，随机选择一个非万能色
-        std::vector<CardColor> colors = {
-            CardColor::RED, CardColor::YELLOW, CardColor::GREEN, CardColor::BLUE
-        };
-        std::uniform_int_distribution<int> dist(0, colors.size() - 1);
-        return colors[dist(randomGenerator)];
-    }
-    
-    // 找到数量最多的颜色
-    CardColor mostFrequent = colorCount.begin()->first;
-    int maxCount = colorCount.begin()->second;
-    
-    for (const auto& pair : colorCount) {
-        if (pair.second > maxCount) {
-            mostFrequent = pair.first;
-            maxCount = pair.second;
-        }
+        std::uniform_int_distribution<int> dist(0, 3);
+        return static_cast<CardColor>(dist(randomGenerator));
     }
     
     return mostFrequent;
@@ -1,5 +1,7 @@
 #pragma once
 #include "Player.h"
+#include "MoveClassifier.h"
+#include "SkillPolicy.h"
 #include <algorithm>
 #include <random>
 
@@ -7,7 +9,7 @@ namespace UNO {
 
 /**
  * AI玩家类
- * 实现简单的AI策略：优先出数字牌，有牌就出，没牌就抽牌
+ * 实现简单的AI策略：优先出数字牌，有牌就出，没牌就抽牌；技能按 SkillPolicy 的估值发动
  */
 class AIPlayer : public Player {
 public:
@@ -21,16 +23,15 @@ public:
 
 private:
     std::mt19937 randomGenerator;
+    MoveClassifier moves;  // 每次出牌前重新分类，容量复用
+    SkillChoice skillChoice;  // decideUseSkill 选好的用法，getSkillParameters 返回它的参数
     
     // AI策略方法
     std::shared_ptr<Card> selectCardToPlay(const GameState& gameState);
     CardColor selectColorForWildCard(const GameState& gameState);
     
     // 辅助方法
-    bool isNumberCard(const std::shared_ptr<Card>& card) const;
-    std::vector<std::shared_ptr<Card>> getPlayableNumberCards(const GameState& gameState) const;
-    std::vector<std::shared_ptr<Card>> getPlayableFunctionCards(const GameState& gameState) const;
-    CardColor getMostFrequentColorInHand() const;
+    CardColor getMostFrequentColorInHand();
 };
 
 } // namespace UNO
@@ -0,0 +1,66 @@
+#include "HandIndex.h"
+
+namespace UNO {
+
+void HandIndex::clear() {
+    for (auto& bucket : buckets) {
+        bucket.clear();
+    }
+    slots.clear();
+}
+
+void HandIndex::add(CardColor color, CardType type) {
+    int key = keyOf(color, type);
+    auto& bucket = buckets[key];
+    slots.push_back({static_cast<uint8_t>(key), static_cast<uint16_t>(bucket.size())});
+    bucket.push_back(static_cast<uint16_t>(slots.size() - 1));
+}
+
+void HandIndex::remove(size_t position) {
+    // 先从桶中删除：桶的最后一个元素移到空位
+    Slot removed = slots[position];
+    auto& bucket = buckets[removed.key];
+    uint16_t movedInBucket = bucket.back();
+    bucket[removed.offset] = movedInBucket;
+    slots[movedInBucket].offset = removed.offset;
+    bucket.pop_back();
+
+    // 再从手牌中删除：后面的牌前移一位，它们在桶中记录的下标各减一
+    slots.erase(slots.begin() + position);
+    for (size_t i = position; i < slots.size(); i++) {
+        buckets[slots[i].key][slots[i].offset]--;
+    }
+}
+
+std::span<const uint16_t> HandIndex::positions(CardColor color, CardType type) const {
+    return buckets[keyOf(color, type)];
+}
+
+size_t HandIndex::count(CardType type) const {
+    size_t total = 0;
+    for (int color = 0; color < COLOR_NUM; color++) {
+        total += buckets[color * TYPE_NUM + static_cast<int>(type)].size();
+    }
+    return total;
+}
+
+size_t HandIndex::count(CardColor color) const {
+    size_t total = 0;
+    for (int type = 0; type < TYPE_NUM; type++) {
+        total += buckets[static_cast<int>(color) * TYPE_NUM + type].size();
+    }
+    return total;
+}
+
+size_t HandIndex::nthOfType(CardType type, size_t n) const {
+    for (int color = 0; color < COLOR_NUM; color++) {
+        const auto& bucket = buckets[color * TYPE_NUM + static_cast<int>(type)];
+        if (n < bucket.size()) {
+            return bucket[n];
+        }
+        n -= bucket.size();
+    }
+    return slots.size();
+}
+
+} // namespace UNO
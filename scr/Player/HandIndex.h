@@ -0,0 +1,66 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "Card.h"
+
+namespace UNO {
+
+/**
+ * 手牌按（颜色，类型）分桶的索引，每个桶记录该类牌在手牌中的下标，每张牌记录
+ * 自己所在的桶和在桶中的位置。按类型或颜色查询只访问相关的桶，不遍历整手牌。
+ *
+ * 删除保持其余牌的顺序，和 Player 的手牌（界面按这个顺序显示）同步：后面的牌
+ * 下标减一，只改动它们在桶中的那一个元素，不用重建索引。
+ */
+class HandIndex {
+public:
+    static constexpr int COLOR_NUM = 5;  // 四种颜色加万能色
+    static constexpr int TYPE_NUM = 8;
+
+    void clear();
+
+    size_t size() const { return slots.size(); }
+
+    /**
+     * 记录追加到手牌末尾的一张牌
+     */
+    void add(CardColor color, CardType type);
+
+    /**
+     * 删除下标为 position 的牌，后面的牌依次前移一位
+     */
+    void remove(size_t position);
+
+    /**
+     * 指定颜色和类型的牌在手牌中的下标，顺序不固定，手牌改变后失效
+     */
+    std::span<const uint16_t> positions(CardColor color, CardType type) const;
+
+    size_t count(CardColor color, CardType type) const { return positions(color, type).size(); }
+    size_t count(CardType type) const;
+    size_t count(CardColor color) const;
+
+    /**
+     * 指定类型的第 n 张牌（按颜色顺序计数）在手牌中的下标，n 必须小于 count(type)
+     */
+    size_t nthOfType(CardType type, size_t n) const;
+
+private:
+    static int keyOf(CardColor color, CardType type) {
+        return static_cast<int>(color) * TYPE_NUM + static_cast<int>(type);
+    }
+
+private:
+    struct Slot {
+        uint8_t key;      // 所在的桶
+        uint16_t offset;  // 在桶中的位置
+    };
+
+    std::array<std::vector<uint16_t>, COLOR_NUM * TYPE_NUM> buckets;
+    std::vector<Slot> slots;  // 与手牌一一对应
+};
+
+} // namespace UNO
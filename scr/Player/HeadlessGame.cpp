@@ -0,0 +1,328 @@
+#include "HeadlessGame.h"
+#include <algorithm>
+#include <array>
+
+namespace UNO {
+
+using Common::CardCode;
+using Common::CodeColor;
+using Common::CodeFace;
+
+namespace {
+constexpr std::array<CodeColor, 4> CHOSEN_COLORS = {
+    CodeColor::RED, CodeColor::YELLOW, CodeColor::GREEN, CodeColor::BLUE
+};
+}
+
+HeadlessGame::HeadlessGame(int playerNum)
+    : hands(playerNum), characters(playerNum, HeadlessCharacter::NONE), skillUsesLeft(playerNum, 0) {}
+
+void HeadlessGame::setCharacter(int player, HeadlessCharacter character) {
+    characters[player] = character;
+    // 和 Game::Character 的次数一致
+    skillUsesLeft[player] = character == HeadlessCharacter::LUCKY_STAR ? 3 : (character == HeadlessCharacter::NONE ? 0 : 1);
+}
+
+bool HeadlessGame::canPlay(CardCode card) const {
+    if (pendingDraw > 0) {
+        // 叠加罚抽：+4 可以接任何罚抽，+2 只能接 +2
+        return card.GetFace() == CodeFace::DRAW_FOUR
+            || (card.GetFace() == CodeFace::DRAW_TWO && topCard.GetFace() == CodeFace::DRAW_TWO);
+    }
+    return matches(card, topCard, currentColor);
+}
+
+bool HeadlessGame::matches(CardCode card, CardCode topCard, CodeColor currentColor) {
+    // 和 CardData::matches 一致：万能牌、同色、同数字或同种功能牌
+    if (card.IsWild() || currentColor == CodeColor::WILD || card.GetColor() == currentColor) {
+        return true;
+    }
+    if (topCard.IsWild() || !topCard.IsValid()) {
+        return false;
+    }
+    bool cardIsNumber = card.GetNumber() >= 0;
+    bool topIsNumber = topCard.GetNumber() >= 0;
+    return cardIsNumber == topIsNumber && card.GetFace() == topCard.GetFace();
+}
+
+void HeadlessGame::getLegalMoves(std::vector<HeadlessMove>& out) const {
+    out.clear();
+    // 相同编码的牌效果相同，只展开一次
+    std::array<bool, 256> seen{};
+    for (auto card : hands[currentPlayer]) {
+        if (seen[card.ToByte()] || !canPlay(card)) {
+            continue;
+        }
+        seen[card.ToByte()] = true;
+        if (card.IsWild() || card.GetFace() == CodeFace::PACKAGE) {
+            for (auto color : CHOSEN_COLORS) {
+                out.push_back({card, color});
+            }
+        }
+        else {
+            out.push_back({card, card.GetColor()});
+        }
+    }
+    if (out.empty()) {
+        out.push_back({});
+    }
+}
+
+void HeadlessGame::apply(HeadlessMove move, Common::ShuffleRng& rng) {
+    int player = currentPlayer;
+    turnCount++;
+    if (move.isDraw()) {
+        auto& hand = hands[player];
+        bool isPenalty = pendingDraw > 0;
+        int count = isPenalty ? pendingDraw : 1;
+        pendingDraw = 0;
+        // 普通抽牌抽到的牌能出就立即出
+        if (takeDraw(player, count, isPenalty, rng) && canPlay(hand.back())) {
+            CardCode drawn = hand.back();
+            bool choosesColor = drawn.IsWild() || drawn.GetFace() == CodeFace::PACKAGE;
+            play(player, drawn, choosesColor ? mostFrequentColor(hand) : drawn.GetColor(), rng);
+            return;
+        }
+        endTurn(1);
+        return;
+    }
+    play(player, move.card, move.color, rng);
+}
+
+void HeadlessGame::play(int player, CardCode card, CodeColor color, Common::ShuffleRng& rng) {
+    auto& hand = hands[player];
+    auto it = std::find(hand.begin(), hand.end(), card);
+    if (it == hand.end()) {
+        return;
+    }
+    *it = hand.back();
+    hand.pop_back();
+
+    if (topCard.IsValid()) {
+        discardPile.push_back(topCard);
+    }
+    topCard = card;
+    currentColor = card.IsWild() ? color : card.GetColor();
+
+    int steps = 1;
+    switch (card.GetFace()) {
+        case CodeFace::SKIP:
+            steps = 2;
+            break;
+        case CodeFace::REVERSE:
+            clockwise = !clockwise;
+            // 两人时反转相当于跳过
+            steps = getPlayerNum() == 2 ? 2 : 1;
+            break;
+        case CodeFace::DRAW_TWO:
+        case CodeFace::DRAW_FOUR: {
+            int count = card.GetFace() == CodeFace::DRAW_TWO ? 2 : 4;
+            if (drawStacking) {
+                // 罚抽累积到下家，由下家叠加或抽完
+                pendingDraw += count;
+                break;
+            }
+            // 下家抽牌并跳过回合
+            takeDraw(nextPlayer(1), count, true, rng);
+            steps = 2;
+            break;
+        }
+        case CodeFace::PACKAGE:
+            // 丢弃出牌者手中指定颜色的数字牌
+            hand.erase(std::remove_if(hand.begin(), hand.end(), [color](CardCode code) {
+                return code.GetColor() == color && code.GetNumber() >= 0;
+            }), hand.end());
+            counters.customCardsPlayed++;
+            break;
+        case CodeFace::FLASH:
+            counters.customCardsPlayed++;
+            break;
+        default:
+            break;
+    }
+
+    if (hand.empty()) {
+        winner = player;
+        return;
+    }
+    endTurn(steps);
+}
+
+bool HeadlessGame::takeDraw(int player, int count, bool isPenalty, Common::ShuffleRng& rng) {
+    if (isPenalty) {
+        counters.drawStacks[std::min(count, MAX_DRAW_STACK)]++;
+    }
+    auto& hand = hands[player];
+    bool canUseLuckyStar = characters[player] == HeadlessCharacter::LUCKY_STAR && skillUsesLeft[player] > 0
+        && (player != currentPlayer || !skillUsedThisTurn);
+    if (canUseLuckyStar) {
+        if (drawPile.empty()) {
+            refillDrawPile(rng);
+        }
+        // 和 GameBoard::HandleDraw 一致：从顶部三张中挑一张代替这次抽牌，优先挑能出的牌
+        int viewNum = std::min<int>(3, drawPile.size());
+        if (viewNum > 0) {
+            int chosen = 0;
+            while (chosen < viewNum - 1 && !canPlay(drawPile[drawPile.size() - 1 - chosen])) {
+                chosen++;
+            }
+            auto position = drawPile.end() - 1 - chosen;
+            hand.push_back(*position);
+            drawPile.erase(position);
+            skillUsesLeft[player]--;
+            if (player == currentPlayer) {
+                skillUsedThisTurn = true;
+            }
+            counters.skillUses[static_cast<int>(HeadlessCharacter::LUCKY_STAR)]++;
+            return !isPenalty;
+        }
+    }
+    size_t before = hand.size();
+    drawCards(player, count, rng);
+    return !isPenalty && hand.size() == before + 1;
+}
+
+bool HeadlessGame::canUseSkill() const {
+    HeadlessCharacter character = characters[currentPlayer];
+    return (character == HeadlessCharacter::COLLECTOR || character == HeadlessCharacter::THIEF)
+        && skillUsesLeft[currentPlayer] > 0 && !skillUsedThisTurn;
+}
+
+bool HeadlessGame::useSkill(const HeadlessSkill& skill, Common::ShuffleRng& rng) {
+    if (!canUseSkill()) {
+        return false;
+    }
+    int player = currentPlayer;
+    auto& hand = hands[player];
+    skillUsedThisTurn = true;
+
+    if (characters[player] == HeadlessCharacter::COLLECTOR) {
+        // 拿走顶牌下面的一张
+        if (discardPile.empty()) {
+            return false;
+        }
+        hand.push_back(discardPile.back());
+        discardPile.pop_back();
+        skillUsesLeft[player]--;
+        counters.skillUses[static_cast<int>(HeadlessCharacter::COLLECTOR)]++;
+        return true;
+    }
+
+    int target = skill.target;
+    if (target < 0 || target >= getPlayerNum() || target == player) {
+        return false;
+    }
+    if (characters[target] == HeadlessCharacter::DEFENDER && skillUsesLeft[target] > 0) {
+        // 被挡住时小偷的次数不消耗，和 GameBoard::ProcessThiefSkill 一致
+        skillUsesLeft[target]--;
+        counters.skillUses[static_cast<int>(HeadlessCharacter::DEFENDER)]++;
+        return false;
+    }
+    skillUsesLeft[player]--;
+    counters.skillUses[static_cast<int>(HeadlessCharacter::THIEF)]++;
+
+    // 随机偷一张指定类型的牌，再随机还给对方一张自己的牌
+    auto& targetHand = hands[target];
+    int candidateNum = 0;
+    size_t stolenPosition = 0;
+    for (size_t position = 0; position < targetHand.size(); position++) {
+        bool isNumber = targetHand[position].GetNumber() >= 0;
+        if (isNumber == skill.stealNumber && rng.Bounded(++candidateNum) == 0) {
+            stolenPosition = position;
+        }
+    }
+    if (candidateNum == 0) {
+        return false;
+    }
+    CardCode stolen = targetHand[stolenPosition];
+    targetHand[stolenPosition] = targetHand.back();
+    targetHand.pop_back();
+    if (!hand.empty()) {
+        size_t returned = rng.Bounded(static_cast<uint32_t>(hand.size()));
+        targetHand.push_back(hand[returned]);
+        hand[returned] = hand.back();
+        hand.pop_back();
+    }
+    hand.push_back(stolen);
+    return true;
+}
+
+void HeadlessGame::drawCards(int player, int count, Common::ShuffleRng& rng) {
+    auto& hand = hands[player];
+    for (int i = 0; i < count; i++) {
+        if (drawPile.empty() && !refillDrawPile(rng)) {
+            return;
+        }
+        hand.push_back(drawPile.back());
+        drawPile.pop_back();
+    }
+}
+
+bool HeadlessGame::refillDrawPile(Common::ShuffleRng& rng) {
+    if (discardPile.empty()) {
+        return false;
+    }
+    // 弃牌洗回抽牌堆，万能牌恢复成未选颜色
+    for (auto& card : discardPile) {
+        if (card.IsWild()) {
+            card = card.WithColor(CodeColor::WILD);
+        }
+    }
+    drawPile.swap(discardPile);
+    Common::Shuffle(std::span(drawPile), rng);
+    return true;
+}
+
+int HeadlessGame::nextPlayer(int steps) const {
+    int playerNum = getPlayerNum();
+    int offset = (clockwise ? steps : -steps) % playerNum;
+    return (currentPlayer + offset + playerNum) % playerNum;
+}
+
+void HeadlessGame::endTurn(int steps) {
+    currentPlayer = nextPlayer(steps);
+    skillUsedThisTurn = false;
+}
+
+int HeadlessGame::playout(Common::ShuffleRng& rng, int maxTurns) {
+    for (int turn = 0; turn < maxTurns && !isOver(); turn++) {
+        auto& hand = hands[currentPlayer];
+        // 在能出的牌中均匀地随机选一张（蓄水池抽样，不分配内存）
+        int candidateNum = 0;
+        CardCode chosen;
+        for (auto card : hand) {
+            if (canPlay(card) && rng.Bounded(++candidateNum) == 0) {
+                chosen = card;
+            }
+        }
+        HeadlessMove move{chosen, chosen.GetColor()};
+        if (chosen.IsWild() || chosen.GetFace() == CodeFace::PACKAGE) {
+            move.color = mostFrequentColor(hand);
+        }
+        apply(move, rng);
+    }
+    if (isOver()) {
+        return winner;
+    }
+    // 回合数用完时手牌最少的玩家获胜
+    int best = 0;
+    for (int player = 1; player < getPlayerNum(); player++) {
+        if (hands[player].size() < hands[best].size()) {
+            best = player;
+        }
+    }
+    return best;
+}
+
+CodeColor HeadlessGame::mostFrequentColor(std::span<const CardCode> hand, CodeColor fallback) {
+    std::array<int, 4> counts{};
+    for (auto card : hand) {
+        if (card.GetColor() != CodeColor::WILD) {
+            counts[static_cast<int>(card.GetColor())]++;
+        }
+    }
+    auto best = std::max_element(counts.begin(), counts.end());
+    return *best > 0 ? CHOSEN_COLORS[best - counts.begin()] : fallback;
+}
+
+} // namespace UNO
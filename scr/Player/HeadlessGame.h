@@ -0,0 +1,176 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "common/card_code.h"
+#include "common/shuffle.h"
+
+namespace UNO {
+
+/**
+ * 一步行动：出一张牌或抽牌。万能牌的 color 是选择的颜色，Package 的 color 是要丢弃的
+ * 数字牌颜色，其余的牌 color 就是牌的颜色。card 无效时表示抽牌。
+ */
+struct HeadlessMove {
+    Common::CardCode card;
+    Common::CodeColor color = Common::CodeColor::WILD;
+
+    bool isDraw() const { return !card.IsValid(); }
+    bool operator==(const HeadlessMove& other) const = default;
+};
+
+/**
+ * 模拟中的角色，顺序和 Game::CharacterType 一致，统计时可以直接换算
+ */
+enum class HeadlessCharacter : uint8_t {
+    LUCKY_STAR,
+    COLLECTOR,
+    THIEF,
+    DEFENDER,
+    NONE
+};
+
+/**
+ * 主动技能的参数：小偷的目标和要偷的牌类型，收藏家不需要参数
+ */
+struct HeadlessSkill {
+    int target = -1;
+    bool stealNumber = false;  // true 偷数字牌，false 偷功能牌
+};
+
+/**
+ * 不依赖网络和卡牌对象的精简牌局，牌都是单字节编码，用于 AI 的模拟和批量自对弈。
+ * 规则和 CardEffects 一致：跳过、反转、+2、+4 立即生效，Package 丢弃出牌者手中指定颜色的
+ * 数字牌。Flash 的多人响应在模拟中按改变颜色的万能牌处理；抽牌后抽到的牌能出就立即出。
+ *
+ * 打开叠加规则后 +2、+4 和服务器一样累积，下家可以继续叠加或一次抽完。设置角色后技能
+ * 按 GameBoard 的方式生效：幸运星抽牌时改为从顶部三张中挑一张，收藏家拿走顶牌下面的
+ * 一张，小偷偷一张指定类型的牌并还一张，防御者挡住一次偷窃。
+ */
+class HeadlessGame {
+public:
+    constexpr static int MAX_DRAW_STACK = 32;  // 统计时更大的叠加都记在这一档
+
+    /**
+     * 一局中的计数，由自对弈汇总成平衡性统计
+     */
+    struct Counters {
+        std::array<uint32_t, 4> skillUses{};  // 按角色，防御者是成功挡住的次数
+        std::array<uint32_t, MAX_DRAW_STACK + 1> drawStacks{};  // 每次罚抽的张数
+        uint32_t customCardsPlayed = 0;  // 打出的 Package 和 Flash
+    };
+
+    explicit HeadlessGame(int playerNum);
+
+    int getPlayerNum() const { return static_cast<int>(hands.size()); }
+    std::vector<Common::CardCode>& getHand(int player) { return hands[player]; }
+    const std::vector<Common::CardCode>& getHand(int player) const { return hands[player]; }
+    // 抽牌堆，末尾是顶牌
+    std::vector<Common::CardCode>& getDrawPile() { return drawPile; }
+
+    Common::CardCode getTopCard() const { return topCard; }
+    Common::CodeColor getCurrentColor() const { return currentColor; }
+    int getCurrentPlayer() const { return currentPlayer; }
+    bool isClockwise() const { return clockwise; }
+    int getTurnCount() const { return turnCount; }
+    // 叠加规则下当前玩家要罚抽的张数，没有罚抽时为 0
+    int getPendingDraw() const { return pendingDraw; }
+    const Counters& getCounters() const { return counters; }
+
+    /**
+     * 设置顶牌和当前颜色（万能牌是选择的颜色）
+     */
+    void setTop(Common::CardCode card, Common::CodeColor color) { topCard = card; currentColor = color; }
+    void setCurrentPlayer(int player) { currentPlayer = player; }
+    void setClockwise(bool isClockwise) { clockwise = isClockwise; }
+    void setDrawStacking(bool enabled) { drawStacking = enabled; }
+
+    /**
+     * 设置角色并重置技能次数：幸运星整局三次，其余角色一次
+     */
+    void setCharacter(int player, HeadlessCharacter character);
+    HeadlessCharacter getCharacter(int player) const { return characters[player]; }
+
+    bool isOver() const { return winner >= 0; }
+    int getWinner() const { return winner; }
+
+    bool canPlay(Common::CardCode card) const;
+
+    /**
+     * 不考虑叠加罚抽时 card 能否接在 topCard 上：万能牌、同色、同数字或同种功能牌
+     */
+    static bool matches(Common::CardCode card, Common::CardCode topCard, Common::CodeColor currentColor);
+
+    /**
+     * 当前玩家所有合法的行动，需要选颜色的牌按四种颜色展开；没有能出的牌时只有抽牌
+     */
+    void getLegalMoves(std::vector<HeadlessMove>& out) const;
+
+    /**
+     * 执行当前玩家的一步行动并轮到下一个玩家
+     * @param rng 抽牌堆空了时用来把弃牌洗回抽牌堆
+     */
+    void apply(HeadlessMove move, Common::ShuffleRng& rng);
+
+    /**
+     * 当前玩家本回合能否发动主动技能（收藏家、小偷），幸运星在抽牌时自动发动
+     */
+    bool canUseSkill() const;
+
+    /**
+     * 当前玩家发动主动技能，每回合最多一次
+     * @return 技能是否生效（被防御者挡住或没有可拿的牌时为 false）
+     */
+    bool useSkill(const HeadlessSkill& skill, Common::ShuffleRng& rng);
+
+    /**
+     * 用轻量的随机策略把牌局下完
+     * @param maxTurns 最多再进行的回合数，超过后手牌最少的玩家获胜
+     * @return 获胜的玩家
+     */
+    int playout(Common::ShuffleRng& rng, int maxTurns);
+
+    /**
+     * 手牌中最多的颜色（不算万能牌），用于替万能牌选颜色
+     * @param fallback 手牌中没有带颜色的牌时返回的颜色
+     */
+    static Common::CodeColor mostFrequentColor(std::span<const Common::CardCode> hand,
+                                               Common::CodeColor fallback = Common::CodeColor::RED);
+
+private:
+    void play(int player, Common::CardCode card, Common::CodeColor color, Common::ShuffleRng& rng);
+    /**
+     * 玩家抽 count 张牌，幸运星可用时改为从顶部三张中挑一张
+     * @return 抽到的牌是否只有一张且是普通抽牌（可以立即打出）
+     */
+    bool takeDraw(int player, int count, bool isPenalty, Common::ShuffleRng& rng);
+    void drawCards(int player, int count, Common::ShuffleRng& rng);
+    /**
+     * 抽牌堆空了时把弃牌洗回去
+     * @return 没有弃牌可洗时返回 false
+     */
+    bool refillDrawPile(Common::ShuffleRng& rng);
+    int nextPlayer(int steps) const;
+    void endTurn(int steps);
+
+private:
+    std::vector<std::vector<Common::CardCode>> hands;
+    std::vector<Common::CardCode> drawPile;
+    std::vector<Common::CardCode> discardPile;  // 顶牌以下的牌，抽牌堆空了时洗回去
+    Common::CardCode topCard;
+    Common::CodeColor currentColor = Common::CodeColor::RED;
+    int currentPlayer = 0;
+    bool clockwise = true;
+    int winner = -1;
+    int turnCount = 0;
+
+    bool drawStacking = false;
+    int pendingDraw = 0;
+    std::vector<HeadlessCharacter> characters;
+    std::vector<uint8_t> skillUsesLeft;
+    bool skillUsedThisTurn = false;
+    Counters counters;
+};
+
+} // namespace UNO
@@ -0,0 +1,392 @@
+#include "ISMCTSPlayer.h"
+#include "GameState.h"
+#include "Deck.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <thread>
+
+namespace UNO {
+
+using Common::CardCode;
+using Common::CodeColor;
+
+namespace {
+
+// 树节点，子节点用下标引用同一个数组中的节点
+struct Node {
+    HeadlessMove move;
+    int player = -1;          // 走这一步的玩家
+    std::vector<int> children;
+    double wins = 0;
+    int visits = 0;
+    int availability = 0;     // 这一步在父节点可走的次数（不同确定化下可走的步不同）
+};
+
+// 一个线程的搜索结果：根节点每个子节点的行动和访问次数
+struct RootStats {
+    std::vector<std::pair<HeadlessMove, int>> visits;
+    int iterations = 0;
+};
+
+// 相同的编码在不同副牌中可以互相替换，所以只按编码计数
+CardCode normalized(CardCode code) {
+    return OpponentBelief::normalized(code);
+}
+
+/**
+ * 把看不到的牌随机发给对手，剩下的作为抽牌堆
+ */
+void determinize(HeadlessGame& game, std::vector<CardCode>& pool, const std::vector<int>& handSizes,
+                 int self, Common::ShuffleRng& rng) {
+    Common::Shuffle(std::span(pool), rng);
+    auto next = pool.begin();
+    for (int player = 0; player < game.getPlayerNum(); player++) {
+        if (player == self) {
+            continue;
+        }
+        int size = std::min<int>(handSizes[player], pool.end() - next);
+        game.getHand(player).assign(next, next + size);
+        next += size;
+    }
+    game.getDrawPile().assign(next, pool.end());
+}
+
+// 一个线程比较技能用法的结果，第 0 项是不发动
+struct RolloutStats {
+    std::vector<int> wins;
+    std::vector<int> plays;
+};
+
+void deal(HeadlessGame& game, std::vector<CardCode>& pool, const std::vector<int>& handSizes,
+          const OpponentBelief* tracked, int self, Common::ShuffleRng& rng) {
+    if (tracked) {
+        tracked->deal(game, pool, rng);
+    }
+    else {
+        determinize(game, pool, handSizes, self, rng);
+    }
+}
+
+void runSkillRollouts(const HeadlessGame& root, std::vector<CardCode> pool, const std::vector<int>& handSizes,
+                      const OpponentBelief* tracked, const std::vector<HeadlessSkill>& skills, int self,
+                      const ISMCTSPlayer::Config& config, uint64_t seed,
+                      std::chrono::steady_clock::time_point deadline, RolloutStats& stats) {
+    Common::ShuffleRng rng(seed);
+    stats.wins.assign(skills.size() + 1, 0);
+    stats.plays.assign(skills.size() + 1, 0);
+    // 每轮所有用法各下一局，至少一轮
+    do {
+        for (size_t option = 0; option <= skills.size(); option++) {
+            HeadlessGame game = root;
+            deal(game, pool, handSizes, tracked, self, rng);
+            if (option > 0) {
+                game.useSkill(skills[option - 1], rng);
+            }
+            int winner = game.playout(rng, config.maxRolloutTurns);
+            stats.wins[option] += winner == self;
+            stats.plays[option]++;
+        }
+    } while (std::chrono::steady_clock::now() < deadline);
+}
+
+void runSearch(const HeadlessGame& root, std::vector<CardCode> pool, const std::vector<int>& handSizes,
+               const OpponentBelief* tracked, int self, const ISMCTSPlayer::Config& config, uint64_t seed,
+               std::chrono::steady_clock::time_point deadline, RootStats& stats) {
+    Common::ShuffleRng rng(seed);
+    std::vector<Node> tree(1);
+    tree.reserve(4096);
+    std::vector<HeadlessMove> legalMoves;
+    std::vector<int> path;
+    std::vector<HeadlessMove> untried;
+
+    for (int iteration = 0; ; iteration++) {
+        // 每 16 次检查一次时间，至少迭代一次，时间预算极小时也能给出结果
+        if (iteration > 0 && iteration % 16 == 0 && std::chrono::steady_clock::now() >= deadline) {
+            break;
+        }
+        HeadlessGame game = root;
+        deal(game, pool, handSizes, tracked, self, rng);
+
+        path.assign(1, 0);
+        int node = 0;
+        while (!game.isOver()) {
+            game.getLegalMoves(legalMoves);
+
+            // 这个确定化下可走的子节点都记一次可用，同时找出还没有子节点的步
+            untried = legalMoves;
+            for (int child : tree[node].children) {
+                auto it = std::find(untried.begin(), untried.end(), tree[child].move);
+                if (it != untried.end()) {
+                    tree[child].availability++;
+                    *it = untried.back();
+                    untried.pop_back();
+                }
+            }
+
+            if (!untried.empty()) {
+                // 扩展一步后改为随机下完
+                HeadlessMove move = untried[rng.Bounded(static_cast<uint32_t>(untried.size()))];
+                Node child;
+                child.move = move;
+                child.player = game.getCurrentPlayer();
+                child.availability = 1;
+                tree.push_back(std::move(child));
+                int childIndex = static_cast<int>(tree.size()) - 1;
+                tree[node].children.push_back(childIndex);
+                path.push_back(childIndex);
+                game.apply(move, rng);
+                break;
+            }
+
+            // 所有可走的步都展开过，按 UCB 选择
+            int best = -1;
+            double bestScore = -1;
+            for (int child : tree[node].children) {
+                const Node& candidate = tree[child];
+                if (std::find(legalMoves.begin(), legalMoves.end(), candidate.move) == legalMoves.end()) {
+                    continue;
+                }
+                double score = candidate.wins / candidate.visits
+                    + config.exploration * std::sqrt(std::log(candidate.availability) / candidate.visits);
+                if (score > bestScore) {
+                    bestScore = score;
+                    best = child;
+                }
+            }
+            path.push_back(best);
+            game.apply(tree[best].move, rng);
+            node = best;
+        }
+
+        int winner = game.isOver() ? game.getWinner() : game.playout(rng, config.maxRolloutTurns);
+        for (int index : path) {
+            Node& visited = tree[index];
+            visited.visits++;
+            if (visited.player == winner) {
+                visited.wins += 1;
+            }
+        }
+        stats.iterations++;
+    }
+
+    for (int child : tree[0].children) {
+        stats.visits.emplace_back(tree[child].move, tree[child].visits);
+    }
+}
+
+}
+
+ISMCTSPlayer::ISMCTSPlayer(int id, const std::string& name, const Config& config,
+                           std::shared_ptr<Common::ThreadPool> threadPool)
+    : Player(id, name, true),
+      config(config),
+      threadPool(threadPool ? std::move(threadPool) : std::make_shared<Common::ThreadPool>(
+          config.threadNum > 0 ? config.threadNum : static_cast<int>(std::thread::hardware_concurrency()))),
+      randomGenerator(config.seed != 0 ? config.seed : std::random_device{}()),
+      chosenColor(CardColor::RED),
+      lastIterations(0) {}
+
+std::shared_ptr<Card> ISMCTSPlayer::playTurn(GameState& gameState) {
+    auto playableCards = getPlayableCards(gameState);
+    if (playableCards.empty()) {
+        return nullptr; // 没有可出的牌，需要抽牌
+    }
+
+    // 只有一张能出的普通牌时不需要搜索
+    bool choosesColor = playableCards[0]->getColor() == CardColor::WILD
+        || playableCards[0]->getType() == CardType::PACKAGE;
+    if (playableCards.size() == 1 && !choosesColor) {
+        return playableCards[0];
+    }
+
+    std::vector<CardCode> unseen;
+    std::vector<int> handSizes;
+    HeadlessGame root = buildRootGame(gameState, unseen, handSizes);
+    HeadlessMove move = search(root, unseen, handSizes, syncBelief(handSizes, unseen));
+    if (move.color != CodeColor::WILD) {
+        chosenColor = static_cast<CardColor>(move.color);
+    }
+    for (const auto& card : playableCards) {
+        if (normalized(card->getCardData().toCode()) == move.card) {
+            return card;
+        }
+    }
+    // 模拟规则和实际规则判断不一致时，退回第一张能出的牌
+    return playableCards[0];
+}
+
+bool ISMCTSPlayer::decideUseSkill(GameState& gameState) {
+    HeadlessCharacter skill = SkillPolicy::toHeadlessCharacter(character);
+    std::vector<SkillChoice> choices;
+    SkillPolicy::rank(skill, SkillPolicy::observe(gameState, id, skill, handCards), choices);
+    skillChoice = SkillChoice();
+    if (choices.empty()) {
+        return false;
+    }
+    if (skill != HeadlessCharacter::THIEF) {
+        // 收藏家和幸运星的候选牌在模拟中看不到，只按估值决定
+        skillChoice = choices[0];
+        return skillChoice.score > 0;
+    }
+
+    int best = compareSkillsByRollouts(gameState, skill, choices);
+    if (best < 0) {
+        return false;
+    }
+    skillChoice = choices[best];
+    return true;
+}
+
+nlohmann::json ISMCTSPlayer::getSkillParameters(GameState& gameState) {
+    HeadlessCharacter skill = SkillPolicy::toHeadlessCharacter(character);
+    if (skill == HeadlessCharacter::LUCKY_STAR) {
+        // 决定发动之后才看抽牌堆
+        skillChoice.cardIndex = SkillPolicy::chooseKeptCard(gameState, id, handCards);
+    }
+    return SkillPolicy::toParameters(skill, skillChoice);
+}
+
+CardColor ISMCTSPlayer::chooseWildColor(GameState& gameState) {
+    // 搜索出牌时已经选好了颜色
+    return chosenColor;
+}
+
+HeadlessGame ISMCTSPlayer::buildRootGame(const GameState& gameState, std::vector<CardCode>& unseen,
+                                         std::vector<int>& handSizes) const {
+    int playerNum = gameState.getPlayerCount();
+    HeadlessGame game(playerNum);
+    game.setCurrentPlayer(id);
+    game.setClockwise(gameState.isClockwise());
+
+    handSizes.assign(playerNum, 0);
+    int cardNum = 0;
+    for (int player = 0; player < playerNum; player++) {
+        handSizes[player] = player == id ? static_cast<int>(handCards.size()) : gameState.getPlayerHandSize(player);
+        cardNum += handSizes[player];
+    }
+
+    // 每种编码还剩几张没看到，牌不够分时按多副牌计算
+    std::array<int, 256> remaining{};
+    auto standardDeck = Deck::getStandardDeck();
+    int deckNum = 1 + cardNum / static_cast<int>(standardDeck.size());
+    for (int deck = 0; deck < deckNum; deck++) {
+        for (auto code : standardDeck) {
+            remaining[code.ToByte()]++;
+        }
+    }
+
+    auto& hand = game.getHand(id);
+    for (const auto& card : handCards) {
+        CardCode code = normalized(card->getCardData().toCode());
+        hand.push_back(code);
+        remaining[code.ToByte()] = std::max(remaining[code.ToByte()] - 1, 0);
+    }
+
+    auto topCard = gameState.getTopCard();
+    CodeColor currentColor = static_cast<CodeColor>(gameState.getCurrentColor());
+    if (topCard) {
+        CardCode top = normalized(topCard->getCardData().toCode());
+        game.setTop(top, currentColor);
+        remaining[top.ToByte()] = std::max(remaining[top.ToByte()] - 1, 0);
+    }
+    else {
+        game.setTop(CardCode(), currentColor);
+    }
+
+    unseen.clear();
+    for (int byte = 0; byte < 256; byte++) {
+        unseen.insert(unseen.end(), remaining[byte], CardCode::FromByte(static_cast<uint8_t>(byte)));
+    }
+    return game;
+}
+
+const OpponentBelief* ISMCTSPlayer::syncBelief(const std::vector<int>& handSizes, std::vector<CardCode>& unseen) {
+    if (belief.getPlayerNum() != static_cast<int>(handSizes.size()) || belief.getSelf() != id) {
+        return nullptr;
+    }
+    for (int player = 0; player < belief.getPlayerNum(); player++) {
+        belief.setHandSize(player, handSizes[player]);
+    }
+    belief.getUnseenCards(unseen);
+    return &belief;
+}
+
+int ISMCTSPlayer::compareSkillsByRollouts(const GameState& gameState, HeadlessCharacter skill,
+                                          const std::vector<SkillChoice>& choices) {
+    std::vector<CardCode> unseen;
+    std::vector<int> handSizes;
+    HeadlessGame root = buildRootGame(gameState, unseen, handSizes);
+    root.setCharacter(id, skill);
+    const OpponentBelief* tracked = syncBelief(handSizes, unseen);
+
+    // 估值最高的几种用法，同一目标和类型在模拟中可能相同，不去重也不影响比较
+    std::vector<HeadlessSkill> skills;
+    for (size_t i = 0; i < choices.size() && i < ROLLOUT_SKILL_NUM; i++) {
+        skills.push_back(choices[i].toHeadlessSkill());
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + config.timeBudget;
+    std::vector<RolloutStats> results(threadPool->GetThreadNum());
+    for (auto& result : results) {
+        uint64_t seed = randomGenerator();
+        threadPool->Submit([&, seed] {
+            runSkillRollouts(root, unseen, handSizes, tracked, skills, id, config, seed, deadline, result);
+        });
+    }
+    threadPool->Wait();
+
+    std::vector<int> wins(skills.size() + 1);
+    std::vector<int> plays(skills.size() + 1);
+    for (const auto& result : results) {
+        for (size_t option = 0; option < wins.size(); option++) {
+            wins[option] += result.wins[option];
+            plays[option] += result.plays[option];
+        }
+    }
+    int best = -1;
+    double bestRate = static_cast<double>(wins[0]) / plays[0];
+    for (size_t option = 1; option < wins.size(); option++) {
+        double rate = static_cast<double>(wins[option]) / plays[option];
+        if (rate > bestRate) {
+            bestRate = rate;
+            best = static_cast<int>(option) - 1;
+        }
+    }
+    return best;
+}
+
+HeadlessMove ISMCTSPlayer::search(const HeadlessGame& root, const std::vector<CardCode>& unseen,
+                                  const std::vector<int>& handSizes, const OpponentBelief* tracked) {
+    auto deadline = std::chrono::steady_clock::now() + config.timeBudget;
+    std::vector<RootStats> results(threadPool->GetThreadNum());
+    for (auto& result : results) {
+        uint64_t seed = randomGenerator();
+        threadPool->Submit([&, seed] {
+            runSearch(root, unseen, handSizes, tracked, id, config, seed, deadline, result);
+        });
+    }
+    threadPool->Wait();
+
+    // 合并各线程根节点的访问次数
+    std::vector<std::pair<HeadlessMove, int>> total;
+    lastIterations = 0;
+    for (const auto& result : results) {
+        lastIterations += result.iterations;
+        for (const auto& [move, visits] : result.visits) {
+            auto it = std::find_if(total.begin(), total.end(), [&](const auto& entry) { return entry.first == move; });
+            if (it == total.end()) {
+                total.emplace_back(move, visits);
+            }
+            else {
+                it->second += visits;
+            }
+        }
+    }
+
+    auto best = std::max_element(total.begin(), total.end(),
+                                 [](const auto& a, const auto& b) { return a.second < b.second; });
+    return best == total.end() ? HeadlessMove{} : best->first;
+}
+
+} // namespace UNO
@@ -0,0 +1,96 @@
+#pragma once
+#include "Player.h"
+#include "HeadlessGame.h"
+#include "OpponentBelief.h"
+#include "SkillPolicy.h"
+#include "common/thread_pool.h"
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <random>
+
+namespace UNO {
+
+/**
+ * ISMCTSPlayer 的搜索参数
+ */
+struct ISMCTSConfig {
+    std::chrono::milliseconds timeBudget{50};  // 每步的思考时间
+    int threadNum = 0;             // 没有共用线程池时自建的线程数，0 表示使用全部硬件线程
+    int maxRolloutTurns = 200;     // 随机下完时最多进行的回合数
+    double exploration = 0.7;      // UCB 的探索系数
+    uint64_t seed = 0;             // 0 表示随机种子
+};
+
+/**
+ * 基于信息集蒙特卡洛树搜索（ISMCTS）的AI玩家
+ * 每次迭代把看不到的牌随机发给对手（确定化），在 HeadlessGame 上沿树选择、扩展并随机下完，
+ * 各线程在时间预算内各自建树，最后合并根节点的访问次数，选访问最多的一步。
+ * 宿主把广播的事件交给 getBelief() 后，确定化按记牌的结果发牌；否则每步按看不到的牌均匀发牌。
+ * 技能先用 SkillPolicy 快速估值，小偷再把估值最高的几种用法和不发动各自随机下完若干局，按胜率选择
+ */
+class ISMCTSPlayer : public Player {
+public:
+    using Config = ISMCTSConfig;
+
+    /**
+     * @param threadPool 搜索用的线程池。同一进程中的多个 ISMCTS 玩家应共用一个，
+     *                   它们轮流思考，不会同时提交任务；为空时按 config.threadNum 自建
+     */
+    ISMCTSPlayer(int id, const std::string& name = "ISMCTS AI", const Config& config = Config(),
+                 std::shared_ptr<Common::ThreadPool> threadPool = nullptr);
+
+    // 游戏操作实现
+    std::shared_ptr<Card> playTurn(GameState& gameState) override;
+    bool decideUseSkill(GameState& gameState) override;
+    nlohmann::json getSkillParameters(GameState& gameState) override;
+    CardColor chooseWildColor(GameState& gameState) override;
+
+    const Config& getConfig() const { return config; }
+    // 上一次搜索所有线程的迭代总次数
+    int getLastIterations() const { return lastIterations; }
+    // 对手手牌的信念，开局时 reset，之后由宿主按事件更新
+    OpponentBelief& getBelief() { return belief; }
+
+private:
+    /**
+     * 从自己的视角构造牌局：自己的手牌、顶牌和方向是已知的，对手手牌为空，
+     * 同时求出看不到的牌（全部牌减去自己的手牌和顶牌）和各玩家的手牌张数
+     */
+    HeadlessGame buildRootGame(const GameState& gameState, std::vector<Common::CardCode>& unseen,
+                               std::vector<int>& handSizes) const;
+
+    /**
+     * 记牌的信念和这局对得上时，用 GameState 的手牌数校正，并改用它看不到的牌
+     * @return 对不上时返回空，按 unseen 均匀发牌
+     */
+    const OpponentBelief* syncBelief(const std::vector<int>& handSizes, std::vector<Common::CardCode>& unseen);
+
+    /**
+     * 在时间预算内比较不发动和 choices 中估值最高的几种用法的胜率
+     * @return 最好的用法在 choices 中的位置，不发动最好时返回 -1
+     */
+    int compareSkillsByRollouts(const GameState& gameState, HeadlessCharacter skill,
+                                const std::vector<SkillChoice>& choices);
+
+    /**
+     * 在多个线程上搜索到时间用完
+     * @param tracked 非空时用记牌的结果发牌，unseen 是它看不到的牌
+     * @return 根节点访问次数最多的一步
+     */
+    HeadlessMove search(const HeadlessGame& root, const std::vector<Common::CardCode>& unseen,
+                        const std::vector<int>& handSizes, const OpponentBelief* tracked);
+
+private:
+    constexpr static int ROLLOUT_SKILL_NUM = 3;  // 用随机下完比较的技能用法数
+
+    Config config;
+    std::shared_ptr<Common::ThreadPool> threadPool;
+    OpponentBelief belief;
+    std::mt19937_64 randomGenerator;
+    CardColor chosenColor;
+    SkillChoice skillChoice;
+    int lastIterations;
+};
+
+} // namespace UNO
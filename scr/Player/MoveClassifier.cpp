@@ -0,0 +1,32 @@
+#include "MoveClassifier.h"
+
+namespace UNO {
+
+void MoveClassifier::classify(const std::vector<std::shared_ptr<Card>>& hand, const Card* topCard) {
+    for (auto& bucket : buckets) {
+        bucket.clear();
+    }
+    for (size_t position = 0; position < hand.size(); position++) {
+        const Card& card = *hand[position];
+        if (card.canPlayOn(topCard)) {
+            buckets[static_cast<int>(categoryOf(card))].push_back(static_cast<uint16_t>(position));
+        }
+    }
+}
+
+size_t MoveClassifier::playableCount() const {
+    size_t total = 0;
+    for (const auto& bucket : buckets) {
+        total += bucket.size();
+    }
+    return total;
+}
+
+MoveClassifier::Category MoveClassifier::categoryOf(const Card& card) {
+    if (card.getColor() == CardColor::WILD) {
+        return Category::WILD;
+    }
+    return card.getType() == CardType::NUMBER ? Category::NUMBER : Category::ACTION;
+}
+
+} // namespace UNO
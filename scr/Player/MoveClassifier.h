@@ -0,0 +1,44 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+#include "Card.h"
+
+namespace UNO {
+
+/**
+ * 一次遍历手牌，把能出的牌按数字牌、功能牌、万能牌分桶，桶里记录牌在手牌中的下标。
+ * 桶的容量在多次决策之间复用，分类时不分配内存，也不复制 shared_ptr。
+ * 下标在手牌改变后失效，每次决策前重新分类。
+ */
+class MoveClassifier {
+public:
+    enum class Category : uint8_t {
+        NUMBER,  // 数字牌
+        ACTION,  // 有颜色的功能牌：跳过、反转、+2、Package
+        WILD,    // 万能牌：Wild、+4、Flash
+    };
+    static constexpr int CATEGORY_NUM = 3;
+
+    /**
+     * @param topCard 弃牌堆顶的牌，为空时所有牌都能出
+     */
+    void classify(const std::vector<std::shared_ptr<Card>>& hand, const Card* topCard);
+
+    std::span<const uint16_t> playable(Category category) const {
+        return buckets[static_cast<int>(category)];
+    }
+
+    size_t count(Category category) const { return playable(category).size(); }
+    size_t playableCount() const;
+
+    static Category categoryOf(const Card& card);
+
+private:
+    std::array<std::vector<uint16_t>, CATEGORY_NUM> buckets;
+};
+
+} // namespace UNO
@@ -0,0 +1,251 @@
+#include "OpponentBelief.h"
+#include "Deck.h"
+#include <algorithm>
+
+namespace UNO {
+
+using Common::CardCode;
+using Common::CodeColor;
+
+void OpponentBelief::reset(int playerNum, int self, int deckNum, std::span<const CardCode> ownHand,
+                           CardCode flipped, int initHandSize) {
+    this->self = self;
+    unseen.fill(0);
+    discarded.fill(0);
+    unseenByColor.fill(0);
+    unseenTotal = 0;
+    for (int deck = 0; deck < deckNum; deck++) {
+        for (auto code : Deck::getStandardDeck()) {
+            addUnseen(normalized(code), 1);
+        }
+    }
+    for (auto code : ownHand) {
+        addUnseen(normalized(code), -1);
+    }
+
+    players.assign(playerNum, PlayerBelief());
+    for (int player = 0; player < playerNum; player++) {
+        players[player].handSize = player == self ? static_cast<int>(ownHand.size()) : initHandSize;
+    }
+
+    topCard = CardCode();
+    if (flipped.IsValid()) {
+        topCard = normalized(flipped);
+        addUnseen(topCard, -1);
+        addToDiscard(topCard);
+    }
+}
+
+void OpponentBelief::onPlay(int player, CardCode card) {
+    onDiscard(player, card);
+    topCard = normalized(card);
+}
+
+void OpponentBelief::onDiscard(int player, CardCode card) {
+    PlayerBelief& belief = players[player];
+    CardCode code = normalized(card);
+    if (player != self) {
+        // 打出了确定不持有的颜色，只能是推断之后拿到的牌
+        if (belief.known[code.ToByte()] == 0 && (belief.voidColors & colorBit(code.GetColor()))) {
+            if (belief.unconstrained > 0) {
+                belief.unconstrained--;
+            }
+            else {
+                belief.voidColors = 0;
+            }
+        }
+        removeFromHand(player, code);
+    }
+    belief.handSize = std::max(belief.handSize - 1, 0);
+    belief.justDrew = false;
+    clampHand(belief);
+    addToDiscard(code);
+}
+
+void OpponentBelief::onDraw(int player, int number, CodeColor currentColor) {
+    PlayerBelief& belief = players[player];
+    belief.handSize += number;
+    belief.justDrew = number == 1;
+    if (player == self) {
+        return;
+    }
+    if (number == 1 && currentColor != CodeColor::WILD) {
+        // 之前拿到的牌不受原来的推断限制时，原来的推断不再覆盖所有的牌，只保留这一次的
+        uint8_t voidColors = colorBit(currentColor) | colorBit(CodeColor::WILD);
+        belief.voidColors = belief.unconstrained == 0 ? (belief.voidColors | voidColors) : voidColors;
+        belief.unconstrained = 1;
+    }
+    else {
+        belief.unconstrained += number;
+    }
+}
+
+void OpponentBelief::onOwnCardsDrawn(std::span<const CardCode> cards) {
+    for (auto card : cards) {
+        addUnseen(normalized(card), -1);
+    }
+}
+
+void OpponentBelief::onSkip(int player) {
+    PlayerBelief& belief = players[player];
+    if (belief.justDrew && player != self && belief.unconstrained > 0) {
+        // 抽到的牌也不能出，同样受推断的限制
+        belief.unconstrained--;
+    }
+    belief.justDrew = false;
+}
+
+void OpponentBelief::onCollect(int player, CardCode card) {
+    CardCode code = normalized(card);
+    if (discarded[code.ToByte()] > 0) {
+        discarded[code.ToByte()]--;
+    }
+    PlayerBelief& belief = players[player];
+    belief.handSize++;
+    if (player != self) {
+        belief.known[code.ToByte()]++;
+        belief.knownTotal++;
+    }
+}
+
+void OpponentBelief::onCardMoved(int from, int to, CardCode card) {
+    PlayerBelief& giver = players[from];
+    PlayerBelief& taker = players[to];
+    giver.handSize = std::max(giver.handSize - 1, 0);
+    taker.handSize++;
+
+    if (!card.IsValid()) {
+        // 看不到的牌：接收方多了一张任意的牌
+        if (to != self) {
+            taker.unconstrained++;
+        }
+        clampHand(giver);
+        return;
+    }
+
+    // 对手手中的牌从已知或看不到的牌中减掉，自己的牌本来就不在其中；到了对手手中就是已知的牌
+    CardCode code = normalized(card);
+    if (from != self) {
+        removeFromHand(from, code);
+    }
+    if (to != self) {
+        taker.known[code.ToByte()]++;
+        taker.knownTotal++;
+    }
+    clampHand(giver);
+}
+
+void OpponentBelief::onCardRevealed(int player, CardCode card) {
+    if (player == self) {
+        return;
+    }
+    CardCode code = normalized(card);
+    PlayerBelief& belief = players[player];
+    if (belief.knownTotal < belief.handSize && unseen[code.ToByte()] > 0) {
+        belief.known[code.ToByte()]++;
+        belief.knownTotal++;
+        addUnseen(code, -1);
+    }
+}
+
+void OpponentBelief::onReshuffle() {
+    for (int byte = 0; byte < CODE_NUM; byte++) {
+        if (discarded[byte] > 0) {
+            addUnseen(CardCode::FromByte(static_cast<uint8_t>(byte)), discarded[byte]);
+            discarded[byte] = 0;
+        }
+    }
+    if (topCard.IsValid()) {
+        addUnseen(topCard, -1);
+        discarded[topCard.ToByte()] = 1;
+    }
+}
+
+void OpponentBelief::setHandSize(int player, int size) {
+    PlayerBelief& belief = players[player];
+    if (size > belief.handSize && player != self) {
+        belief.unconstrained += size - belief.handSize;
+    }
+    belief.handSize = size;
+    clampHand(belief);
+}
+
+void OpponentBelief::getUnseenCards(std::vector<CardCode>& out) const {
+    out.clear();
+    out.reserve(unseenTotal);
+    for (int byte = 0; byte < CODE_NUM; byte++) {
+        out.insert(out.end(), unseen[byte], CardCode::FromByte(static_cast<uint8_t>(byte)));
+    }
+}
+
+void OpponentBelief::deal(HeadlessGame& game, std::vector<CardCode>& pool, Common::ShuffleRng& rng) const {
+    Common::Shuffle(std::span(pool), rng);
+    size_t next = 0;
+    for (int player = 0; player < getPlayerNum(); player++) {
+        if (player == self) {
+            continue;
+        }
+        const PlayerBelief& belief = players[player];
+        auto& hand = game.getHand(player);
+        hand.clear();
+        if (belief.knownTotal > 0) {
+            for (int byte = 0; byte < CODE_NUM; byte++) {
+                hand.insert(hand.end(), belief.known[byte], CardCode::FromByte(static_cast<uint8_t>(byte)));
+            }
+        }
+
+        int slots = std::max(belief.handSize - belief.knownTotal, 0);
+        int constrained = belief.voidColors != 0 ? std::max(slots - belief.unconstrained, 0) : 0;
+        for (int slot = 0; slot < slots && next < pool.size(); slot++) {
+            if (slot < constrained) {
+                // 找一张可能持有的颜色的牌换到前面，找不到时说明推断有误，直接用下一张
+                auto it = std::find_if(pool.begin() + next, pool.end(), [&](CardCode code) {
+                    return (belief.voidColors & colorBit(code.GetColor())) == 0;
+                });
+                if (it != pool.end()) {
+                    std::iter_swap(pool.begin() + next, it);
+                }
+            }
+            hand.push_back(pool[next++]);
+        }
+    }
+    game.getDrawPile().assign(pool.begin() + next, pool.end());
+}
+
+void OpponentBelief::removeFromHand(int player, CardCode code) {
+    PlayerBelief& belief = players[player];
+    if (belief.known[code.ToByte()] > 0) {
+        belief.known[code.ToByte()]--;
+        belief.knownTotal--;
+    }
+    else if (unseen[code.ToByte()] > 0) {
+        addUnseen(code, -1);
+    }
+}
+
+void OpponentBelief::addUnseen(CardCode code, int count) {
+    int& slot = unseen[code.ToByte()];
+    // 牌的数量和记录不一致（比如副数估计错了）时不减成负数
+    count = std::max(count, -slot);
+    slot += count;
+    unseenByColor[static_cast<int>(code.GetColor())] += count;
+    unseenTotal += count;
+}
+
+void OpponentBelief::addToDiscard(CardCode code) {
+    discarded[code.ToByte()]++;
+}
+
+void OpponentBelief::clampHand(PlayerBelief& belief) {
+    if (belief.knownTotal > belief.handSize) {
+        // 不知道丢掉的是哪张已知的牌，全部作废
+        for (int byte = 0; byte < CODE_NUM; byte++) {
+            addUnseen(CardCode::FromByte(static_cast<uint8_t>(byte)), belief.known[byte]);
+        }
+        belief.known.fill(0);
+        belief.knownTotal = 0;
+    }
+    belief.unconstrained = std::min(belief.unconstrained, belief.handSize - belief.knownTotal);
+}
+
+} // namespace UNO
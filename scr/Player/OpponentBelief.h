@@ -0,0 +1,150 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "HeadlessGame.h"
+#include "common/card_code.h"
+#include "common/shuffle.h"
+
+namespace UNO {
+
+/**
+ * 机器人对其他玩家手牌的信念（记牌），随服务器广播的事件增量更新，搜索时据此给对手发牌。
+ * 事件和消息的对应关系：PlayInfo 对应 onPlay，DrawInfo 对应 onDraw，发给自己的 DrawRspInfo
+ * 对应 onOwnCardsDrawn，SkipInfo 对应 onSkip；Package 丢弃的牌对应 onDiscard，收藏家对应
+ * onCollect，小偷对应 onCardMoved，技能响应中亮出的牌对应 onCardRevealed。
+ *
+ * 每种编码还有几张没看到、每个玩家已知持有的牌都存在定长数组中，更新和查询都是 O(1)。
+ * 抽一张牌（不是罚抽）说明玩家当时没有能出的牌，于是记下他不持有当前颜色和万能牌；
+ * 之后拿到的牌不受这个限制，单独计数。万能牌按 WILD 颜色计数，不区分选择的颜色。
+ */
+class OpponentBelief {
+public:
+    constexpr static int CODE_NUM = 256;
+    constexpr static int COLOR_NUM = 5;  // 包括万能牌
+
+    /**
+     * 开始一局：全部牌是 deckNum 副标准牌，自己的初始手牌和翻开的牌是已知的，
+     * 其余玩家各有 initHandSize 张
+     */
+    void reset(int playerNum, int self, int deckNum, std::span<const Common::CardCode> ownHand,
+               Common::CardCode flipped, int initHandSize);
+
+    /**
+     * 玩家打出一张牌，成为新的顶牌
+     */
+    void onPlay(int player, Common::CardCode card);
+
+    /**
+     * 玩家抽了 number 张牌；只抽一张时是普通抽牌，说明他没有当前颜色的牌和万能牌
+     */
+    void onDraw(int player, int number, Common::CodeColor currentColor);
+
+    /**
+     * 自己抽到的牌（DrawRspInfo），在 onDraw 之后调用
+     */
+    void onOwnCardsDrawn(std::span<const Common::CardCode> cards);
+
+    /**
+     * 玩家跳过；刚抽了一张牌就跳过说明抽到的牌也不能出
+     */
+    void onSkip(int player);
+
+    /**
+     * 玩家的一张牌被丢进弃牌堆但不成为顶牌（Package 丢弃的数字牌）
+     */
+    void onDiscard(int player, Common::CardCode card);
+
+    /**
+     * 收藏家从弃牌堆拿走一张牌，这张牌是所有人都看到的
+     */
+    void onCollect(int player, Common::CardCode card);
+
+    /**
+     * 一张牌从 from 的手中到了 to 的手中（小偷偷牌和还牌）
+     * @param card 自己是其中一方或服务器亮出了牌时有效，否则是无效编码
+     */
+    void onCardMoved(int from, int to, Common::CardCode card);
+
+    /**
+     * 得知玩家持有某张牌（技能响应中亮出的牌）
+     */
+    void onCardRevealed(int player, Common::CardCode card);
+
+    /**
+     * 抽牌堆用完，除顶牌外的弃牌洗回抽牌堆，重新变成看不到的牌
+     */
+    void onReshuffle();
+
+    /**
+     * 用实际的手牌数校正（GameState 中的张数是准确的），多出来的牌不受推断限制
+     */
+    void setHandSize(int player, int size);
+
+    // 查询
+    int getPlayerNum() const { return static_cast<int>(players.size()); }
+    int getSelf() const { return self; }
+    int getHandSize(int player) const { return players[player].handSize; }
+    int getUnseen(Common::CardCode card) const { return unseen[normalized(card).ToByte()]; }
+    int getUnseen(Common::CodeColor color) const { return unseenByColor[static_cast<int>(color)]; }
+    int getUnseenTotal() const { return unseenTotal; }
+    int getKnown(int player, Common::CardCode card) const { return players[player].known[normalized(card).ToByte()]; }
+    int getKnownTotal(int player) const { return players[player].knownTotal; }
+
+    /**
+     * 玩家可能持有这种颜色（WILD 表示万能牌）的牌；只对抽牌之前就有的牌成立
+     */
+    bool mayHold(int player, Common::CodeColor color) const {
+        return (players[player].voidColors & colorBit(color)) == 0 || players[player].unconstrained > 0;
+    }
+
+    /**
+     * 所有看不到的牌，每张一个编码，顺序固定
+     */
+    void getUnseenCards(std::vector<Common::CardCode>& out) const;
+
+    /**
+     * 按信念给对手发牌：先发已知的牌，抽牌前就有的牌只从他可能持有的颜色中抽，
+     * 剩下的作为抽牌堆。只读，可以在多个搜索线程中同时调用。
+     * @param pool getUnseenCards 得到的牌，会被打乱
+     */
+    void deal(HeadlessGame& game, std::vector<Common::CardCode>& pool, Common::ShuffleRng& rng) const;
+
+    // 相同的编码在不同副牌中可以互相替换，万能牌不区分选择的颜色
+    static Common::CardCode normalized(Common::CardCode card) {
+        return card.IsWild() ? card.WithColor(Common::CodeColor::WILD) : card;
+    }
+
+private:
+    struct PlayerBelief {
+        std::array<uint8_t, CODE_NUM> known{};  // 已知持有的牌
+        int knownTotal = 0;
+        int handSize = 0;
+        uint8_t voidColors = 0;   // 确定不持有的颜色，按 colorBit
+        int unconstrained = 0;    // 推断之后拿到的牌，不受 voidColors 限制
+        bool justDrew = false;    // 上一个动作是普通抽牌
+    };
+
+    static uint8_t colorBit(Common::CodeColor color) { return static_cast<uint8_t>(1 << static_cast<int>(color)); }
+
+    /**
+     * 牌离开玩家的手：已知的牌先减，否则从看不到的牌中减
+     */
+    void removeFromHand(int player, Common::CardCode card);
+    void addUnseen(Common::CardCode card, int count);
+    void addToDiscard(Common::CardCode card);
+    // 手牌变少后已知和不受限的牌不能超过手牌数
+    void clampHand(PlayerBelief& belief);
+
+private:
+    std::array<int, CODE_NUM> unseen{};
+    std::array<int, CODE_NUM> discarded{};  // 弃牌堆中的牌，包括顶牌
+    std::array<int, COLOR_NUM> unseenByColor{};
+    int unseenTotal = 0;
+    Common::CardCode topCard;
+    int self = 0;
+    std::vector<PlayerBelief> players;
+};
+
+} // namespace UNO
@@ -1,5 +1,6 @@
 #include "Player.h"
 #include "GameState.h"
+#include "CardFactory.h"
 #include <algorithm>
 
 namespace UNO {
@@ -9,7 +10,8 @@ Player::Player(int id, const std::string& name, bool isAI)
       hasUnoStatus(false), score(0) {}
 
 void Player::addCardToHand(std::shared_ptr<Card> card) {
-    handCards.push_back(card);
+    handIndex.add(card->getColor(), card->getType());
+    handCards.push_back(std::move(card));
     hasUnoStatus = (handCards.size() == 1); // 如果只剩一张牌，自动标记UNO状态
 }
 
@@ -20,13 +22,46 @@ bool Player::removeCardFromHand(int cardId) {
         });
     
     if (it != handCards.end()) {
-        handCards.erase(it);
-        hasUnoStatus = (handCards.size() == 1); // 更新UNO状态
+        takeCardAt(static_cast<size_t>(it - handCards.begin()));
         return true;
     }
     return false;
 }
 
+std::shared_ptr<Card> Player::takeRandomCard(CardType type, std::mt19937& rng) {
+    size_t count = handIndex.count(type);
+    if (count == 0) {
+        return nullptr;
+    }
+    size_t n = std::uniform_int_distribution<size_t>(0, count - 1)(rng);
+    return takeCardAt(handIndex.nthOfType(type, n));
+}
+
+size_t Player::takeCards(CardColor color, CardType type, std::vector<std::shared_ptr<Card>>& out) {
+    size_t taken = 0;
+    // 每次取桶中最后一张，删除后桶中其余牌的下标由索引更新
+    while (!handIndex.positions(color, type).empty()) {
+        out.push_back(takeCardAt(handIndex.positions(color, type).back()));
+        taken++;
+    }
+    return taken;
+}
+
+std::shared_ptr<Card> Player::takeCardAt(size_t position) {
+    std::shared_ptr<Card> card = std::move(handCards[position]);
+    handCards.erase(handCards.begin() + position);
+    handIndex.remove(position);
+    hasUnoStatus = (handCards.size() == 1); // 更新UNO状态
+    return card;
+}
+
+void Player::rebuildHandIndex() {
+    handIndex.clear();
+    for (const auto& card : handCards) {
+        handIndex.add(card->getColor(), card->getType());
+    }
+}
+
 bool Player::hasCard(int cardId) const {
     return std::any_of(handCards.begin(), handCards.end(),
         [cardId](const std::shared_ptr<Card>& card) {
@@ -80,14 +115,54 @@ void Player::fromJson(const nlohmann::json& data) {
     hasUnoStatus = data.value("hasUno", false);
     score = data.value("score", 0);
     
-    // 注意：卡牌对象的重建需要卡牌工厂
     handCards.clear();
     if (data.contains("handCards")) {
         for (const auto& cardData : data["handCards"]) {
-            // 这里需要卡牌工厂来重建卡牌对象
-            // handCards.push_back(CardFactory::createFromJson(cardData));
+            if (auto card = CardFactory::createFromJson(cardData)) {
+                handCards.push_back(std::move(card));
+            }
         }
     }
+    rebuildHandIndex();
+}
+
+void Player::writeBinary(std::vector<uint8_t>& out) const {
+    BinaryWriter writer(out);
+    writer.write(static_cast<int32_t>(id));
+    writer.write(static_cast<uint8_t>((isAIPlayer ? 1 : 0) | (hasUnoStatus ? 2 : 0)));
+    writer.write(static_cast<uint8_t>(character));
+    writer.write(static_cast<int32_t>(score));
+    writer.write(static_cast<uint16_t>(name.size()));
+    writer.writeBytes({reinterpret_cast<const uint8_t*>(name.data()), name.size()});
+    writer.write(static_cast<uint16_t>(handCards.size()));
+    CardFactory::encodeCards(handCards, out);
+}
+
+bool Player::readBinary(BinaryReader& reader) {
+    int32_t newId, newScore;
+    uint8_t flags, newCharacter;
+    uint16_t nameSize, handSize;
+    std::span<const uint8_t> nameBytes, handCodes;
+    if (!reader.read(newId) || !reader.read(flags) || !reader.read(newCharacter) || !reader.read(newScore)
+        || !reader.read(nameSize) || !reader.readBytes(nameSize, nameBytes)
+        || !reader.read(handSize) || !reader.readBytes(handSize, handCodes)) {
+        return false;
+    }
+    // 手牌中有无效编码时整个存档无效，和 Deck::readBinary 一致
+    std::vector<std::shared_ptr<Card>> newHand;
+    if (!CardFactory::decodeCards(handCodes, newHand)) {
+        return false;
+    }
+    
+    id = newId;
+    isAIPlayer = flags & 1;
+    hasUnoStatus = flags & 2;
+    character = static_cast<CharacterType>(newCharacter);
+    score = newScore;
+    name.assign(nameBytes.begin(), nameBytes.end());
+    handCards = std::move(newHand);
+    rebuildHandIndex();
+    return true;
 }
 
 } // namespace UNO
@@ -2,8 +2,11 @@
 #include <vector>
 #include <string>
 #include <memory>
+#include <random>
 #include <nlohmann/json.hpp>
 #include "Card.h"
+#include "BinaryIO.h"
+#include "HandIndex.h"
 #include "common/GameTypes.h"
 
 namespace UNO {
@@ -36,6 +39,23 @@ public:
     void setUno(bool status) { hasUnoStatus = status; }
     bool isHandEmpty() const { return handCards.empty(); }
 
+    // 按颜色和类型查询、取出手牌（通过索引，只访问符合条件的牌）
+    size_t countCards(CardType type) const { return handIndex.count(type); }
+    size_t countCards(CardColor color) const { return handIndex.count(color); }
+    size_t countCards(CardColor color, CardType type) const { return handIndex.count(color, type); }
+
+    /**
+     * 随机取出一张指定类型的牌（小偷技能）
+     * @return 没有该类型的牌时返回空指针
+     */
+    std::shared_ptr<Card> takeRandomCard(CardType type, std::mt19937& rng);
+
+    /**
+     * 取出所有指定颜色和类型的牌，追加到 out（包装卡丢弃同色数字牌）
+     * @return 取出的张数
+     */
+    size_t takeCards(CardColor color, CardType type, std::vector<std::shared_ptr<Card>>& out);
+
     // 游戏操作接口
     virtual std::shared_ptr<Card> playTurn(GameState& gameState) = 0;
     virtual bool decideUseSkill(GameState& gameState) = 0;
@@ -47,21 +67,40 @@ public:
     bool hasPlayableCards(const GameState& gameState) const;
     std::vector<std::shared_ptr<Card>> getPlayableCards(const GameState& gameState) const;
 
-    // 序列化
+    // 序列化（JSON 只用于调试和导出，存档使用二进制格式）
     nlohmann::json toJson() const;
     void fromJson(const nlohmann::json& data);
+    
+    /**
+     * 二进制存档：玩家信息之后每张手牌一个编码字节
+     */
+    void writeBinary(std::vector<uint8_t>& out) const;
+    
+    /**
+     * @return 数据被截断时返回 false，玩家状态未定义
+     */
+    bool readBinary(BinaryReader& reader);
 
     // 统计信息
     int getScore() const { return score; }
     void addScore(int points) { score += points; }
     void resetScore() { score = 0; }
 
+protected:
+    /**
+     * 删除指定下标的手牌，其余手牌保持原来的顺序
+     */
+    std::shared_ptr<Card> takeCardAt(size_t position);
+
+    void rebuildHandIndex();
+
 protected:
     int id;
     std::string name;
     bool isAIPlayer;
     CharacterType character;
     std::vector<std::shared_ptr<Card>> handCards;
+    HandIndex handIndex;  // 与 handCards 同步维护
     bool hasUnoStatus;
     int score;
 };
@@ -0,0 +1,347 @@
+#include "SkillPolicy.h"
+#include "GameState.h"
+#include "Deck.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+
+namespace UNO {
+
+using Common::CardCode;
+using Common::CodeColor;
+using Common::CodeFace;
+
+namespace {
+
+// 估值的权重，以一张手牌为 10
+constexpr double CARD_WEIGHT = 10;
+constexpr double COLOR_WEIGHT = 2;       // 每多一种颜色
+constexpr double WILD_BONUS = 3;
+constexpr double ACTION_BONUS = 1.5;
+constexpr double PLAYABLE_BONUS = 2;     // 现在就有能出的牌
+constexpr double THREAT_WEIGHT = 4;      // 对手的威胁和手牌张数成反比
+
+// 技能次数有限，增益要超过留着以后用的价值才发动
+constexpr double KEEP_THIEF = 3;
+constexpr double KEEP_COLLECTOR = 1;
+constexpr double KEEP_LUCKY_STAR = 2;    // 幸运星有三次
+
+constexpr int FACE_NUM = static_cast<int>(CodeFace::EMPTY);
+constexpr std::array<CodeFace, 8> STEAL_FACES = {
+    CodeFace::NUMBER_0, CodeFace::SKIP, CodeFace::REVERSE, CodeFace::DRAW_TWO,
+    CodeFace::WILD, CodeFace::DRAW_FOUR, CodeFace::PACKAGE, CodeFace::FLASH
+};
+
+// 偷牌的类型，数字牌都归到 NUMBER_0
+CodeFace stealFaceOf(CardCode card) {
+    return card.GetNumber() >= 0 ? CodeFace::NUMBER_0 : card.GetFace();
+}
+
+// 对手失去这类牌的损失，出完牌时越关键的牌越大
+double denialValue(CodeFace face) {
+    switch (face) {
+        case CodeFace::SKIP: case CodeFace::REVERSE: return 2;
+        case CodeFace::DRAW_TWO: case CodeFace::PACKAGE: return 3;
+        case CodeFace::WILD: case CodeFace::FLASH: return 4;
+        case CodeFace::DRAW_FOUR: return 5;
+        default: return 1;
+    }
+}
+
+/**
+ * 一副标准牌中每类牌的张数和一张样本（样本决定这类牌是不是万能牌）
+ */
+struct DeckComposition {
+    std::array<int, FACE_NUM> counts{};
+    std::array<CardCode, FACE_NUM> samples{};
+    int total = 0;
+};
+
+const DeckComposition& standardComposition() {
+    static const DeckComposition composition = [] {
+        DeckComposition result;
+        for (auto code : Deck::getStandardDeck()) {
+            int face = static_cast<int>(stealFaceOf(code));
+            result.counts[face]++;
+            result.samples[face] = code;
+            result.total++;
+        }
+        return result;
+    }();
+    return composition;
+}
+
+bool canStack(CardCode card, CardCode topCard) {
+    return card.GetFace() == CodeFace::DRAW_FOUR
+        || (card.GetFace() == CodeFace::DRAW_TWO && topCard.GetFace() == CodeFace::DRAW_TWO);
+}
+
+void sortByScore(std::vector<SkillChoice>& choices) {
+    std::stable_sort(choices.begin(), choices.end(),
+                     [](const SkillChoice& a, const SkillChoice& b) { return a.score > b.score; });
+}
+
+}
+
+double SkillPolicy::evaluateHand(std::span<const CardCode> hand, CardCode topCard, CodeColor currentColor,
+                                 int cardsNumToDraw) {
+    double score = -CARD_WEIGHT * static_cast<double>(hand.size());
+    unsigned colors = 0;
+    bool hasPlayable = false;
+    bool hasStacker = false;
+    for (auto card : hand) {
+        if (card.IsWild()) {
+            score += WILD_BONUS;
+        }
+        else {
+            colors |= 1u << static_cast<int>(card.GetColor());
+            if (card.GetNumber() < 0) {
+                score += ACTION_BONUS;
+            }
+        }
+        hasPlayable = hasPlayable || HeadlessGame::matches(card, topCard, currentColor);
+        hasStacker = hasStacker || canStack(card, topCard);
+    }
+    score -= COLOR_WEIGHT * std::popcount(colors);
+
+    if (cardsNumToDraw > 1) {
+        // 能叠加就把罚抽传给下家，否则要抽这么多张
+        if (!hasStacker) {
+            score -= CARD_WEIGHT * cardsNumToDraw;
+        }
+    }
+    else if (hasPlayable) {
+        score += PLAYABLE_BONUS;
+    }
+    return score;
+}
+
+void SkillPolicy::rank(HeadlessCharacter character, const SkillSituation& situation, std::vector<SkillChoice>& out) {
+    out.clear();
+    switch (character) {
+        case HeadlessCharacter::THIEF:
+            rankThief(situation, out);
+            break;
+        case HeadlessCharacter::COLLECTOR:
+            rankCollector(situation, out);
+            break;
+        case HeadlessCharacter::LUCKY_STAR:
+            rankLuckyStar(situation, out);
+            break;
+        default:
+            // 防御者没有主动技能
+            break;
+    }
+    sortByScore(out);
+}
+
+bool SkillPolicy::choose(HeadlessCharacter character, const SkillSituation& situation, SkillChoice& out) {
+    std::vector<SkillChoice> choices;
+    rank(character, situation, choices);
+    if (choices.empty() || choices[0].score <= 0) {
+        return false;
+    }
+    out = choices[0];
+    return true;
+}
+
+SkillSituation SkillPolicy::observe(const GameState& gameState, int self, HeadlessCharacter character,
+                                    const std::vector<std::shared_ptr<Card>>& hand) {
+    SkillSituation situation;
+    situation.self = self;
+    for (const auto& card : hand) {
+        situation.hand.push_back(card->getCardData().toCode());
+    }
+    int playerNum = gameState.getPlayerCount();
+    situation.handSizes.resize(playerNum);
+    for (int player = 0; player < playerNum; player++) {
+        situation.handSizes[player] = player == self ? static_cast<int>(hand.size()) : gameState.getPlayerHandSize(player);
+    }
+    auto topCard = gameState.getTopCard();
+    if (topCard) {
+        situation.topCard = topCard->getCardData().toCode();
+    }
+    situation.currentColor = static_cast<CodeColor>(gameState.getCurrentColor());
+    situation.cardsNumToDraw = gameState.getCardsNumToDraw();
+
+    // 弃牌堆是公开的；抽牌堆要等幸运星发动之后才能看，见 chooseKeptCard
+    if (character == HeadlessCharacter::COLLECTOR) {
+        for (const auto& card : gameState.getCollectableCards()) {
+            situation.candidates.push_back(card.toCode());
+        }
+    }
+    return situation;
+}
+
+int SkillPolicy::chooseKeptCard(const GameState& gameState, int self, const std::vector<std::shared_ptr<Card>>& hand) {
+    SkillSituation situation = observe(gameState, self, HeadlessCharacter::LUCKY_STAR, hand);
+    for (const auto& card : gameState.peekDrawPile(LUCKY_STAR_VIEW_NUM)) {
+        situation.candidates.push_back(card.toCode());
+    }
+    // 已经发动了，即使估值不如直接抽也要留一张
+    std::vector<SkillChoice> choices;
+    rankLuckyStar(situation, choices);
+    sortByScore(choices);
+    return choices.empty() ? -1 : choices[0].cardIndex;
+}
+
+nlohmann::json SkillPolicy::toParameters(HeadlessCharacter character, const SkillChoice& choice) {
+    nlohmann::json params = nlohmann::json::object();
+    if (character == HeadlessCharacter::THIEF) {
+        // 功能牌的编码排在十个数字之后，顺序和 CardType 一致
+        CardType cardType = choice.stealFace == CodeFace::NUMBER_0
+            ? CardType::NUMBER : static_cast<CardType>(static_cast<int>(choice.stealFace) - 9);
+        params["targetPlayer"] = choice.target;
+        params["cardType"] = static_cast<int>(cardType);
+    }
+    else if (choice.cardIndex >= 0) {
+        params["cardIndex"] = choice.cardIndex;
+    }
+    return params;
+}
+
+HeadlessCharacter SkillPolicy::toHeadlessCharacter(CharacterType character) {
+    switch (character) {
+        case CharacterType::LUCKY_STAR: return HeadlessCharacter::LUCKY_STAR;
+        case CharacterType::COLLECTOR: return HeadlessCharacter::COLLECTOR;
+        case CharacterType::THIEF: return HeadlessCharacter::THIEF;
+        case CharacterType::DEFENDER: return HeadlessCharacter::DEFENDER;
+        default: return HeadlessCharacter::NONE;
+    }
+}
+
+void SkillPolicy::rankThief(const SkillSituation& situation, std::vector<SkillChoice>& out) {
+    const auto& hand = situation.hand;
+    if (hand.empty()) {
+        return;
+    }
+    double current = evaluateHand(hand, situation.topCard, situation.currentColor, situation.cardsNumToDraw);
+
+    // 还给对方的牌：去掉后估值最高的一张
+    std::vector<CardCode> rest = hand;
+    size_t worst = 0;
+    double bestRest = -1e9;
+    for (size_t position = 0; position < hand.size(); position++) {
+        std::swap(rest[position], rest.back());
+        double score = evaluateHand(std::span(rest.data(), rest.size() - 1), situation.topCard,
+                                    situation.currentColor, situation.cardsNumToDraw);
+        std::swap(rest[position], rest.back());
+        if (score > bestRest) {
+            bestRest = score;
+            worst = position;
+        }
+    }
+    std::swap(rest[worst], rest.back());
+
+    // 看不到的牌按标准牌的比例估计，牌多时按多副牌算
+    const auto& composition = standardComposition();
+    int cardNum = 0;
+    for (int size : situation.handSizes) {
+        cardNum += size;
+    }
+    int deckNum = 1 + cardNum / composition.total;
+    std::array<int, FACE_NUM> unseen{};
+    int unseenTotal = 0;
+    for (int face = 0; face < FACE_NUM; face++) {
+        unseen[face] = composition.counts[face] * deckNum;
+        unseenTotal += unseen[face];
+    }
+    auto see = [&](CardCode card) {
+        int& count = unseen[static_cast<int>(stealFaceOf(card))];
+        if (count > 0) {
+            count--;
+            unseenTotal--;
+        }
+    };
+    for (auto card : hand) {
+        see(card);
+    }
+    if (situation.topCard.IsValid()) {
+        see(situation.topCard);
+    }
+    if (unseenTotal <= 0) {
+        return;
+    }
+
+    CodeColor ownColor = HeadlessGame::mostFrequentColor(hand, situation.currentColor == CodeColor::WILD
+                                                                   ? CodeColor::RED : situation.currentColor);
+    for (auto face : STEAL_FACES) {
+        int count = unseen[static_cast<int>(face)];
+        if (count == 0) {
+            continue;
+        }
+        // 偷到的牌按自己最多的颜色估值，万能牌保持原样
+        CardCode sample = composition.samples[static_cast<int>(face)];
+        CardCode stolen = sample.IsWild() ? sample : sample.WithColor(ownColor);
+        rest.back() = stolen;
+        double gain = evaluateHand(rest, situation.topCard, situation.currentColor, situation.cardsNumToDraw) - current;
+        double share = static_cast<double>(count) / unseenTotal;
+
+        for (int target = 0; target < static_cast<int>(situation.handSizes.size()); target++) {
+            int size = situation.handSizes[target];
+            if (target == situation.self || size <= 0) {
+                continue;
+            }
+            // 对手至少有一张这类牌的概率
+            double chance = 1 - std::pow(1 - share, size);
+            SkillChoice choice;
+            choice.target = target;
+            choice.stealFace = face;
+            choice.score = chance * (gain + THREAT_WEIGHT / size * denialValue(face)) - KEEP_THIEF;
+            out.push_back(choice);
+        }
+    }
+}
+
+void SkillPolicy::rankCollector(const SkillSituation& situation, std::vector<SkillChoice>& out) {
+    std::vector<CardCode> hand = situation.hand;
+    double current = evaluateHand(hand, situation.topCard, situation.currentColor, situation.cardsNumToDraw);
+    hand.emplace_back();
+
+    // 相同的牌只估一次，取最上面的一张
+    std::array<bool, 256> seen{};
+    for (int index = static_cast<int>(situation.candidates.size()) - 1; index >= 0; index--) {
+        CardCode card = situation.candidates[index];
+        if (seen[card.ToByte()]) {
+            continue;
+        }
+        seen[card.ToByte()] = true;
+        hand.back() = card;
+        SkillChoice choice;
+        choice.cardIndex = index;
+        choice.score = evaluateHand(hand, situation.topCard, situation.currentColor, situation.cardsNumToDraw)
+            - current - KEEP_COLLECTOR;
+        out.push_back(choice);
+    }
+}
+
+void SkillPolicy::rankLuckyStar(const SkillSituation& situation, std::vector<SkillChoice>& out) {
+    const auto& candidates = situation.candidates;
+    int drawNum = std::max(situation.cardsNumToDraw, 1);
+    if (candidates.empty()) {
+        // 看不到抽牌堆时只算少抽的张数
+        SkillChoice choice;
+        choice.score = CARD_WEIGHT * (drawNum - 1) - KEEP_LUCKY_STAR;
+        out.push_back(choice);
+        return;
+    }
+
+    // 不发动时从顶部抽 drawNum 张，看不到的部分按每张一张手牌的代价算
+    std::vector<CardCode> hand = situation.hand;
+    int visible = std::min<int>(drawNum, static_cast<int>(candidates.size()));
+    hand.insert(hand.end(), candidates.begin(), candidates.begin() + visible);
+    double normal = evaluateHand(hand, situation.topCard, situation.currentColor, 1)
+        - CARD_WEIGHT * (drawNum - visible);
+
+    hand.resize(situation.hand.size() + 1);
+    for (int index = 0; index < static_cast<int>(candidates.size()); index++) {
+        hand.back() = candidates[index];
+        SkillChoice choice;
+        choice.cardIndex = index;
+        choice.score = evaluateHand(hand, situation.topCard, situation.currentColor, 1) - normal - KEEP_LUCKY_STAR;
+        out.push_back(choice);
+    }
+}
+
+} // namespace UNO
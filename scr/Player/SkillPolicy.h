@@ -0,0 +1,96 @@
+#pragma once
+#include <memory>
+#include <span>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "Player.h"
+#include "HeadlessGame.h"
+#include "common/card_code.h"
+
+namespace UNO {
+
+// 前向声明
+class GameState;
+
+/**
+ * 技能决策看到的局面，全部是单字节编码，由机器人从 GameState 取得
+ */
+struct SkillSituation {
+    std::vector<Common::CardCode> hand;
+    std::vector<int> handSizes;  // 按玩家，包括自己
+    int self = 0;
+    Common::CardCode topCard;
+    Common::CodeColor currentColor = Common::CodeColor::RED;
+    int cardsNumToDraw = 1;      // 本回合要抽的张数，叠加 +2、+4 后大于 1
+    // 收藏家是弃牌堆中顶牌以下的牌，幸运星发动后是抽牌堆顶部的牌（最上面的在前）；看不到时为空
+    std::vector<Common::CardCode> candidates;
+};
+
+/**
+ * 技能的一种用法和它的估值
+ */
+struct SkillChoice {
+    double score = 0;      // 相对不发动的估值增益
+    int target = -1;       // 小偷的目标
+    // 小偷要偷的牌类型，数字牌统一用 NUMBER_0
+    Common::CodeFace stealFace = Common::CodeFace::NUMBER_0;
+    int cardIndex = -1;    // 收藏家拿走、幸运星留下的牌在 candidates 中的位置，-1 表示不指定
+
+    HeadlessSkill toHeadlessSkill() const { return {target, stealFace == Common::CodeFace::NUMBER_0}; }
+};
+
+/**
+ * 机器人的技能策略：用手牌形状、对手的手牌张数和罚抽压力做快速估值，给出各角色技能的用法。
+ * 小偷在偷牌机会大、对手快赢时发动，优先偷对手出完牌要用的功能牌和万能牌；收藏家只拿对
+ * 自己明显有利的牌（比如被罚抽时能叠加的 +2、+4）；幸运星主要留给叠加的罚抽。
+ */
+class SkillPolicy {
+public:
+    /**
+     * 手牌的快速估值，越大越好：张数为主，颜色越集中、万能牌和功能牌越多越好，
+     * 被罚抽时能叠加的牌可以免掉这次罚抽
+     */
+    static double evaluateHand(std::span<const Common::CardCode> hand, Common::CardCode topCard,
+                               Common::CodeColor currentColor, int cardsNumToDraw);
+
+    /**
+     * 列出角色主动技能的用法，估值从高到低
+     */
+    static void rank(HeadlessCharacter character, const SkillSituation& situation, std::vector<SkillChoice>& out);
+
+    /**
+     * 估值最高的用法
+     * @return 没有比不发动更好的用法时返回 false
+     */
+    static bool choose(HeadlessCharacter character, const SkillSituation& situation, SkillChoice& out);
+
+    /**
+     * 从 GameState 和自己的手牌取得局面，收藏家同时取得弃牌堆中的候选牌。
+     * 幸运星发动前看不到抽牌堆，只按罚抽的张数决定是否发动
+     */
+    static SkillSituation observe(const GameState& gameState, int self, HeadlessCharacter character,
+                                  const std::vector<std::shared_ptr<Card>>& hand);
+
+    /**
+     * 幸运星发动后（次数已经扣掉）查看供选的抽牌堆顶部的牌，选出留下的一张
+     * @return 留下的牌在顶部牌中的位置，看不到时返回 -1
+     */
+    static int chooseKeptCard(const GameState& gameState, int self, const std::vector<std::shared_ptr<Card>>& hand);
+
+    /**
+     * 转换为 getSkillParameters 的参数：小偷是 targetPlayer 和 cardType（CardType），
+     * 收藏家和幸运星是 cardIndex
+     */
+    static nlohmann::json toParameters(HeadlessCharacter character, const SkillChoice& choice);
+
+    static HeadlessCharacter toHeadlessCharacter(CharacterType character);
+
+private:
+    constexpr static int LUCKY_STAR_VIEW_NUM = 3;  // 和 GameBoard::LUCKY_STAR_VIEW_NUM 一致
+
+    static void rankThief(const SkillSituation& situation, std::vector<SkillChoice>& out);
+    static void rankCollector(const SkillSituation& situation, std::vector<SkillChoice>& out);
+    static void rankLuckyStar(const SkillSituation& situation, std::vector<SkillChoice>& out);
+};
+
+} // namespace UNO
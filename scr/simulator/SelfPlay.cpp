@@ -0,0 +1,311 @@
+#include "SelfPlay.h"
+#include "Deck.h"
+#include "common/thread_pool.h"
+#include <algorithm>
+#include <iomanip>
+
+namespace UNO {
+
+using Common::CardCode;
+using Common::CodeColor;
+using Common::CodeFace;
+
+namespace {
+
+constexpr const char* CHARACTER_NAMES[] = {"Lucky Star", "Collector", "Thief", "Defender", "None"};
+
+uint64_t splitMix64(uint64_t z) {
+    z += 0x9e3779b97f4a7c15ULL;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+// 每批的种子由总种子和批次号混合得到，种子 s 的第 b + 1 批和种子 s + 1 的第 b 批互不相关
+uint64_t batchSeed(uint64_t seed, uint64_t batch) {
+    return splitMix64(splitMix64(seed) + batch);
+}
+
+// 需要选颜色的牌按手中最多的颜色选
+HeadlessMove withChosenColor(CardCode card, const std::vector<CardCode>& hand) {
+    if (card.IsWild() || card.GetFace() == CodeFace::PACKAGE) {
+        return {card, HeadlessGame::mostFrequentColor(hand)};
+    }
+    return {card, card.GetColor()};
+}
+
+class RandomPolicy : public BotPolicy {
+public:
+    HeadlessMove chooseMove(const HeadlessGame& game, Common::ShuffleRng& rng) override {
+        game.getLegalMoves(moves);
+        return moves[rng.Bounded(static_cast<uint32_t>(moves.size()))];
+    }
+
+    bool chooseSkill(const HeadlessGame& game, HeadlessSkill& skill, Common::ShuffleRng& rng) override {
+        int offset = 1 + static_cast<int>(rng.Bounded(game.getPlayerNum() - 1));
+        skill.target = (game.getCurrentPlayer() + offset) % game.getPlayerNum();
+        skill.stealNumber = rng.Bounded(2) == 0;
+        return true;
+    }
+
+private:
+    std::vector<HeadlessMove> moves;
+};
+
+class HeuristicPolicy : public BotPolicy {
+public:
+    HeadlessMove chooseMove(const HeadlessGame& game, Common::ShuffleRng& rng) override {
+        // 数字牌优先，其次有颜色的功能牌，万能牌留到最后，同类中随机
+        const auto& hand = game.getHand(game.getCurrentPlayer());
+        CardCode chosen;
+        int chosenRank = 3;
+        int candidateNum = 0;
+        for (auto card : hand) {
+            if (!game.canPlay(card)) {
+                continue;
+            }
+            int rank = card.IsWild() ? 2 : (card.GetNumber() >= 0 ? 0 : 1);
+            if (rank < chosenRank) {
+                chosenRank = rank;
+                candidateNum = 0;
+            }
+            if (rank == chosenRank && rng.Bounded(++candidateNum) == 0) {
+                chosen = card;
+            }
+        }
+        if (!chosen.IsValid()) {
+            return {};
+        }
+        return withChosenColor(chosen, hand);
+    }
+
+    bool chooseSkill(const HeadlessGame& game, HeadlessSkill& skill, Common::ShuffleRng&) override {
+        // 小偷偷手牌最少的对手的功能牌，收藏家能用就用
+        int self = game.getCurrentPlayer();
+        skill.target = -1;
+        for (int player = 0; player < game.getPlayerNum(); player++) {
+            if (player != self && (skill.target < 0
+                || game.getHand(player).size() < game.getHand(skill.target).size())) {
+                skill.target = player;
+            }
+        }
+        skill.stealNumber = false;
+        return true;
+    }
+};
+
+}
+
+PolicyFactory makePolicy(const std::string& name) {
+    if (name == "random") {
+        return [] { return std::make_unique<RandomPolicy>(); };
+    }
+    if (name == "heuristic") {
+        return [] { return std::make_unique<HeuristicPolicy>(); };
+    }
+    return nullptr;
+}
+
+void SimulationStats::add(const HeadlessGame& game, int winner, bool isCapped) {
+    int playerNum = game.getPlayerNum();
+    if (seatGames.size() < static_cast<size_t>(playerNum)) {
+        seatGames.resize(playerNum);
+        seatWins.resize(playerNum);
+    }
+    games++;
+    turns += game.getTurnCount();
+    cappedGames += isCapped;
+    for (int player = 0; player < playerNum; player++) {
+        int character = static_cast<int>(game.getCharacter(player));
+        characterGames[character]++;
+        characterWins[character] += (player == winner);
+        seatGames[player]++;
+        seatWins[player] += (player == winner);
+    }
+
+    const auto& counters = game.getCounters();
+    for (size_t i = 0; i < skillUses.size(); i++) {
+        skillUses[i] += counters.skillUses[i];
+    }
+    for (size_t i = 0; i < drawStacks.size(); i++) {
+        drawStacks[i] += counters.drawStacks[i];
+    }
+    size_t customBucket = std::min<size_t>(counters.customCardsPlayed, customCardGames.size() - 1);
+    customCardGames[customBucket]++;
+    customCardTurns[customBucket] += game.getTurnCount();
+}
+
+void SimulationStats::merge(const SimulationStats& other) {
+    games += other.games;
+    turns += other.turns;
+    cappedGames += other.cappedGames;
+    if (seatGames.size() < other.seatGames.size()) {
+        seatGames.resize(other.seatGames.size());
+        seatWins.resize(other.seatWins.size());
+    }
+    for (size_t i = 0; i < other.seatGames.size(); i++) {
+        seatGames[i] += other.seatGames[i];
+        seatWins[i] += other.seatWins[i];
+    }
+    for (size_t i = 0; i < characterGames.size(); i++) {
+        characterGames[i] += other.characterGames[i];
+        characterWins[i] += other.characterWins[i];
+    }
+    for (size_t i = 0; i < skillUses.size(); i++) {
+        skillUses[i] += other.skillUses[i];
+    }
+    for (size_t i = 0; i < drawStacks.size(); i++) {
+        drawStacks[i] += other.drawStacks[i];
+    }
+    for (size_t i = 0; i < customCardGames.size(); i++) {
+        customCardGames[i] += other.customCardGames[i];
+        customCardTurns[i] += other.customCardTurns[i];
+    }
+}
+
+void SimulationStats::writeCsv(std::ostream& os) const {
+    auto ratio = [](uint64_t part, uint64_t total) {
+        return total > 0 ? static_cast<double>(part) / total : 0.0;
+    };
+    os << std::fixed << std::setprecision(4);
+    os << "section,key,count,value\n";
+    os << "summary,games," << games << ",\n";
+    os << "summary,average_turns," << turns << "," << ratio(turns, games) << "\n";
+    os << "summary,capped_games," << cappedGames << "," << ratio(cappedGames, games) << "\n";
+
+    // 胜率和随机座位的期望胜率 1 / 人数比较
+    for (size_t character = 0; character < characterGames.size(); character++) {
+        if (characterGames[character] > 0) {
+            os << "character_win_rate," << CHARACTER_NAMES[character] << "," << characterGames[character]
+               << "," << ratio(characterWins[character], characterGames[character]) << "\n";
+        }
+    }
+    for (size_t seat = 0; seat < seatGames.size(); seat++) {
+        os << "seat_win_rate," << seat << "," << seatGames[seat] << "," << ratio(seatWins[seat], seatGames[seat]) << "\n";
+    }
+
+    // 每局平均发动次数，按拥有该角色的座位数计算
+    for (size_t character = 0; character < skillUses.size(); character++) {
+        if (characterGames[character] > 0) {
+            os << "skill_uses," << CHARACTER_NAMES[character] << "," << skillUses[character] << ","
+               << ratio(skillUses[character], characterGames[character]) << "\n";
+        }
+    }
+
+    uint64_t stackTotal = 0;
+    for (auto count : drawStacks) {
+        stackTotal += count;
+    }
+    for (size_t size = 0; size < drawStacks.size(); size++) {
+        if (drawStacks[size] > 0) {
+            os << "draw_stack," << size << (size == drawStacks.size() - 1 ? "+" : "") << ","
+               << drawStacks[size] << "," << ratio(drawStacks[size], stackTotal) << "\n";
+        }
+    }
+
+    // 自定义牌对牌局长度的影响：按打出的张数分组的平均回合数
+    for (size_t played = 0; played < customCardGames.size(); played++) {
+        if (customCardGames[played] > 0) {
+            os << "custom_cards_played," << played << (played == customCardGames.size() - 1 ? "+" : "") << ","
+               << customCardGames[played] << "," << ratio(customCardTurns[played], customCardGames[played]) << "\n";
+        }
+    }
+}
+
+SelfPlaySimulator::SelfPlaySimulator(const SimulatorConfig& config, PolicyFactory policyFactory)
+    : config(config), policyFactory(std::move(policyFactory)) {
+    int deckNum = config.deckNum > 0 ? config.deckNum : (config.playerNum + 7) / 8;
+    for (int deck = 0; deck < deckNum; deck++) {
+        for (auto code : Deck::getStandardDeck()) {
+            bool isCustom = code.GetFace() == CodeFace::PACKAGE || code.GetFace() == CodeFace::FLASH;
+            if (config.withCustomCards || !isCustom) {
+                shoe.push_back(code);
+            }
+        }
+    }
+}
+
+SimulationStats SelfPlaySimulator::run() {
+    uint64_t batchNum = (config.gameNum + BATCH_SIZE - 1) / BATCH_SIZE;
+    std::vector<SimulationStats> batchStats(batchNum);
+    {
+        Common::ThreadPool pool(config.threadNum);
+        for (uint64_t batch = 0; batch < batchNum; batch++) {
+            pool.Submit([this, batch, &batchStats] { playBatch(batch, batchStats[batch]); });
+        }
+        pool.Wait();
+    }
+
+    SimulationStats total;
+    for (const auto& stats : batchStats) {
+        total.merge(stats);
+    }
+    return total;
+}
+
+void SelfPlaySimulator::playBatch(uint64_t batch, SimulationStats& stats) const {
+    // 每批有自己的种子，结果和线程数、执行顺序无关
+    Common::ShuffleRng rng(batchSeed(config.seed, batch));
+    auto policy = policyFactory();
+    std::vector<BotPolicy*> seatPolicies(config.playerNum, policy.get());
+    std::vector<CardCode> pile;
+
+    uint64_t first = batch * BATCH_SIZE;
+    uint64_t last = std::min(config.gameNum, first + BATCH_SIZE);
+    for (uint64_t index = first; index < last; index++) {
+        HeadlessGame game(config.playerNum);
+        game.setDrawStacking(config.drawStacking);
+        for (int player = 0; player < config.playerNum; player++) {
+            game.setCharacter(player, config.withCharacters
+                ? static_cast<HeadlessCharacter>(rng.Bounded(4)) : HeadlessCharacter::NONE);
+        }
+        int winner = playGame(game, seatPolicies, pile, rng);
+        stats.add(game, winner, !game.isOver());
+    }
+}
+
+int SelfPlaySimulator::playGame(HeadlessGame& game, const std::vector<BotPolicy*>& seatPolicies,
+                                std::vector<CardCode>& pile, Common::ShuffleRng& rng) const {
+    deal(game, pile, rng);
+
+    while (!game.isOver() && game.getTurnCount() < config.maxTurns) {
+        BotPolicy* policy = seatPolicies[game.getCurrentPlayer()];
+        HeadlessSkill skill;
+        if (game.canUseSkill() && policy->chooseSkill(game, skill, rng)) {
+            game.useSkill(skill, rng);
+        }
+        game.apply(policy->chooseMove(game, rng), rng);
+    }
+
+    if (game.isOver()) {
+        return game.getWinner();
+    }
+    int winner = 0;
+    for (int player = 1; player < game.getPlayerNum(); player++) {
+        if (game.getHand(player).size() < game.getHand(winner).size()) {
+            winner = player;
+        }
+    }
+    return winner;
+}
+
+void SelfPlaySimulator::deal(HeadlessGame& game, std::vector<CardCode>& pile, Common::ShuffleRng& rng) const {
+    pile.assign(shoe.begin(), shoe.end());
+    Common::Shuffle(std::span(pile), rng);
+    for (int player = 0; player < game.getPlayerNum(); player++) {
+        game.getHand(player).assign(pile.end() - config.initHandCardsNum, pile.end());
+        pile.resize(pile.size() - config.initHandCardsNum);
+    }
+
+    // 第一张数字牌翻开作为顶牌，上面的牌留在抽牌堆；全是功能牌时直接翻开顶牌
+    auto top = std::find_if(pile.rbegin(), pile.rend(), [](CardCode code) { return code.GetNumber() >= 0; });
+    if (top != pile.rend()) {
+        std::iter_swap(top, pile.rbegin());
+    }
+    CardCode topCard = pile.back();
+    pile.pop_back();
+    game.setTop(topCard, topCard.IsWild() ? CodeColor::RED : topCard.GetColor());
+    game.getDrawPile().assign(pile.begin(), pile.end());
+}
+
+} // namespace UNO
@@ -0,0 +1,118 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "HeadlessGame.h"
+
+namespace UNO {
+
+/**
+ * 自对弈中机器人的决策，每个工作线程各有一个实例，所以实现可以保存可变的缓冲区
+ */
+class BotPolicy {
+public:
+    virtual ~BotPolicy() = default;
+
+    /**
+     * 当前玩家的行动，必须是 getLegalMoves 中的一步
+     */
+    virtual HeadlessMove chooseMove(const HeadlessGame& game, Common::ShuffleRng& rng) = 0;
+
+    /**
+     * 当前玩家能发动主动技能时调用
+     * @return 是否发动，发动时填好 skill
+     */
+    virtual bool chooseSkill(const HeadlessGame& game, HeadlessSkill& skill, Common::ShuffleRng& rng) = 0;
+};
+
+using PolicyFactory = std::function<std::unique_ptr<BotPolicy>()>;
+
+/**
+ * 按名字创建内置策略："random" 在合法行动中均匀随机、能发动技能就发动；
+ * "heuristic" 和 AIPlayer 一样优先出数字牌，万能牌留到最后，偷手牌最少的对手的功能牌
+ * @return 名字未知时返回空
+ */
+PolicyFactory makePolicy(const std::string& name);
+
+struct SimulatorConfig {
+    uint64_t gameNum = 1000000;
+    int playerNum = 4;
+    int deckNum = 0;               // 0 表示和服务器默认一样每 8 人一副
+    int initHandCardsNum = 7;
+    int maxTurns = 1000;           // 超过后手牌最少的玩家获胜，记为未完成的牌局
+    bool withCharacters = true;    // 每个座位随机分配角色
+    bool withCustomCards = true;   // 牌组中包含 Package 和 Flash
+    bool drawStacking = true;      // +2、+4 和服务器一样叠加
+    int threadNum = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));  // 无法检测时为 0，至少用一个线程
+    uint64_t seed = 1;
+};
+
+/**
+ * 自对弈的汇总统计。每批牌局各自计数，结束后按批次顺序合并，所以结果只取决于种子
+ */
+struct SimulationStats {
+    uint64_t games = 0;
+    uint64_t turns = 0;
+    uint64_t cappedGames = 0;
+    std::array<uint64_t, 5> characterGames{};  // 按 HeadlessCharacter，最后一项是没有角色
+    std::array<uint64_t, 5> characterWins{};
+    std::vector<uint64_t> seatGames;  // 座位按出牌顺序，0 先出
+    std::vector<uint64_t> seatWins;
+    std::array<uint64_t, 4> skillUses{};
+    std::array<uint64_t, HeadlessGame::MAX_DRAW_STACK + 1> drawStacks{};
+    // 按一局中打出的 Package 和 Flash 张数（0、1、2、3 张及以上）分组的局数和回合数
+    std::array<uint64_t, 4> customCardGames{};
+    std::array<uint64_t, 4> customCardTurns{};
+
+    void add(const HeadlessGame& game, int winner, bool isCapped);
+    void merge(const SimulationStats& other);
+
+    /**
+     * 输出 CSV 报告，每行是 section,key,count,value
+     */
+    void writeCsv(std::ostream& os) const;
+};
+
+/**
+ * 在所有核心上批量进行机器人对局，只用 HeadlessGame，不需要网络和终端
+ */
+class SelfPlaySimulator {
+public:
+    SelfPlaySimulator(const SimulatorConfig& config, PolicyFactory policyFactory);
+
+    SimulationStats run();
+
+    /**
+     * 发牌并把一局下完，每个座位用 seatPolicies 中对应的策略，角色要事先设置好
+     * @param pile 发牌用的缓冲区，多局之间可以重复使用
+     * @return 获胜的座位，超过回合上限时是手牌最少的座位
+     */
+    int playGame(HeadlessGame& game, const std::vector<BotPolicy*>& seatPolicies,
+                 std::vector<Common::CardCode>& pile, Common::ShuffleRng& rng) const;
+
+    const SimulatorConfig& getConfig() const { return config; }
+    size_t getShoeSize() const { return shoe.size(); }
+
+private:
+    void playBatch(uint64_t batch, SimulationStats& stats) const;
+
+    /**
+     * 从洗好的牌靴发牌并翻出第一张数字牌作为顶牌
+     */
+    void deal(HeadlessGame& game, std::vector<Common::CardCode>& pile, Common::ShuffleRng& rng) const;
+
+private:
+    constexpr static uint64_t BATCH_SIZE = 4096;
+
+    const SimulatorConfig config;
+    const PolicyFactory policyFactory;
+    std::vector<Common::CardCode> shoe;
+};
+
+} // namespace UNO
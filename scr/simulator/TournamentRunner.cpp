@@ -0,0 +1,52 @@
+#include "TournamentRunner.h"
+#include "tournament.h"
+#include <algorithm>
+#include <numeric>
+
+namespace UNO {
+
+HeadlessMatchRunner::HeadlessMatchRunner(const SelfPlaySimulator& simulator, std::vector<PolicyFactory> entrants)
+    : simulator(&simulator), entrants(std::move(entrants)) {}
+
+void HeadlessMatchRunner::operator()(Game::Match& match) const {
+    int seatNum = static_cast<int>(match.mSeats.size());
+    Common::ShuffleRng rng(match.mSeed);
+
+    std::vector<std::unique_ptr<BotPolicy>> policies;
+    std::vector<BotPolicy*> seatPolicies;
+    for (int entrant : match.mSeats) {
+        policies.push_back(entrants[entrant]());
+        seatPolicies.push_back(policies.back().get());
+    }
+
+    HeadlessGame game(seatNum);
+    game.setDrawStacking(simulator->getConfig().drawStacking);
+    match.mCharacters.clear();
+    if (simulator->getConfig().withCharacters) {
+        // HeadlessCharacter 和 Game::CharacterType 的顺序一致
+        for (int seat = 0; seat < seatNum; seat++) {
+            auto character = static_cast<HeadlessCharacter>(rng.Bounded(4));
+            game.setCharacter(seat, character);
+            match.mCharacters.push_back(static_cast<Game::CharacterType>(character));
+        }
+    }
+
+    std::vector<Common::CardCode> pile;
+    int winner = simulator->playGame(game, seatPolicies, pile, rng);
+
+    std::vector<int> order(seatNum);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&game, winner](int lhs, int rhs) {
+        if ((lhs == winner) != (rhs == winner)) {
+            return lhs == winner;
+        }
+        return game.getHand(lhs).size() < game.getHand(rhs).size();
+    });
+    match.mPlaces.assign(seatNum, 0);
+    for (int place = 0; place < seatNum; place++) {
+        match.mPlaces[order[place]] = place;
+    }
+    match.mTurns = game.getTurnCount();
+}
+
+} // namespace UNO
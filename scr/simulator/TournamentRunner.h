@@ -0,0 +1,34 @@
+#pragma once
+#include <vector>
+#include "SelfPlay.h"
+
+namespace UNO {
+
+namespace Game {
+struct Match;
+}
+
+/**
+ * 在 HeadlessGame 上进行锦标赛对局的执行器，可以直接作为 Game::MatchRunner 交给 Game::Tournament。
+ * 每个参赛者是一个策略，牌组、手牌数、角色、叠加和回合上限取自模拟器的配置，每局的人数由座位决定。
+ * 名次：获胜者第一，其余按剩余手牌数从少到多，张数相同时座位靠前的在前
+ */
+class HeadlessMatchRunner {
+public:
+    /**
+     * @param simulator 用来发牌和下完一局，要比锦标赛活得久
+     * @param entrants 每个参赛者的策略，下标和锦标赛的名单一致
+     */
+    HeadlessMatchRunner(const SelfPlaySimulator& simulator, std::vector<PolicyFactory> entrants);
+
+    /**
+     * 按 match.mSeed 下完一局并填写名次、角色和回合数。各局之间不共享可变状态，可以在多个线程中同时调用
+     */
+    void operator()(Game::Match& match) const;
+
+private:
+    const SelfPlaySimulator* simulator;
+    std::vector<PolicyFactory> entrants;
+};
+
+} // namespace UNO
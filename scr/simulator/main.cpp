@@ -0,0 +1,109 @@
+// 角色和自定义牌的平衡性统计：批量进行机器人对局并输出 CSV 报告
+// selfplay [--games N] [--players N] [--decks N] [--hand N] [--threads N] [--seed N]
+//          [--policy random|heuristic] [--max-turns N] [--no-characters] [--no-custom]
+//          [--no-stacking] [--output FILE]
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include "SelfPlay.h"
+
+namespace {
+
+void printUsage() {
+    std::fprintf(stderr,
+        "usage: selfplay [--games N] [--players N] [--decks N] [--hand N] [--threads N] [--seed N]\n"
+        "                [--policy random|heuristic] [--max-turns N] [--no-characters] [--no-custom]\n"
+        "                [--no-stacking] [--output FILE]\n");
+}
+
+}
+
+int main(int argc, char** argv) {
+    UNO::SimulatorConfig config;
+    std::string policyName = "heuristic";
+    std::string output;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--no-characters") {
+            config.withCharacters = false;
+        }
+        else if (arg == "--no-custom") {
+            config.withCustomCards = false;
+        }
+        else if (arg == "--no-stacking") {
+            config.drawStacking = false;
+        }
+        else if (arg == "--games" && hasValue) {
+            config.gameNum = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (arg == "--players" && hasValue) {
+            config.playerNum = std::atoi(argv[++i]);
+        }
+        else if (arg == "--decks" && hasValue) {
+            config.deckNum = std::atoi(argv[++i]);
+        }
+        else if (arg == "--hand" && hasValue) {
+            config.initHandCardsNum = std::atoi(argv[++i]);
+        }
+        else if (arg == "--threads" && hasValue) {
+            config.threadNum = std::atoi(argv[++i]);
+        }
+        else if (arg == "--seed" && hasValue) {
+            config.seed = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (arg == "--max-turns" && hasValue) {
+            config.maxTurns = std::atoi(argv[++i]);
+        }
+        else if (arg == "--policy" && hasValue) {
+            policyName = argv[++i];
+        }
+        else if (arg == "--output" && hasValue) {
+            output = argv[++i];
+        }
+        else {
+            printUsage();
+            return 1;
+        }
+    }
+
+    auto policyFactory = UNO::makePolicy(policyName);
+    if (!policyFactory) {
+        std::fprintf(stderr, "unknown policy: %s\n", policyName.c_str());
+        return 1;
+    }
+    if (config.playerNum < 2 || config.initHandCardsNum < 1 || config.threadNum < 1) {
+        printUsage();
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    UNO::SelfPlaySimulator simulator(config, policyFactory);
+    // 发完初始手牌后至少还要剩下一张牌翻开
+    if (static_cast<size_t>(config.playerNum * config.initHandCardsNum) >= simulator.getShoeSize()) {
+        std::fprintf(stderr, "too few cards for %d players with %d cards each\n",
+            config.playerNum, config.initHandCardsNum);
+        return 1;
+    }
+    UNO::SimulationStats stats = simulator.run();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::fprintf(stderr, "%llu games in %.1f s (%.0f games/s)\n",
+        static_cast<unsigned long long>(stats.games), seconds, stats.games / seconds);
+
+    if (output.empty()) {
+        stats.writeCsv(std::cout);
+    }
+    else {
+        std::ofstream file(output);
+        if (!file) {
+            std::fprintf(stderr, "cannot open %s\n", output.c_str());
+            return 1;
+        }
+        stats.writeCsv(file);
+    }
+    return 0;
+}
@@ -4,6 +4,7 @@
 #include <windows.h>
 #include <algorithm>
 #include <random> 
+#include "../CoreFunction/common/shuffle.h"
 
 UnoUI::UnoUI() : selectedCardIndex(0), gameRunning(true), currentPlayerIndex(0), 
                   needsRedraw(true), defenderRevealed(false) {
@@ -22,8 +23,8 @@ UnoUI::UnoUI() : selectedCardIndex(0), gameRunning(true), currentPlayerIndex(0),
     // Initialize characters with proper skill tracking
     playerCharacters = {"Lucky Star", "Collector", "Thief", "Defender"};
     std::random_device rd;
-    std::mt19937 g(rd());
-    std::shuffle(playerCharacters.begin(), playerCharacters.end(), g);
+    UNO::Common::ShuffleRng rng(rd());
+    UNO::Common::Shuffle(std::span(playerCharacters), rng);
 
     // Initialize skill states
     skillAvailable.resize(4, true);
@@ -0,0 +1,52 @@
+// 洗牌性能对比：std::shuffle + std::mt19937 与 Common::Shuffle + ShuffleRng。
+// 独立的可执行程序，不依赖测试框架：bench_shuffle [每种牌堆大小的洗牌次数]
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <numeric>
+#include <random>
+#include <vector>
+#include "common/shuffle.h"
+
+namespace {
+
+template <typename ShuffleFn>
+double nanosPerShuffle(std::vector<uint8_t>& cards, int rounds, ShuffleFn shuffle) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < rounds; i++) {
+        shuffle(cards);
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / rounds;
+}
+
+}
+
+int main(int argc, char** argv) {
+    int rounds = argc > 1 ? std::atoi(argv[1]) : 200000;
+    std::printf("%8s %16s %16s %8s\n", "cards", "std::shuffle ns", "Shuffle ns", "speedup");
+
+    // 单副牌、双副牌以及大牌桌的多副牌靴
+    for (int cardNum : {108, 118, 236, 472, 1180}) {
+        std::vector<uint8_t> cards(cardNum);
+        std::iota(cards.begin(), cards.end(), 0);
+
+        std::mt19937 engine(1);
+        double standard = nanosPerShuffle(cards, rounds, [&](std::vector<uint8_t>& pile) {
+            std::shuffle(pile.begin(), pile.end(), engine);
+        });
+
+        UNO::Common::ShuffleRng rng(1);
+        double kernel = nanosPerShuffle(cards, rounds, [&](std::vector<uint8_t>& pile) {
+            UNO::Common::Shuffle(std::span(pile), rng);
+        });
+
+        // 防止编译器把洗牌当作无用代码去掉
+        volatile uint8_t sink = cards[0];
+        (void)sink;
+        std::printf("%8d %16.1f %16.1f %7.2fx\n", cardNum, standard, kernel, standard / kernel);
+    }
+    return 0;
+}
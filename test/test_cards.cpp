@@ -2,14 +2,25 @@
 #include <memory>
 #include "Card.h"
 #include "FunctionCard.h"
+#include "CardEffects.h"
+#include "CardEvents.h"
+#include "CardPrototypes.h"
+#include "GameState.h"
+
+namespace {
+// Card 是抽象类，数字牌取共享的原型
+std::shared_ptr<UNO::Card> numberCardOf(UNO::Common::CodeColor color, UNO::Common::CodeFace face) {
+    return UNO::CardPrototypes::share(UNO::Common::CardCode(color, face));
+}
+}
 
 // 简单的测试用 GameState 实现
 class TestGameState : public UNO::GameState {
 public:
     std::shared_ptr<UNO::Card> getTopCard() const override { 
-        return std::make_shared<UNO::Card>(UNO::CardData(1, UNO::CardColor::RED, UNO::CardType::NUMBER, 5));
+        return numberCardOf(UNO::Common::CodeColor::RED, UNO::Common::CodeFace::NUMBER_5);
     }
-    CardColor getCurrentColor() const override { return UNO::CardColor::RED; }
+    UNO::CardColor getCurrentColor() const override { return UNO::CardColor::RED; }
     int getCurrentPlayer() const override { return 0; }
     int getNextPlayerId() const override { return 1; }
     int getPlayerCount() const override { return 2; }
@@ -17,24 +28,22 @@ public:
     void makePlayerDrawCards(int playerId, int count) override {}
     void skipPlayerTurn(int playerId) override {}
     void reversePlayDirection() override {}
-    void setCurrentColor(CardColor color) override {}
-    void setFlashEffect(CardColor color, int playerId) override {}
+    void setCurrentColor(UNO::CardColor color) override {}
+    void setFlashEffect(UNO::CardColor color, int playerId) override {}
     void clearFlashEffect() override {}
     bool isFlashEffectActive() const override { return false; }
-    CardColor getFlashEffectColor() const override { return UNO::CardColor::RED; }
+    UNO::CardColor getFlashEffectColor() const override { return UNO::CardColor::RED; }
     std::vector<UNO::CardData> getPlayerHand(int playerId) const override { return {}; }
     void discardPlayerCard(int playerId, int cardId) override {}
-    void notifyCardEffect(const std::string& effect, const nlohmann::json& data) override {}
     bool validateWildDrawFour(int playerId) const override { return true; }
     bool isSkillPhase() const override { return false; }
     bool isCardPlayPhase() const override { return true; }
-    std::vector<std::shared_ptr<UNO::Card>> getPlayerHandCards(int playerId) const override { return {}; }
 };
 
 class CardTest : public ::testing::Test {
 protected:
     void SetUp() override {
-        numberCard = std::make_shared<UNO::Card>(UNO::CardData(1, UNO::CardColor::RED, UNO::CardType::NUMBER, 5));
+        numberCard = numberCardOf(UNO::Common::CodeColor::RED, UNO::Common::CodeFace::NUMBER_5);
         skipCard = std::make_shared<UNO::SkipCard>(2, UNO::CardColor::BLUE);
         wildCard = std::make_shared<UNO::WildCard>(3);
         gameState = std::make_shared<TestGameState>();
@@ -60,12 +69,12 @@ TEST_F(CardTest, FunctionCardCreation) {
 }
 
 TEST_F(CardTest, CardMatching) {
-    auto redSeven = std::make_shared<UNO::Card>(UNO::CardData(4, UNO::CardColor::RED, UNO::CardType::NUMBER, 7));
+    auto redSeven = numberCardOf(UNO::Common::CodeColor::RED, UNO::Common::CodeFace::NUMBER_7);
     
     // 相同颜色应该匹配
     EXPECT_TRUE(numberCard->canPlayOn(redSeven.get()));
     
-    auto blueFive = std::make_shared<UNO::Card>(UNO::CardData(5, UNO::CardColor::BLUE, UNO::CardType::NUMBER, 5));
+    auto blueFive = numberCardOf(UNO::Common::CodeColor::BLUE, UNO::Common::CodeFace::NUMBER_5);
     
     // 相同数字应该匹配
     EXPECT_TRUE(numberCard->canPlayOn(blueFive.get()));
@@ -109,3 +118,40 @@ TEST_F(CardTest, FlashCardCreation) {
     EXPECT_EQ(flashCard->getType(), UNO::CardType::FLASH);
     EXPECT_TRUE(flashCard->requiresParameters());
 }
+
+TEST_F(CardTest, EffectParamsDecodedOnce) {
+    UNO::EffectParams params;
+    EXPECT_TRUE(UNO::CardEffects::decode(UNO::CardType::WILD, {{"color", 2}}, params));
+    EXPECT_EQ(params.color, UNO::CardColor::GREEN);
+    EXPECT_FALSE(UNO::CardEffects::decode(UNO::CardType::FLASH, {{"color", 4}}, params));
+    EXPECT_FALSE(UNO::CardEffects::decode(UNO::CardType::PACKAGE, {}, params));
+    // 不需要颜色的卡牌不校验颜色
+    EXPECT_TRUE(UNO::CardEffects::decode(UNO::CardType::SKIP, {}, params));
+}
+
+TEST_F(CardTest, TypedEffectDispatch) {
+    UNO::EffectParams params;
+    params.color = UNO::CardColor::BLUE;
+    EXPECT_TRUE(UNO::CardEffects::validate(UNO::CardType::WILD, params));
+    EXPECT_NO_THROW(UNO::CardEffects::apply(UNO::CardType::WILD, *gameState, 0, params));
+    EXPECT_NO_THROW(UNO::CardEffects::apply(UNO::CardType::DRAW_TWO, *gameState, 0, params));
+}
+
+TEST_F(CardTest, EffectsPublishTypedEvents) {
+    struct Recorder {
+        std::vector<UNO::CardEvent> events;
+        void onCardEvent(const UNO::CardEvent& event) { events.push_back(event); }
+    } recorder;
+    ASSERT_TRUE(gameState->getEventBus().subscribe<&Recorder::onCardEvent>(&recorder));
+    
+    UNO::EffectParams params;
+    UNO::CardEffects::apply(UNO::CardType::DRAW_TWO, *gameState, 0, params);
+    // 事件先缓冲，分发后才交给订阅者
+    EXPECT_TRUE(recorder.events.empty());
+    gameState->getEventBus().flush();
+    
+    ASSERT_EQ(recorder.events.size(), 1u);
+    EXPECT_EQ(recorder.events[0].kind, UNO::CardEventKind::DRAW_TWO);
+    EXPECT_EQ(recorder.events[0].targetPlayer, 1);
+    EXPECT_EQ(recorder.events[0].count, 2);
+}
@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#include "game_board.h"
+#include "indexed_discard_pile.h"
+#include "table_image.h"
+#include "GameState.h"
+#include "common/config.h"
+
+using namespace UNO;
+using Game::GameBoard;
+using Game::Info;
+using Game::JoinGameInfo;
+
+namespace {
+// 不监听端口的服务器，牌桌只在构造时注册回调
+class IdleServer : public Network::IServer {
+public:
+    void Run() override {}
+    void Close() override {}
+    void Reset() override {}
+    void RegisterReceiveJoinGameInfoCallback(const std::function<void(int, const JoinGameInfo &)> &) override {}
+    void RegisterAllPlayersJoinedCallback(const std::function<void()> &) override {}
+    void SetPlayerNum(int) override {}
+    std::unique_ptr<Info> ReceiveInfo(const std::type_info *, int) override { return nullptr; }
+    void DeliverInfo(const std::type_info *, int, const Info &) override {}
+    asio::awaitable<std::unique_ptr<Info>> AsyncReceiveInfo(const std::type_info *, int,
+        std::chrono::steady_clock::duration) override { co_return nullptr; }
+    asio::any_io_executor GetExecutor() override { return mContext.get_executor(); }
+
+private:
+    asio::io_context mContext;
+};
+
+// 按命令行解析配置，和服务器启动时一样用解析出的模式建牌桌
+std::unique_ptr<GameBoard> boardFor(const std::string &mode) {
+    const char *argv[] = {"uno", "-l", "9091", "-m", mode.c_str()};
+    Common::Config config(5, argv);
+    auto configInfo = config.Parse();
+    return std::make_unique<GameBoard>(std::make_shared<IdleServer>(), configInfo->mGameMode);
+}
+
+// 两人牌桌的镜像：0 号是幸运星，轮到 0 号；抽牌堆从顶部起依次是 deck
+void writeTable(const std::string &path, const std::vector<Game::Card> &deck) {
+    std::vector<Game::Card> discardPile{{Game::CardColor::RED, Game::CardText::NUMBER_5}};
+    std::vector<uint8_t> image(Game::TableImage::SizeOf(2, deck.size(), discardPile.size()));
+
+    Game::TableImageHeader header{};
+    header.mMagic = Game::TableImage::MAGIC;
+    header.mVersion = Game::TableImage::VERSION;
+    header.mHeaderSize = sizeof(header);
+    header.mTotalSize = image.size();
+    header.mDeckSize = deck.size();
+    header.mDiscardPileSize = discardPile.size();
+    header.mSeatNum = 2;
+    header.mCurrentPlayer = 0;
+    header.mFlags = Game::TableImageHeader::FLAG_CLOCKWISE;
+    header.mLastPlayedCard = Game::PackedCard::Pack(discardPile.back());
+    header.mCardsNumToDraw = 1;
+    header.mPackagePlayerIndex = -1;
+    uint8_t *cursor = image.data();
+    std::memcpy(cursor, &header, sizeof(header));
+    cursor += sizeof(header);
+
+    for (int i = 0; i < 2; i++) {
+        Game::TableImageSeat seat{};
+        std::strcpy(seat.mUsername, i == 0 ? "lucky" : "other");
+        seat.mRemainingHandCardsNum = 7;
+        seat.mCharacterType = static_cast<uint8_t>(i == 0 ? Game::CharacterType::LUCKY_STAR : Game::CharacterType::NONE);
+        if (i == 0) {
+            seat.mFlags = Game::TableImageSeat::FLAG_HAS_CHARACTER;
+            seat.mUsesRemaining = 3;
+        }
+        std::memcpy(cursor, &seat, sizeof(seat));
+        cursor += sizeof(seat);
+    }
+    for (auto card : deck) {
+        *cursor++ = Game::PackedCard::Pack(card).mCode;
+    }
+    for (auto card : discardPile) {
+        *cursor++ = Game::PackedCard::Pack(card).mCode;
+    }
+    std::ofstream(path, std::ios::binary).write(reinterpret_cast<const char *>(image.data()), image.size());
+}
+}
+
+TEST(GameBoardTest, ModeOptionSelectsTheRulesPolicy) {
+    auto classic = boardFor("classic");
+    EXPECT_TRUE(classic->PlaysWith<Game::ClassicRules>());
+    EXPECT_FALSE(classic->PlaysWith<Game::CharacterRules>());
+
+    EXPECT_TRUE(boardFor("characters")->PlaysWith<Game::CharacterRules>());
+    EXPECT_TRUE(boardFor("custom")->PlaysWith<Game::CustomRules>());
+}
+
+TEST(GameBoardTest, LuckyStarSeesOnlyTheOfferedCards) {
+    std::vector<Game::Card> deck{{Game::CardColor::RED, Game::CardText::NUMBER_1}, {Game::CardColor::GREEN, Game::CardText::NUMBER_2},
+        {Game::CardColor::BLUE, Game::CardText::NUMBER_3}, {Game::CardColor::YELLOW, Game::CardText::NUMBER_4}};
+    std::string path = ::testing::TempDir() + "lucky_star.table";
+    writeTable(path, deck);
+    auto board = boardFor("characters");
+    ASSERT_TRUE(board->RestoreTable(path));
+    GameBoardAdapter adapter(board.get());
+
+    // 发动之前看不到抽牌堆
+    EXPECT_TRUE(adapter.peekDrawPile(3).empty());
+
+    // 看到的正是供选的顶部三张，没有哪一张已经被拿走
+    const auto &offer = board->OfferLuckyStar(0);
+    ASSERT_EQ(offer.size(), 3u);
+    auto seen = adapter.peekDrawPile(3);
+    ASSERT_EQ(seen.size(), 3u);
+    for (int i = 0; i < 3; i++) {
+        EXPECT_EQ(seen[i].toCode(), Game::ToCode(deck[i]));
+    }
+    EXPECT_EQ(board->GetPlayerStats()[0].GetCharacter()->GetUsesRemaining(), 2);
+
+    // 选完就收回，其余两张按原顺序留在顶部
+    board->TakeLuckyStarCard(1);
+    EXPECT_TRUE(adapter.peekDrawPile(3).empty());
+    EXPECT_EQ(board->GetPlayerStats()[0].GetRemainingHandCardsNum(), 8);
+    const auto &pile = board->GetDeck()->GetPile();
+    ASSERT_EQ(pile.size(), 3u);
+    EXPECT_EQ(pile[0], deck[0]);
+    EXPECT_EQ(pile[1], deck[2]);
+    EXPECT_EQ(pile[2], deck[3]);
+}
+
+TEST(IndexedDiscardPileTest, TakeTwiceKeepsTheOrder) {
+    using Game::CardColor;
+    using Game::CardText;
+    Game::IndexedDiscardPile pile;
+    std::vector<Game::Card> cards{{CardColor::RED, CardText::NUMBER_1}, {CardColor::BLUE, CardText::SKIP},
+        {CardColor::RED, CardText::NUMBER_1}, {CardColor::GREEN, CardText::NUMBER_2},
+        {CardColor::BLUE, CardText::SKIP}, {CardColor::YELLOW, CardText::NUMBER_3}};
+    for (const auto &card : cards) {
+        pile.Add(card);
+    }
+
+    // 连续拿走两张，其余的牌保持原来的顺序
+    ASSERT_EQ(pile.Find(CardColor::RED, CardText::NUMBER_1), 2);
+    EXPECT_EQ(pile.TakeAt(2), cards[2]);
+    ASSERT_EQ(pile.Find(CardColor::BLUE, CardText::SKIP), 3);
+    EXPECT_EQ(pile.TakeAt(3), cards[4]);
+    std::vector<Game::Card> rest(pile.GetPile().begin(), pile.GetPile().end());
+    EXPECT_EQ(rest, (std::vector<Game::Card>{cards[0], cards[1], cards[3], cards[5]}));
+
+    // 索引跟着更新：找到的仍是同种牌中最晚放下的一张
+    EXPECT_EQ(pile.Count(CardColor::RED, CardText::NUMBER_1), 1);
+    EXPECT_EQ(pile.Find(CardColor::RED, CardText::NUMBER_1), 0);
+    EXPECT_EQ(pile.Find(CardColor::BLUE, CardText::SKIP), 1);
+    EXPECT_EQ(pile.Find(CardColor::GREEN, CardText::NUMBER_2), 2);
+    EXPECT_EQ(pile.Find(CardColor::YELLOW, CardText::NUMBER_3), -1);  // 顶牌不能拿
+}
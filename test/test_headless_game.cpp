@@ -0,0 +1,213 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include "HeadlessGame.h"
+#include "OpponentBelief.h"
+
+using namespace UNO;
+using Common::CardCode;
+using Common::CodeColor;
+using Common::CodeFace;
+
+namespace {
+CardCode code(CodeColor color, CodeFace face) { return CardCode(color, face); }
+}
+
+TEST(HeadlessGameTest, LegalMovesExpandChosenColors) {
+    HeadlessGame game(2);
+    game.getHand(0) = {
+        code(CodeColor::RED, CodeFace::NUMBER_5),
+        code(CodeColor::RED, CodeFace::NUMBER_5),
+        code(CodeColor::BLUE, CodeFace::NUMBER_3),
+        code(CodeColor::GREEN, CodeFace::NUMBER_1),
+        code(CodeColor::WILD, CodeFace::WILD),
+    };
+    game.setTop(code(CodeColor::RED, CodeFace::NUMBER_3), CodeColor::RED);
+
+    std::vector<HeadlessMove> moves;
+    game.getLegalMoves(moves);
+    // 两张红 5 只算一步，蓝 3 同数字，万能牌展开为四种颜色
+    EXPECT_EQ(moves.size(), 6u);
+    EXPECT_EQ(std::count_if(moves.begin(), moves.end(), [](const HeadlessMove& move) {
+        return move.card.GetFace() == CodeFace::WILD;
+    }), 4);
+
+    // 没有能出的牌时只能抽牌
+    game.getHand(0) = {code(CodeColor::GREEN, CodeFace::NUMBER_1)};
+    game.getLegalMoves(moves);
+    ASSERT_EQ(moves.size(), 1u);
+    EXPECT_TRUE(moves[0].isDraw());
+}
+
+TEST(HeadlessGameTest, ActionCardsFollowTheRules) {
+    Common::ShuffleRng rng(1);
+    HeadlessGame game(3);
+    game.getHand(0) = {code(CodeColor::RED, CodeFace::DRAW_TWO), code(CodeColor::RED, CodeFace::NUMBER_1)};
+    game.getHand(1) = {code(CodeColor::BLUE, CodeFace::NUMBER_2)};
+    game.getHand(2) = {code(CodeColor::BLUE, CodeFace::NUMBER_4)};
+    game.getDrawPile() = {code(CodeColor::GREEN, CodeFace::NUMBER_7), code(CodeColor::GREEN, CodeFace::NUMBER_8)};
+    game.setTop(code(CodeColor::RED, CodeFace::NUMBER_3), CodeColor::RED);
+
+    // +2：下家抽两张并跳过
+    game.apply({code(CodeColor::RED, CodeFace::DRAW_TWO), CodeColor::RED}, rng);
+    EXPECT_EQ(game.getHand(1).size(), 3u);
+    EXPECT_EQ(game.getCurrentPlayer(), 2);
+
+    // 打出最后一张牌的玩家获胜
+    game.getHand(2) = {code(CodeColor::RED, CodeFace::NUMBER_2)};
+    game.apply({code(CodeColor::RED, CodeFace::NUMBER_2), CodeColor::RED}, rng);
+    EXPECT_TRUE(game.isOver());
+    EXPECT_EQ(game.getWinner(), 2);
+}
+
+TEST(HeadlessGameTest, PackageDiscardsNumbersOfTheChosenColor) {
+    Common::ShuffleRng rng(1);
+    HeadlessGame game(2);
+    game.getHand(0) = {
+        code(CodeColor::RED, CodeFace::PACKAGE),
+        code(CodeColor::BLUE, CodeFace::NUMBER_1),
+        code(CodeColor::BLUE, CodeFace::NUMBER_9),
+        code(CodeColor::BLUE, CodeFace::SKIP),
+        code(CodeColor::GREEN, CodeFace::NUMBER_4),
+    };
+    game.setTop(code(CodeColor::RED, CodeFace::NUMBER_3), CodeColor::RED);
+
+    game.apply({code(CodeColor::RED, CodeFace::PACKAGE), CodeColor::BLUE}, rng);
+    // 蓝色数字牌被丢弃，功能牌保留
+    EXPECT_EQ(game.getHand(0).size(), 2u);
+    EXPECT_EQ(game.getCurrentColor(), CodeColor::RED);
+}
+
+TEST(HeadlessGameTest, PlayoutEndsWithAWinner) {
+    Common::ShuffleRng rng(3);
+    for (int round = 0; round < 100; round++) {
+        HeadlessGame game(4);
+        std::vector<CardCode> cards;
+        for (int color = 0; color < 4; color++) {
+            for (int face = 0; face <= static_cast<int>(CodeFace::DRAW_TWO); face++) {
+                cards.push_back(code(static_cast<CodeColor>(color), static_cast<CodeFace>(face)));
+                cards.push_back(code(static_cast<CodeColor>(color), static_cast<CodeFace>(face)));
+            }
+        }
+        Common::Shuffle(std::span(cards), rng);
+        for (int player = 0; player < 4; player++) {
+            game.getHand(player).assign(cards.end() - 7, cards.end());
+            cards.resize(cards.size() - 7);
+        }
+        game.setTop(cards.back(), cards.back().GetColor());
+        cards.pop_back();
+        game.getDrawPile() = cards;
+
+        int winner = game.playout(rng, 1000);
+        EXPECT_TRUE(game.isOver());
+        EXPECT_EQ(winner, game.getWinner());
+        EXPECT_TRUE(game.getHand(winner).empty());
+    }
+}
+
+TEST(HeadlessGameTest, DrawStackingAccumulates) {
+    Common::ShuffleRng rng(1);
+    HeadlessGame game(3);
+    game.setDrawStacking(true);
+    game.getHand(0) = {code(CodeColor::RED, CodeFace::DRAW_TWO), code(CodeColor::RED, CodeFace::NUMBER_1)};
+    game.getHand(1) = {code(CodeColor::BLUE, CodeFace::DRAW_TWO), code(CodeColor::BLUE, CodeFace::NUMBER_1)};
+    game.getHand(2) = {code(CodeColor::BLUE, CodeFace::NUMBER_4)};
+    game.getDrawPile().assign(10, code(CodeColor::GREEN, CodeFace::NUMBER_7));
+    game.setTop(code(CodeColor::RED, CodeFace::NUMBER_3), CodeColor::RED);
+
+    // 下家只能叠加 +2 或抽完
+    game.apply({code(CodeColor::RED, CodeFace::DRAW_TWO), CodeColor::RED}, rng);
+    std::vector<HeadlessMove> moves;
+    game.getLegalMoves(moves);
+    ASSERT_EQ(moves.size(), 1u);
+    EXPECT_EQ(moves[0].card.GetFace(), CodeFace::DRAW_TWO);
+
+    game.apply(moves[0], rng);
+    EXPECT_EQ(game.getPendingDraw(), 4);
+    game.getLegalMoves(moves);
+    ASSERT_TRUE(moves[0].isDraw());
+    game.apply(moves[0], rng);
+    EXPECT_EQ(game.getHand(2).size(), 5u);
+    EXPECT_EQ(game.getCurrentPlayer(), 0);
+    EXPECT_EQ(game.getCounters().drawStacks[4], 1u);
+}
+
+TEST(HeadlessGameTest, SkillsFollowTheGameBoard) {
+    Common::ShuffleRng rng(1);
+    HeadlessGame game(3);
+    game.setCharacter(0, HeadlessCharacter::THIEF);
+    game.setCharacter(1, HeadlessCharacter::DEFENDER);
+    game.setCharacter(2, HeadlessCharacter::COLLECTOR);
+    game.getHand(0) = {code(CodeColor::RED, CodeFace::NUMBER_1), code(CodeColor::RED, CodeFace::NUMBER_2)};
+    game.getHand(1) = {code(CodeColor::BLUE, CodeFace::NUMBER_1), code(CodeColor::BLUE, CodeFace::NUMBER_5)};
+    game.getHand(2) = {code(CodeColor::GREEN, CodeFace::NUMBER_4)};
+    game.setTop(code(CodeColor::RED, CodeFace::NUMBER_3), CodeColor::RED);
+
+    // 防御者挡住偷窃，小偷本回合不能再发动
+    EXPECT_TRUE(game.canUseSkill());
+    EXPECT_FALSE(game.useSkill({1, false}, rng));
+    EXPECT_FALSE(game.canUseSkill());
+    EXPECT_EQ(game.getCounters().skillUses[static_cast<int>(HeadlessCharacter::DEFENDER)], 1u);
+    game.apply({code(CodeColor::RED, CodeFace::NUMBER_1), CodeColor::RED}, rng);
+
+    // 防御者没有主动技能
+    EXPECT_FALSE(game.canUseSkill());
+    game.apply({code(CodeColor::BLUE, CodeFace::NUMBER_1), CodeColor::BLUE}, rng);
+
+    // 收藏家拿走顶牌下面的红 1，整局只有一次
+    EXPECT_TRUE(game.canUseSkill());
+    EXPECT_TRUE(game.useSkill({}, rng));
+    EXPECT_EQ(game.getHand(2).back(), code(CodeColor::RED, CodeFace::NUMBER_1));
+    EXPECT_EQ(game.getCounters().skillUses[static_cast<int>(HeadlessCharacter::COLLECTOR)], 1u);
+}
+
+TEST(OpponentBeliefTest, CountsCardsAndInfersVoidColors) {
+    OpponentBelief belief;
+    std::vector<CardCode> ownHand(7, code(CodeColor::RED, CodeFace::NUMBER_7));
+    belief.reset(2, 0, 1, ownHand, code(CodeColor::RED, CodeFace::NUMBER_3), 7);
+    int unseen = belief.getUnseenTotal();
+    EXPECT_EQ(belief.getHandSize(1), 7);
+
+    // 对手打出的牌不再是看不到的牌
+    int blueFives = belief.getUnseen(code(CodeColor::BLUE, CodeFace::NUMBER_5));
+    belief.onPlay(1, code(CodeColor::BLUE, CodeFace::NUMBER_5));
+    EXPECT_EQ(belief.getUnseen(code(CodeColor::BLUE, CodeFace::NUMBER_5)), blueFives - 1);
+    EXPECT_EQ(belief.getUnseenTotal(), unseen - 1);
+    EXPECT_EQ(belief.getHandSize(1), 6);
+
+    // 抽一张后跳过：没有蓝色牌和万能牌
+    belief.onDraw(1, 1, CodeColor::BLUE);
+    EXPECT_TRUE(belief.mayHold(1, CodeColor::BLUE));
+    belief.onSkip(1);
+    EXPECT_FALSE(belief.mayHold(1, CodeColor::BLUE));
+    EXPECT_FALSE(belief.mayHold(1, CodeColor::WILD));
+    EXPECT_TRUE(belief.mayHold(1, CodeColor::RED));
+
+    // 小偷还给对手的牌是已知的
+    belief.onCardMoved(0, 1, code(CodeColor::BLUE, CodeFace::SKIP));
+    EXPECT_EQ(belief.getKnown(1, code(CodeColor::BLUE, CodeFace::SKIP)), 1);
+
+    Common::ShuffleRng rng(1);
+    std::vector<CardCode> pool;
+    for (int round = 0; round < 100; round++) {
+        HeadlessGame game(2);
+        belief.getUnseenCards(pool);
+        belief.deal(game, pool, rng);
+        const auto& hand = game.getHand(1);
+        ASSERT_EQ(hand.size(), 8u);
+        EXPECT_EQ(std::count(hand.begin(), hand.end(), code(CodeColor::BLUE, CodeFace::SKIP)), 1);
+        EXPECT_EQ(std::count_if(hand.begin(), hand.end(), [](CardCode card) {
+            return card.GetColor() == CodeColor::BLUE || card.IsWild();
+        }), 1);
+        EXPECT_EQ(game.getDrawPile().size(), static_cast<size_t>(belief.getUnseenTotal() - 7));
+    }
+
+    // 再打出蓝色牌时就是已知的那张
+    belief.onPlay(1, code(CodeColor::BLUE, CodeFace::SKIP));
+    EXPECT_EQ(belief.getKnownTotal(1), 0);
+    EXPECT_FALSE(belief.mayHold(1, CodeColor::BLUE));
+
+    // 洗牌后除顶牌外的弃牌重新变成看不到的牌
+    int beforeReshuffle = belief.getUnseenTotal();
+    belief.onReshuffle();
+    EXPECT_EQ(belief.getUnseenTotal(), beforeReshuffle + 2);
+}
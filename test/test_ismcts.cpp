@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <memory>
+#include "ISMCTSPlayer.h"
+#include "GameState.h"
+#include "CardPrototypes.h"
+
+using namespace UNO;
+using Common::CardCode;
+using Common::CodeColor;
+using Common::CodeFace;
+
+namespace {
+std::shared_ptr<Card> card(CodeColor color, CodeFace face) {
+    return CardPrototypes::share(CardCode(color, face));
+}
+
+// 两人牌局，顶牌是红 3。对手的真实手牌只能通过 getPlayerHand 等接口拿到，每次访问都记下来
+class PeekCountingGameState : public GameState {
+public:
+    std::shared_ptr<Card> getTopCard() const override { return card(CodeColor::RED, CodeFace::NUMBER_3); }
+    CardColor getCurrentColor() const override { return CardColor::RED; }
+    int getCurrentPlayer() const override { return 0; }
+    int getNextPlayerId() const override { return 1; }
+    int getPlayerCount() const override { return 2; }
+    bool isClockwise() const override { return true; }
+    void makePlayerDrawCards(int playerId, int count) override {}
+    void skipPlayerTurn(int playerId) override {}
+    void reversePlayDirection() override {}
+    void setCurrentColor(CardColor color) override {}
+    void setFlashEffect(CardColor color, int playerId) override {}
+    void clearFlashEffect() override {}
+    bool isFlashEffectActive() const override { return false; }
+    CardColor getFlashEffectColor() const override { return CardColor::RED; }
+    std::vector<CardData> getPlayerHand(int playerId) const override {
+        peeks++;
+        return {CardData(100, CardColor::BLUE, CardType::NUMBER, 9)};
+    }
+    void discardPlayerCard(int playerId, int cardId) override {}
+    int getPlayerHandSize(int playerId) const override { return 7; }
+    bool hasCardOfColorOrWild(int playerId, CardColor color) const override {
+        peeks++;
+        return true;
+    }
+    std::vector<CardData> getCollectableCards() const override {
+        peeks++;
+        return {};
+    }
+    std::vector<CardData> peekDrawPile(int count) const override {
+        peeks++;
+        return {};
+    }
+    bool validateWildDrawFour(int playerId) const override { return true; }
+    bool isSkillPhase() const override { return false; }
+    bool isCardPlayPhase() const override { return true; }
+
+    mutable int peeks = 0;
+};
+}
+
+TEST(ISMCTSPlayerTest, FindsTheForcedWinWithoutSeeingOpponentCards) {
+    ISMCTSConfig config;
+    config.timeBudget = std::chrono::milliseconds(50);
+    config.seed = 3;
+    // 两个玩家共用一个线程池
+    auto threadPool = std::make_shared<Common::ThreadPool>(2);
+    ISMCTSPlayer player(0, "ISMCTS", config, threadPool);
+    ISMCTSPlayer other(1, "Other", config, threadPool);
+
+    // 两人时先出跳过牌，下一回合还是自己，打出红 5 必胜；先出红 5 则要看对手的牌
+    player.addCardToHand(card(CodeColor::RED, CodeFace::NUMBER_5));
+    player.addCardToHand(card(CodeColor::RED, CodeFace::SKIP));
+
+    PeekCountingGameState gameState;
+    auto start = std::chrono::steady_clock::now();
+    auto chosen = player.playTurn(gameState);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    ASSERT_NE(chosen, nullptr);
+    EXPECT_EQ(chosen->getType(), CardType::SKIP);
+    EXPECT_GT(player.getLastIterations(), 0);
+    // 确定化只用没见过的牌，不读取对手的真实手牌、弃牌堆和抽牌堆
+    EXPECT_EQ(gameState.peeks, 0);
+    // 时间预算之外只有建根节点和合并结果的开销
+    EXPECT_LT(elapsed, config.timeBudget + std::chrono::milliseconds(500));
+
+    // 共用的线程池在另一个玩家手中照常工作
+    other.addCardToHand(card(CodeColor::RED, CodeFace::NUMBER_5));
+    other.addCardToHand(card(CodeColor::RED, CodeFace::SKIP));
+    EXPECT_EQ(other.playTurn(gameState)->getType(), CardType::SKIP);
+    EXPECT_EQ(threadPool->GetThreadNum(), 2);
+}
@@ -1,8 +1,14 @@
 #include <gtest/gtest.h>
 #include <memory>
+#include <random>
 #include "Player.h"
+#include "GameState.h"
 #include "AIPlayer.h"
 #include "HumanPlayer.h"
+#include "MoveClassifier.h"
+#include "SkillPolicy.h"
+#include "CardPrototypes.h"
+#include "CardEffects.h"
 
 class PlayerTest : public ::testing::Test {
 protected:
@@ -11,8 +17,9 @@ protected:
         aiPlayer = std::make_shared<UNO::AIPlayer>(2, "TestAI");
         
         // 添加一些测试卡牌到玩家手牌
-        auto card1 = std::make_shared<UNO::Card>(UNO::CardData(1, UNO::CardColor::RED, UNO::CardType::NUMBER, 5));
-        auto card2 = std::make_shared<UNO::Card>(UNO::CardData(2, UNO::CardColor::BLUE, UNO::CardType::NUMBER, 3));
+        // 原型的 ID 就是卡牌编码
+        card1 = UNO::CardPrototypes::share(UNO::Common::CardCode(UNO::Common::CodeColor::RED, UNO::Common::CodeFace::NUMBER_5));
+        auto card2 = UNO::CardPrototypes::share(UNO::Common::CardCode(UNO::Common::CodeColor::BLUE, UNO::Common::CodeFace::NUMBER_3));
         
         humanPlayer->addCardToHand(card1);
         aiPlayer->addCardToHand(card2);
@@ -20,6 +27,7 @@ protected:
 
     std::shared_ptr<UNO::HumanPlayer> humanPlayer;
     std::shared_ptr<UNO::AIPlayer> aiPlayer;
+    std::shared_ptr<UNO::Card> card1;
 };
 
 TEST_F(PlayerTest, PlayerCreation) {
@@ -34,16 +42,238 @@ TEST_F(PlayerTest, PlayerCreation) {
 
 TEST_F(PlayerTest, HandManagement) {
     EXPECT_EQ(humanPlayer->getHandSize(), 1);
-    EXPECT_TRUE(humanPlayer->hasCard(1));
+    EXPECT_TRUE(humanPlayer->hasCard(card1->getId()));
     EXPECT_FALSE(humanPlayer->hasCard(999)); // 不存在的卡牌
     
     // 测试移除卡牌
-    EXPECT_TRUE(humanPlayer->removeCardFromHand(1));
+    EXPECT_TRUE(humanPlayer->removeCardFromHand(card1->getId()));
     EXPECT_EQ(humanPlayer->getHandSize(), 0);
-    EXPECT_FALSE(humanPlayer->hasCard(1));
+    EXPECT_FALSE(humanPlayer->hasCard(card1->getId()));
     
     // 测试移除不存在的卡牌
     EXPECT_FALSE(humanPlayer->removeCardFromHand(999));
+    
+    // 移除中间的牌，其余手牌保持原来的顺序，索引仍然正确
+    using UNO::Common::CardCode;
+    using UNO::Common::CodeColor;
+    using UNO::Common::CodeFace;
+    std::vector<std::shared_ptr<UNO::Card>> cards = {
+        UNO::CardPrototypes::share(CardCode(CodeColor::RED, CodeFace::NUMBER_2)),
+        UNO::CardPrototypes::share(CardCode(CodeColor::BLUE, CodeFace::NUMBER_3)),
+        UNO::CardPrototypes::share(CardCode(CodeColor::RED, CodeFace::NUMBER_4)),
+        UNO::CardPrototypes::share(CardCode(CodeColor::BLUE, CodeFace::NUMBER_5)),
+    };
+    for (const auto& card : cards) {
+        humanPlayer->addCardToHand(card);
+    }
+    EXPECT_TRUE(humanPlayer->removeCardFromHand(cards[1]->getId()));
+    EXPECT_EQ(humanPlayer->getHandCards(), (std::vector<std::shared_ptr<UNO::Card>>{cards[0], cards[2], cards[3]}));
+    EXPECT_EQ(humanPlayer->countCards(UNO::CardColor::RED), 2);
+    EXPECT_EQ(humanPlayer->countCards(UNO::CardColor::BLUE), 1);
+}
+
+TEST_F(PlayerTest, HandIndexQueries) {
+    using UNO::Common::CardCode;
+    using UNO::Common::CodeColor;
+    using UNO::Common::CodeFace;
+    UNO::HumanPlayer player(3, "Indexed");
+    for (CodeFace face : {CodeFace::NUMBER_1, CodeFace::SKIP, CodeFace::NUMBER_7, CodeFace::NUMBER_2}) {
+        player.addCardToHand(UNO::CardPrototypes::share(CardCode(CodeColor::RED, face)));
+        player.addCardToHand(UNO::CardPrototypes::share(CardCode(CodeColor::BLUE, face)));
+    }
+    player.addCardToHand(UNO::CardPrototypes::share(CardCode(CodeColor::WILD, CodeFace::WILD)));
+
+    EXPECT_EQ(player.countCards(UNO::CardType::NUMBER), 6);
+    EXPECT_EQ(player.countCards(UNO::CardColor::RED), 4);
+    EXPECT_EQ(player.countCards(UNO::CardColor::WILD, UNO::CardType::WILD), 1);
+
+    // 包装卡：取出所有红色数字牌，其余牌不受影响
+    std::vector<std::shared_ptr<UNO::Card>> taken;
+    EXPECT_EQ(player.takeCards(UNO::CardColor::RED, UNO::CardType::NUMBER, taken), 3);
+    EXPECT_EQ(player.getHandSize(), 6);
+    for (const auto& card : taken) {
+        EXPECT_EQ(card->getColor(), UNO::CardColor::RED);
+        EXPECT_EQ(card->getType(), UNO::CardType::NUMBER);
+    }
+    EXPECT_EQ(player.countCards(UNO::CardColor::RED), 1);
+
+    // 小偷：随机取出一张跳过牌，直到没有为止
+    std::mt19937 rng(42);
+    EXPECT_EQ(player.takeRandomCard(UNO::CardType::SKIP, rng)->getType(), UNO::CardType::SKIP);
+    EXPECT_EQ(player.takeRandomCard(UNO::CardType::SKIP, rng)->getType(), UNO::CardType::SKIP);
+    EXPECT_EQ(player.takeRandomCard(UNO::CardType::SKIP, rng), nullptr);
+
+    // 索引和手牌保持一致
+    size_t numbers = 0;
+    for (const auto& card : player.getHandCards()) {
+        numbers += card->getType() == UNO::CardType::NUMBER;
+    }
+    EXPECT_EQ(player.countCards(UNO::CardType::NUMBER), numbers);
+    EXPECT_EQ(player.getHandSize(), 4);
+}
+
+TEST_F(PlayerTest, PackageAndThiefThroughHandIndex) {
+    using UNO::Common::CardCode;
+    using UNO::Common::CodeColor;
+    using UNO::Common::CodeFace;
+
+    // 持有 Player 对象的牌桌：getPlayerHand 什么也不给，包装卡和小偷只能走手牌索引
+    class PlayerTable : public UNO::GameState {
+    public:
+        std::shared_ptr<UNO::Card> getTopCard() const override { return nullptr; }
+        UNO::CardColor getCurrentColor() const override { return UNO::CardColor::RED; }
+        int getCurrentPlayer() const override { return 0; }
+        int getNextPlayerId() const override { return 1; }
+        int getPlayerCount() const override { return 2; }
+        bool isClockwise() const override { return true; }
+        void makePlayerDrawCards(int playerId, int count) override {}
+        void skipPlayerTurn(int playerId) override {}
+        void reversePlayDirection() override {}
+        void setCurrentColor(UNO::CardColor color) override {}
+        void setFlashEffect(UNO::CardColor color, int playerId) override {}
+        void clearFlashEffect() override {}
+        bool isFlashEffectActive() const override { return false; }
+        UNO::CardColor getFlashEffectColor() const override { return UNO::CardColor::RED; }
+        std::vector<UNO::CardData> getPlayerHand(int playerId) const override { return {}; }
+        void discardPlayerCard(int playerId, int cardId) override {}
+        bool validateWildDrawFour(int playerId) const override { return true; }
+        bool isSkillPhase() const override { return false; }
+        bool isCardPlayPhase() const override { return true; }
+        UNO::Player* getPlayer(int playerId) const override { return players[playerId].get(); }
+
+        std::shared_ptr<UNO::HumanPlayer> players[2] = {
+            std::make_shared<UNO::HumanPlayer>(0, "Packager"),
+            std::make_shared<UNO::HumanPlayer>(1, "Thief"),
+        };
+    };
+
+    PlayerTable table;
+    auto& victim = *table.players[0];
+    auto& thief = *table.players[1];
+    std::vector<std::shared_ptr<UNO::Card>> hand = {
+        UNO::CardPrototypes::share(CardCode(CodeColor::RED, CodeFace::NUMBER_1)),
+        UNO::CardPrototypes::share(CardCode(CodeColor::BLUE, CodeFace::NUMBER_2)),
+        UNO::CardPrototypes::share(CardCode(CodeColor::RED, CodeFace::SKIP)),
+        UNO::CardPrototypes::share(CardCode(CodeColor::RED, CodeFace::NUMBER_3)),
+        UNO::CardPrototypes::share(CardCode(CodeColor::BLUE, CodeFace::SKIP)),
+    };
+    for (const auto& card : hand) {
+        victim.addCardToHand(card);
+    }
+    thief.addCardToHand(UNO::CardPrototypes::share(CardCode(CodeColor::GREEN, CodeFace::NUMBER_4)));
+
+    // 包装卡：丢弃红色数字牌，红色跳过牌留下，其余手牌保持原来的顺序
+    UNO::EffectParams package;
+    package.color = UNO::CardColor::RED;
+    UNO::CardEffects::apply(UNO::CardType::PACKAGE, table, 0, package);
+    EXPECT_EQ(victim.getHandCards(), (std::vector<std::shared_ptr<UNO::Card>>{hand[1], hand[2], hand[4]}));
+    EXPECT_EQ(victim.countCards(UNO::CardColor::RED, UNO::CardType::NUMBER), 0);
+
+    // 闪光卡：按索引判断能否响应
+    EXPECT_TRUE(table.hasCardOfColorOrWild(0, UNO::CardColor::RED));
+    EXPECT_FALSE(table.hasCardOfColorOrWild(1, UNO::CardColor::RED));
+
+    // 小偷：拿走一张跳过牌放进自己的手牌，受害者其余的牌顺序不变
+    std::mt19937 rng(7);
+    auto stolen = table.stealPlayerCard(1, 0, UNO::CardType::SKIP, rng);
+    ASSERT_NE(stolen, nullptr);
+    EXPECT_EQ(stolen->getType(), UNO::CardType::SKIP);
+    EXPECT_EQ(thief.getHandCards().back(), stolen);
+    EXPECT_EQ(thief.countCards(UNO::CardType::SKIP), 1);
+    std::vector<std::shared_ptr<UNO::Card>> rest = {hand[1], stolen == hand[2] ? hand[4] : hand[2]};
+    EXPECT_EQ(victim.getHandCards(), rest);
+
+    // 目标没有该类型的牌时什么也不拿
+    EXPECT_EQ(table.stealPlayerCard(1, 0, UNO::CardType::REVERSE, rng), nullptr);
+    EXPECT_EQ(victim.getHandSize(), 2);
+    EXPECT_EQ(thief.getHandSize(), 2);
+}
+
+TEST_F(PlayerTest, MoveClassification) {
+    using UNO::Common::CardCode;
+    using UNO::Common::CodeColor;
+    using UNO::Common::CodeFace;
+    using Category = UNO::MoveClassifier::Category;
+    std::vector<std::shared_ptr<UNO::Card>> hand = {
+        UNO::CardPrototypes::share(CardCode(CodeColor::RED, CodeFace::NUMBER_4)),
+        UNO::CardPrototypes::share(CardCode(CodeColor::BLUE, CodeFace::NUMBER_7)),
+        UNO::CardPrototypes::share(CardCode(CodeColor::BLUE, CodeFace::SKIP)),
+        UNO::CardPrototypes::share(CardCode(CodeColor::RED, CodeFace::DRAW_TWO)),
+        UNO::CardPrototypes::share(CardCode(CodeColor::WILD, CodeFace::DRAW_FOUR)),
+    };
+    auto topCard = UNO::CardPrototypes::share(CardCode(CodeColor::RED, CodeFace::NUMBER_7));
+
+    UNO::MoveClassifier moves;
+    moves.classify(hand, topCard.get());
+    // 红 4 同色、蓝 7 同数字；蓝色跳过牌不能出
+    EXPECT_EQ(moves.count(Category::NUMBER), 2);
+    ASSERT_EQ(moves.count(Category::ACTION), 1);
+    EXPECT_EQ(moves.playable(Category::ACTION)[0], 3);
+    EXPECT_EQ(moves.count(Category::WILD), 1);
+    EXPECT_EQ(moves.playableCount(), 4);
+
+    // 重新分类时清空上次的结果
+    moves.classify(hand, nullptr);
+    EXPECT_EQ(moves.playableCount(), hand.size());
+}
+
+TEST_F(PlayerTest, SkillPolicyChoices) {
+    using UNO::Common::CardCode;
+    using UNO::Common::CodeColor;
+    using UNO::Common::CodeFace;
+    using UNO::HeadlessCharacter;
+    UNO::SkillChoice choice;
+
+    // 小偷：对手只剩一张牌时发动，大家手牌都多时留着
+    UNO::SkillSituation thief;
+    thief.hand = {CardCode(CodeColor::RED, CodeFace::NUMBER_1), CardCode(CodeColor::RED, CodeFace::NUMBER_2),
+                  CardCode(CodeColor::BLUE, CodeFace::NUMBER_3)};
+    thief.handSizes = {3, 1, 7};
+    thief.topCard = CardCode(CodeColor::RED, CodeFace::NUMBER_5);
+    thief.currentColor = CodeColor::RED;
+    ASSERT_TRUE(UNO::SkillPolicy::choose(HeadlessCharacter::THIEF, thief, choice));
+    EXPECT_EQ(choice.target, 1);
+    thief.handSizes = {3, 7, 7};
+    EXPECT_FALSE(UNO::SkillPolicy::choose(HeadlessCharacter::THIEF, thief, choice));
+
+    // 收藏家：被罚抽时拿能叠加的 +4，没有压力时不拿普通的数字牌
+    UNO::SkillSituation collector;
+    collector.hand = {CardCode(CodeColor::BLUE, CodeFace::NUMBER_1)};
+    collector.handSizes = {1, 5};
+    collector.topCard = CardCode(CodeColor::BLUE, CodeFace::DRAW_TWO);
+    collector.currentColor = CodeColor::BLUE;
+    collector.cardsNumToDraw = 2;
+    collector.candidates = {CardCode(CodeColor::GREEN, CodeFace::NUMBER_3), CardCode(CodeColor::WILD, CodeFace::DRAW_FOUR),
+                            CardCode(CodeColor::RED, CodeFace::NUMBER_4)};
+    ASSERT_TRUE(UNO::SkillPolicy::choose(HeadlessCharacter::COLLECTOR, collector, choice));
+    EXPECT_EQ(choice.cardIndex, 1);
+    collector.topCard = CardCode(CodeColor::RED, CodeFace::NUMBER_5);
+    collector.currentColor = CodeColor::RED;
+    collector.cardsNumToDraw = 1;
+    collector.candidates = {CardCode(CodeColor::GREEN, CodeFace::NUMBER_3), CardCode(CodeColor::RED, CodeFace::NUMBER_4)};
+    EXPECT_FALSE(UNO::SkillPolicy::choose(HeadlessCharacter::COLLECTOR, collector, choice));
+
+    // 幸运星：发动前看不到抽牌堆，罚抽四张时发动，普通抽牌时留着
+    UNO::SkillSituation luckyStar;
+    luckyStar.hand = {CardCode(CodeColor::BLUE, CodeFace::NUMBER_1)};
+    luckyStar.handSizes = {1, 5};
+    luckyStar.topCard = CardCode(CodeColor::RED, CodeFace::NUMBER_5);
+    luckyStar.currentColor = CodeColor::RED;
+    luckyStar.cardsNumToDraw = 4;
+    ASSERT_TRUE(UNO::SkillPolicy::choose(HeadlessCharacter::LUCKY_STAR, luckyStar, choice));
+    EXPECT_EQ(choice.cardIndex, -1);
+    luckyStar.cardsNumToDraw = 1;
+    EXPECT_FALSE(UNO::SkillPolicy::choose(HeadlessCharacter::LUCKY_STAR, luckyStar, choice));
+
+    // 发动后看到顶部三张：罚抽四张时只留一张能出的牌；普通抽牌本来就抽到这张时不如直接抽
+    luckyStar.cardsNumToDraw = 4;
+    luckyStar.candidates = {CardCode(CodeColor::GREEN, CodeFace::NUMBER_3), CardCode(CodeColor::RED, CodeFace::NUMBER_7),
+                            CardCode(CodeColor::YELLOW, CodeFace::NUMBER_9)};
+    ASSERT_TRUE(UNO::SkillPolicy::choose(HeadlessCharacter::LUCKY_STAR, luckyStar, choice));
+    EXPECT_EQ(choice.cardIndex, 1);
+    luckyStar.cardsNumToDraw = 1;
+    luckyStar.candidates = {CardCode(CodeColor::RED, CodeFace::NUMBER_7), CardCode(CodeColor::GREEN, CodeFace::NUMBER_3)};
+    EXPECT_FALSE(UNO::SkillPolicy::choose(HeadlessCharacter::LUCKY_STAR, luckyStar, choice));
 }
 
 TEST_F(PlayerTest, PlayerSerialization) {
@@ -64,9 +294,9 @@ TEST_F(PlayerTest, AIPlayerDecision) {
     class SimpleGameState : public UNO::GameState {
     public:
         std::shared_ptr<UNO::Card> getTopCard() const override { 
-            return std::make_shared<UNO::Card>(UNO::CardData(99, UNO::CardColor::RED, UNO::CardType::NUMBER, 5));
+            return UNO::CardPrototypes::share(UNO::Common::CardCode(UNO::Common::CodeColor::RED, UNO::Common::CodeFace::NUMBER_5));
         }
-        CardColor getCurrentColor() const override { return UNO::CardColor::RED; }
+        UNO::CardColor getCurrentColor() const override { return UNO::CardColor::RED; }
         int getCurrentPlayer() const override { return 0; }
         int getNextPlayerId() const override { return 1; }
         int getPlayerCount() const override { return 2; }
@@ -74,18 +304,16 @@ TEST_F(PlayerTest, AIPlayerDecision) {
         void makePlayerDrawCards(int playerId, int count) override {}
         void skipPlayerTurn(int playerId) override {}
         void reversePlayDirection() override {}
-        void setCurrentColor(CardColor color) override {}
-        void setFlashEffect(CardColor color, int playerId) override {}
+        void setCurrentColor(UNO::CardColor color) override {}
+        void setFlashEffect(UNO::CardColor color, int playerId) override {}
         void clearFlashEffect() override {}
         bool isFlashEffectActive() const override { return false; }
-        CardColor getFlashEffectColor() const override { return UNO::CardColor::RED; }
+        UNO::CardColor getFlashEffectColor() const override { return UNO::CardColor::RED; }
         std::vector<UNO::CardData> getPlayerHand(int playerId) const override { return {}; }
         void discardPlayerCard(int playerId, int cardId) override {}
-        void notifyCardEffect(const std::string& effect, const nlohmann::json& data) override {}
         bool validateWildDrawFour(int playerId) const override { return true; }
         bool isSkillPhase() const override { return false; }
         bool isCardPlayPhase() const override { return true; }
-        std::vector<std::shared_ptr<UNO::Card>> getPlayerHandCards(int playerId) const override { return {}; }
     };
     
     SimpleGameState gameState;
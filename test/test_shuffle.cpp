@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <array>
+#include <numeric>
+#include <vector>
+#include "common/shuffle.h"
+
+using UNO::Common::ShuffleRng;
+
+namespace {
+// 卡方统计量：观察次数相对期望次数的偏差
+double chiSquare(const std::vector<int>& counts, double expected) {
+    double sum = 0;
+    for (int count : counts) {
+        sum += (count - expected) * (count - expected) / expected;
+    }
+    return sum;
+}
+}
+
+TEST(ShuffleTest, SameSeedSameResultOnEveryPlatform) {
+    // 结果只依赖整数运算，固定的期望值在任何平台和编译选项下都应一致
+    ShuffleRng rng(42);
+    EXPECT_EQ(rng.Next(), 3084993712u);
+    EXPECT_EQ(rng.Next(), 1661172933u);
+    EXPECT_EQ(rng.Next(), 4096195425u);
+    EXPECT_EQ(rng.Next(), 1150162148u);
+
+    ShuffleRng shuffleRng(2024);
+    std::vector<int> cards(10);
+    std::iota(cards.begin(), cards.end(), 0);
+    UNO::Common::Shuffle(std::span(cards), shuffleRng);
+    EXPECT_EQ(cards, (std::vector<int>{3, 9, 5, 8, 1, 6, 0, 7, 4, 2}));
+}
+
+TEST(ShuffleTest, ShufflingInPiecesMatchesOneShuffle) {
+    std::vector<int> whole(108), pieces(108);
+    std::iota(whole.begin(), whole.end(), 0);
+    std::iota(pieces.begin(), pieces.end(), 0);
+
+    ShuffleRng wholeRng(7), piecesRng(7);
+    UNO::Common::Shuffle(std::span(whole), wholeRng);
+    // 像抽牌时那样从顶部往下分几次洗
+    for (size_t from = pieces.size(); from > 0; from -= std::min<size_t>(from, 5)) {
+        UNO::Common::ShuffleTail(std::span(pieces), from, from - std::min<size_t>(from, 5), piecesRng);
+    }
+    EXPECT_EQ(whole, pieces);
+}
+
+TEST(ShuffleTest, BoundedIsUniform) {
+    ShuffleRng rng(1);
+    constexpr int range = 7;
+    constexpr int samples = 700000;
+    std::vector<int> counts(range);
+    for (int i = 0; i < samples; i++) {
+        counts[rng.Bounded(range)]++;
+    }
+    // 自由度 6，p = 0.001 的临界值
+    EXPECT_LT(chiSquare(counts, static_cast<double>(samples) / range), 22.46);
+}
+
+TEST(ShuffleTest, EveryPermutationIsEquallyLikely) {
+    ShuffleRng rng(3);
+    constexpr int samples = 240000;
+    std::vector<int> counts(24);
+    for (int i = 0; i < samples; i++) {
+        std::array<int, 4> cards = {0, 1, 2, 3};
+        UNO::Common::Shuffle(std::span(cards), rng);
+        // 排列的字典序编号
+        int rank = 0;
+        for (int j = 0; j < 4; j++) {
+            int smaller = std::count_if(cards.begin() + j + 1, cards.end(), [&](int card) { return card < cards[j]; });
+            rank = rank * (4 - j) + smaller;
+        }
+        counts[rank]++;
+    }
+    // 自由度 23，p = 0.001 的临界值
+    EXPECT_LT(chiSquare(counts, samples / 24.0), 49.73);
+}
+
+TEST(ShuffleTest, EveryCardReachesEveryPosition) {
+    ShuffleRng rng(5);
+    constexpr int cardNum = 52;
+    constexpr int samples = 20000;
+    std::vector<int> counts(cardNum * cardNum);
+    std::vector<int> cards(cardNum);
+    for (int i = 0; i < samples; i++) {
+        std::iota(cards.begin(), cards.end(), 0);
+        UNO::Common::Shuffle(std::span(cards), rng);
+        for (int position = 0; position < cardNum; position++) {
+            counts[cards[position] * cardNum + position]++;
+        }
+    }
+    // 每张牌在每个位置的次数，自由度 51 * 51 = 2601，p = 0.001 的临界值
+    EXPECT_LT(chiSquare(counts, static_cast<double>(samples) / cardNum), 2830.0);
+}
@@ -0,0 +1,215 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <set>
+#include <string>
+#include <vector>
+#include "tournament.h"
+#include "rating.h"
+#include "TournamentRunner.h"
+
+using namespace UNO;
+using Game::Match;
+using Game::Rating;
+using Game::RatedGame;
+using Game::RatingSystem;
+using Game::RatingUpdater;
+using Game::Tournament;
+using Game::TournamentConfig;
+using Game::TournamentFormat;
+
+namespace {
+std::vector<std::string> roster(int num) {
+    std::vector<std::string> names;
+    for (int i = 0; i < num; i++) {
+        names.push_back("p" + std::to_string(i));
+    }
+    return names;
+}
+
+// 不真正打牌：名单中下标小的参赛者总是赢，名次按下标排列
+void lowerIndexWins(Match& match) {
+    std::vector<int> order(match.mSeats.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&match](int lhs, int rhs) { return match.mSeats[lhs] < match.mSeats[rhs]; });
+    match.mPlaces.assign(match.mSeats.size(), 0);
+    for (size_t place = 0; place < order.size(); place++) {
+        match.mPlaces[order[place]] = static_cast<int>(place);
+    }
+}
+
+std::vector<std::vector<int>> seatsOfRound(const Tournament& tournament, int round) {
+    std::vector<std::vector<int>> seats;
+    for (const auto& match : tournament.GetMatches()) {
+        if (match.mRound == round) {
+            seats.push_back(match.mSeats);
+        }
+    }
+    return seats;
+}
+}
+
+TEST(TournamentTest, RoundRobinSeatsEveryGroupWithRotatedSeats) {
+    TournamentConfig config;
+    config.mFormat = TournamentFormat::ROUND_ROBIN;
+    config.mSeatNum = 2;
+    config.mGamesPerMatch = 2;
+    config.mThreadNum = 2;
+    Tournament tournament(roster(4), config, lowerIndexWins);
+    tournament.Run();
+
+    // 4 人两两之间各 2 局，只有一轮
+    const auto& matches = tournament.GetMatches();
+    ASSERT_EQ(matches.size(), 12u);
+    std::set<std::vector<int>> seatings;
+    for (const auto& match : matches) {
+        EXPECT_EQ(match.mRound, 0);
+        seatings.insert(match.mSeats);
+    }
+    // 每组的两局交换座位，所以 12 种座位安排各不相同
+    EXPECT_EQ(seatings.size(), 12u);
+    EXPECT_EQ(matches[0].mSeats, (std::vector<int>{0, 1}));
+    EXPECT_EQ(matches[1].mSeats, (std::vector<int>{1, 0}));
+
+    auto standings = tournament.GetStandings();
+    EXPECT_EQ(standings[0].mName, "p0");
+    EXPECT_EQ(standings[0].mWins, 6);
+    EXPECT_EQ(standings[3].mWins, 0);
+}
+
+TEST(TournamentTest, SwissPairsEntrantsWithEqualPoints) {
+    TournamentConfig config;
+    config.mFormat = TournamentFormat::SWISS;
+    config.mSeatNum = 2;
+    config.mThreadNum = 3;
+    Tournament tournament(roster(8), config, lowerIndexWins);
+    tournament.Run();
+
+    // 8 人两人一桌，3 轮能排出名次
+    EXPECT_EQ(tournament.GetMatches().size(), 12u);
+    EXPECT_EQ(seatsOfRound(tournament, 0), (std::vector<std::vector<int>>{{0, 1}, {2, 3}, {4, 5}, {6, 7}}));
+    // 第一轮的胜者之间、负者之间配对
+    EXPECT_EQ(seatsOfRound(tournament, 1), (std::vector<std::vector<int>>{{0, 2}, {4, 6}, {1, 3}, {5, 7}}));
+    EXPECT_EQ(seatsOfRound(tournament, 2)[0], (std::vector<int>{0, 4}));
+    EXPECT_EQ(tournament.GetStandings()[0].mName, "p0");
+    EXPECT_EQ(tournament.GetStandings()[0].mPoints, 3);
+}
+
+TEST(TournamentTest, KnockoutGivesByesToTheStrongest) {
+    TournamentConfig config;
+    config.mFormat = TournamentFormat::KNOCKOUT;
+    config.mSeatNum = 2;
+    config.mThreadNum = 1;
+    Tournament tournament(roster(5), config, lowerIndexWins);
+    tournament.Run();
+
+    // 第一轮评分都一样，p0 轮空，其余按种子交叉分桌
+    EXPECT_EQ(seatsOfRound(tournament, 0), (std::vector<std::vector<int>>{{1, 3}, {2, 4}}));
+    // 胜者 p1、p2 的评分更高，p1 轮空
+    EXPECT_EQ(seatsOfRound(tournament, 1), (std::vector<std::vector<int>>{{2, 0}}));
+    EXPECT_EQ(seatsOfRound(tournament, 2), (std::vector<std::vector<int>>{{0, 1}}));
+    EXPECT_EQ(tournament.GetMatches().size(), 4u);
+
+    auto standings = tournament.GetStandings();
+    EXPECT_EQ(standings[0].mName, "p0");
+    EXPECT_FALSE(standings[0].mIsEliminated);
+    EXPECT_TRUE(standings[1].mIsEliminated);
+}
+
+TEST(RatingTest, EloDeltasMatchReferenceValues) {
+    RatingUpdater updater(RatingSystem::ELO);
+
+    std::vector<Rating> ratings(2);
+    updater.Update(ratings, {{{0, 1}, {0, 1}}});
+    EXPECT_DOUBLE_EQ(ratings[0].mRating, 1516.0);
+    EXPECT_DOUBLE_EQ(ratings[1].mRating, 1484.0);
+
+    // 1600 对 1400：强者赢得 32 * (1 - 1 / (1 + 10^-0.5))，爆冷时弱者得到其余部分
+    ratings.assign(2, Rating{});
+    ratings[0].mRating = 1600.0;
+    ratings[1].mRating = 1400.0;
+    updater.Update(ratings, {{{0, 1}, {0, 1}}});
+    EXPECT_NEAR(ratings[0].mRating, 1607.688, 0.001);
+    ratings[0].mRating = 1600.0;
+    ratings[1].mRating = 1400.0;
+    updater.Update(ratings, {{{0, 1}, {1, 0}}});
+    EXPECT_NEAR(ratings[1].mRating, 1424.312, 0.001);
+
+    // 三人一桌时每对的 K 是 16，第二名不涨不跌
+    ratings.assign(3, Rating{});
+    updater.Update(ratings, {{{0, 1, 2}, {0, 1, 2}}});
+    EXPECT_DOUBLE_EQ(ratings[0].mRating, 1516.0);
+    EXPECT_DOUBLE_EQ(ratings[1].mRating, 1500.0);
+    EXPECT_DOUBLE_EQ(ratings[2].mRating, 1484.0);
+}
+
+TEST(RatingTest, GlickoMatchesGlickmansExample) {
+    // Glickman 论文中的例子：1500/200 的选手赢 1400/30，输给 1550/100 和 1700/300。
+    // 评分期开始时 RD 会先加上 c = 30，所以初始 RD 取 sqrt(200^2 - 30^2)。
+    // 论文的中间结果取了整，给出 1464.06 和 151.52，精确值是 1464.11 和 151.40
+    RatingUpdater updater(RatingSystem::GLICKO);
+    std::vector<Rating> ratings(4);
+    ratings[0] = {1500.0, std::sqrt(200.0 * 200.0 - 30.0 * 30.0)};
+    ratings[1] = {1400.0, 30.0};
+    ratings[2] = {1550.0, 100.0};
+    ratings[3] = {1700.0, 300.0};
+    std::vector<RatedGame> games = {
+        {{0, 1}, {0, 1}},
+        {{0, 2}, {1, 0}},
+        {{0, 3}, {1, 0}},
+    };
+    updater.Update(ratings, games);
+    EXPECT_NEAR(ratings[0].mRating, 1464.11, 0.01);
+    EXPECT_NEAR(ratings[0].mDeviation, 151.40, 0.01);
+    EXPECT_EQ(ratings[0].mGames, 3);
+
+    // 和评分期内的顺序无关
+    std::vector<Rating> reordered(4);
+    reordered[0] = {1500.0, std::sqrt(200.0 * 200.0 - 30.0 * 30.0)};
+    reordered[1] = {1400.0, 30.0};
+    reordered[2] = {1550.0, 100.0};
+    reordered[3] = {1700.0, 300.0};
+    std::reverse(games.begin(), games.end());
+    updater.Update(reordered, games);
+    EXPECT_DOUBLE_EQ(reordered[0].mRating, ratings[0].mRating);
+}
+
+TEST(TournamentTest, HeadlessRunnerIsReproducibleAcrossThreadCounts) {
+    SimulatorConfig simulatorConfig;
+    simulatorConfig.maxTurns = 300;
+    SelfPlaySimulator simulator(simulatorConfig, makePolicy("random"));
+    HeadlessMatchRunner runner(simulator, {makePolicy("heuristic"), makePolicy("random"),
+                                           makePolicy("heuristic"), makePolicy("random")});
+
+    auto play = [&runner](int threadNum) {
+        TournamentConfig config;
+        config.mFormat = TournamentFormat::ROUND_ROBIN;
+        config.mSeatNum = 3;
+        config.mGamesPerMatch = 3;
+        config.mSeed = 7;
+        config.mThreadNum = threadNum;
+        Tournament tournament(roster(4), config, runner);
+        tournament.Run();
+        return tournament.GetMatches();
+    };
+
+    auto matches = play(1);
+    ASSERT_EQ(matches.size(), 12u);
+    for (const auto& match : matches) {
+        // 名次是 0..n-1 的一个排列，每个座位都分到了角色
+        std::vector<int> places = match.mPlaces;
+        std::sort(places.begin(), places.end());
+        EXPECT_EQ(places, (std::vector<int>{0, 1, 2}));
+        EXPECT_EQ(match.mCharacters.size(), 3u);
+        EXPECT_GT(match.mTurns, 0);
+    }
+
+    auto parallel = play(4);
+    ASSERT_EQ(parallel.size(), matches.size());
+    for (size_t i = 0; i < matches.size(); i++) {
+        EXPECT_EQ(parallel[i].mSeed, matches[i].mSeed);
+        EXPECT_EQ(parallel[i].mPlaces, matches[i].mPlaces);
+        EXPECT_EQ(parallel[i].mTurns, matches[i].mTurns);
+    }
+}